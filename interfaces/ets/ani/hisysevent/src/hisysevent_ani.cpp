@@ -21,6 +21,7 @@
 #include "ani_hisysevent_listener.h"
 #include "ani_callback_context.h"
 #include "def.h"
+#include "event_control.h"
 #include "hisysevent_base_manager.h"
 #include "hisysevent_rules.h"
 #include "hilog/log.h"
@@ -549,6 +550,11 @@ static void ParseCallerInfo(ani_env *env, JsCallerInfo& callerInfo)
 
 int32_t HiSysEventAni::WriteInner(ani_env *env, const HiSysEventInfo &eventInfo)
 {
+    double sampleRate = 1.0;
+    if (EventControl::GetInstance().IsDropped(eventInfo.domain.c_str(), eventInfo.name.c_str(),
+        eventInfo.eventType, sampleRate)) {
+        return HiSysEvent::ExplainThenReturnRetCode(ERR_DOMAIN_MASKED);
+    }
     JsCallerInfo jsCallerInfo;
     ParseCallerInfo(env, jsCallerInfo);
     uint64_t timeStamp = WriteController::GetCurrentTimeMills();
@@ -560,6 +566,7 @@ int32_t HiSysEventAni::WriteInner(ani_env *env, const HiSysEventInfo &eventInfo)
         return HiSysEvent::ExplainThenReturnRetCode(ERR_EVENT_NAME_INVALID);
     }
     HiSysEvent::EventBase eventBase(eventInfo.domain, eventInfo.name, eventInfo.eventType, timeStamp);
+    eventBase.SetSampleRate(sampleRate);
     HiSysEvent::WritebaseInfo(eventBase);
     if (HiSysEvent::IsError(eventBase)) {
         return HiSysEvent::ExplainThenReturnRetCode(eventBase.GetRetCode());
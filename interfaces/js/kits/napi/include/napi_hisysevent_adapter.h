@@ -63,7 +63,7 @@ public:
 private:
     static void CheckThenWriteSysEvent(HiSysEventAsyncContext* eventAsyncContext);
     static void InnerWrite(HiSysEvent::EventBase& eventBase, const HiSysEventInfo& eventInfo);
-    static int Write(const HiSysEventInfo& eventInfo, uint64_t timeStamp);
+    static int Write(const HiSysEventInfo& eventInfo, uint64_t timeStamp, double sampleRate);
 
 private:
     static void AppendParams(HiSysEvent::EventBase& eventBase,
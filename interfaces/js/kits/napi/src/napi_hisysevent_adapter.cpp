@@ -20,6 +20,7 @@
 #include <memory>
 
 #include "def.h"
+#include "event_control.h"
 #include "hilog/log.h"
 #include "napi_hisysevent_util.h"
 #include "napi/native_node_api.h"
@@ -126,6 +127,12 @@ void NapiHiSysEventAdapter::CheckThenWriteSysEvent(HiSysEventAsyncContext* event
     }
     auto eventInfo = eventAsyncContext->eventInfo;
     auto jsCallerInfo = eventAsyncContext->jsCallerInfo;
+    double sampleRate = 1.0;
+    if (EventControl::GetInstance().IsDropped(eventInfo.domain.c_str(), eventInfo.name.c_str(),
+        eventInfo.eventType, sampleRate)) {
+        eventAsyncContext->eventWroteResult = ERR_DOMAIN_MASKED;
+        return;
+    }
     ControlParam param {
         .period = HISYSEVENT_DEFAULT_PERIOD,
         .threshold = HISYSEVENT_DEFAULT_THRESHOLD,
@@ -141,7 +148,7 @@ void NapiHiSysEventAdapter::CheckThenWriteSysEvent(HiSysEventAsyncContext* event
         eventAsyncContext->eventWroteResult = ERR_WRITE_IN_HIGH_FREQ;
         return;
     }
-    eventAsyncContext->eventWroteResult = Write(eventInfo, timeStamp);
+    eventAsyncContext->eventWroteResult = Write(eventInfo, timeStamp, sampleRate);
 }
 
 void NapiHiSysEventAdapter::Write(const napi_env env, HiSysEventAsyncContext* eventAsyncContext)
@@ -191,7 +198,7 @@ void NapiHiSysEventAdapter::InnerWrite(HiSysEvent::EventBase& eventBase,
     AppendParams(eventBase, eventInfo.params);
 }
 
-int NapiHiSysEventAdapter::Write(const HiSysEventInfo& eventInfo, uint64_t timeStamp)
+int NapiHiSysEventAdapter::Write(const HiSysEventInfo& eventInfo, uint64_t timeStamp, double sampleRate)
 {
     if (!StringFilter::GetInstance().IsValidName(eventInfo.domain, MAX_DOMAIN_LENGTH)) {
         return HiSysEvent::ExplainThenReturnRetCode(ERR_DOMAIN_NAME_INVALID);
@@ -200,6 +207,7 @@ int NapiHiSysEventAdapter::Write(const HiSysEventInfo& eventInfo, uint64_t timeS
         return HiSysEvent::ExplainThenReturnRetCode(ERR_EVENT_NAME_INVALID);
     }
     HiSysEvent::EventBase eventBase(eventInfo.domain, eventInfo.name, eventInfo.eventType, timeStamp);
+    eventBase.SetSampleRate(sampleRate);
     HiSysEvent::WritebaseInfo(eventBase);
     if (HiSysEvent::IsError(eventBase)) {
         return HiSysEvent::ExplainThenReturnRetCode(eventBase.GetRetCode());
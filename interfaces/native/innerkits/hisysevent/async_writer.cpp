@@ -0,0 +1,373 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "async_writer.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <pthread.h>
+#include <sys/resource.h>
+#include <thread>
+
+#include "def.h"
+#include "event_socket_factory.h"
+#include "hilog/log.h"
+#include "hisysevent.h"
+#include "raw_data_base_def.h"
+#include "transport.h"
+
+#undef LOG_DOMAIN
+#define LOG_DOMAIN 0xD002D08
+
+#undef LOG_TAG
+#define LOG_TAG "HISYSEVENT_ASYNC_WRITER"
+
+namespace OHOS {
+namespace HiviewDFX {
+namespace {
+constexpr char WORKER_NAME[] = "HiSysEventAsync";
+
+// fault events and events sent to the server of higher priority go through the priority ring
+bool IsHigherPriorityData(RawData& rawData)
+{
+    if (rawData.GetDataLength() < sizeof(int32_t) + sizeof(HiSysEventHeader)) {
+        return false;
+    }
+    auto header = reinterpret_cast<HiSysEventHeader*>(rawData.GetData() + sizeof(int32_t));
+    int type = static_cast<int>(header->type) + 1; // transform type to HiSysEvent::EventType
+    return type == HiSysEvent::EventType::FAULT || EventSocketFactory::IsHigherPriorityEvent(rawData);
+}
+}
+
+EventRing::EventRing(size_t capacity) : capacity_(capacity), cells_(new Cell[capacity])
+{
+    Reset();
+}
+
+EventRing::Cell* EventRing::AcquireToPush()
+{
+    size_t pos = tail_.load(std::memory_order_relaxed);
+    while (true) {
+        Cell* cell = &cells_[pos % capacity_];
+        size_t seq = cell->seq.load(std::memory_order_acquire);
+        auto diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+        if (diff == 0) {
+            if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                return cell;
+            }
+        } else if (diff < 0) {
+            return nullptr; // the ring is full
+        } else {
+            pos = tail_.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+void EventRing::CommitPush(Cell* cell)
+{
+    cell->seq.store(cell->seq.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+EventRing::Cell* EventRing::Pop()
+{
+    size_t pos = head_.load(std::memory_order_relaxed);
+    while (true) {
+        Cell* cell = &cells_[pos % capacity_];
+        size_t seq = cell->seq.load(std::memory_order_acquire);
+        auto diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+        if (diff == 0) {
+            if (head_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                return cell;
+            }
+        } else if (diff < 0) {
+            return nullptr; // the ring is empty, or the oldest cell is not committed yet
+        } else {
+            pos = head_.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+void EventRing::Release(Cell* cell)
+{
+    // the cell is ready to be pushed again once the tail wraps around to it
+    cell->seq.store(cell->seq.load(std::memory_order_relaxed) + capacity_ - 1, std::memory_order_release);
+}
+
+bool EventRing::IsEmpty() const
+{
+    return head_.load() == tail_.load();
+}
+
+void EventRing::Reset()
+{
+    for (size_t i = 0; i < capacity_; ++i) {
+        cells_[i].seq.store(i, std::memory_order_relaxed);
+    }
+    head_.store(0, std::memory_order_relaxed);
+    tail_.store(0, std::memory_order_relaxed);
+}
+
+__attribute__((no_destroy)) AsyncWriter AsyncWriter::instance_;
+
+AsyncWriter::AsyncWriter() : priorityRing_(PRIORITY_RING_SIZE), normalRing_(NORMAL_RING_SIZE)
+{}
+
+AsyncWriter& AsyncWriter::GetInstance()
+{
+    return instance_;
+}
+
+bool AsyncWriter::IsEnabled() const
+{
+    return isEnabled_.load(std::memory_order_acquire);
+}
+
+void AsyncWriter::Enable(int dropPolicy)
+{
+    static int ret = [] {
+        (void)pthread_atfork(nullptr, nullptr, ResetAfterFork);
+        return atexit(FlushOnExit);
+    }();
+    if (ret != 0) {
+        HILOG_WARN(LOG_CORE, "failed to register the flush hook on exit, ret=%{public}d", ret);
+    }
+    dropPolicy_.store((dropPolicy == DROP_OLDEST) ? DROP_OLDEST : DROP_NEWEST, std::memory_order_relaxed);
+    StartWorker();
+    isEnabled_.store(true, std::memory_order_release);
+}
+
+void AsyncWriter::Disable()
+{
+    isEnabled_.store(false, std::memory_order_release);
+    Flush();
+}
+
+int AsyncWriter::Write(RawData& rawData)
+{
+    if (!isWorkerRunning_.load(std::memory_order_acquire)) {
+        StartWorker();
+    }
+    auto& ring = IsHigherPriorityData(rawData) ? priorityRing_ : normalRing_;
+    int ret = TryPush(ring, rawData);
+    for (int droppedTimes = 0; (ret == ERR_SEND_FAIL) && (droppedTimes < MAX_DROP_TIMES) &&
+        (dropPolicy_.load(std::memory_order_relaxed) == DROP_OLDEST) && DropOldest(ring); ++droppedTimes) {
+        ret = TryPush(ring, rawData);
+    }
+    if (ret == ERR_SEND_FAIL) {
+        droppedCnt_.fetch_add(1, std::memory_order_relaxed);
+        HILOG_DEBUG(LOG_CORE, "async queue is full, drop the newest event");
+    }
+    NotifyWorker();
+    return ret;
+}
+
+void AsyncWriter::Flush()
+{
+    uint64_t targetCnt = queuedCnt_.load(std::memory_order_acquire);
+    std::unique_lock<std::mutex> lock(mutex_);
+    workerCond_.notify_one();
+    while ((doneCnt_.load(std::memory_order_acquire) < targetCnt) && isWorkerRunning_.load()) {
+        flushCond_.wait_for(lock, std::chrono::milliseconds(FLUSH_CHECK_INTERVAL));
+    }
+}
+
+AsyncWriterStats AsyncWriter::GetStats() const
+{
+    AsyncWriterStats stats;
+    stats.queuedCnt = queuedCnt_.load(std::memory_order_relaxed);
+    stats.sentCnt = sentCnt_.load(std::memory_order_relaxed);
+    stats.failedCnt = failedCnt_.load(std::memory_order_relaxed);
+    stats.droppedCnt = droppedCnt_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void AsyncWriter::FlushOnExit()
+{
+    instance_.Stop();
+}
+
+void AsyncWriter::ResetAfterFork()
+{
+    // only the thread calling fork is left in the child process, events queued before are sent by the parent
+    new (&instance_.mutex_) std::mutex();
+    new (&instance_.workerCond_) std::condition_variable();
+    new (&instance_.flushCond_) std::condition_variable();
+    instance_.priorityRing_.Reset();
+    instance_.normalRing_.Reset();
+    instance_.isWorkerRunning_.store(false);
+    instance_.isStopped_.store(false);
+    instance_.isWorkerIdle_.store(false);
+    instance_.queuedBytes_.store(0);
+    instance_.queuedCnt_.store(0);
+    instance_.sentCnt_.store(0);
+    instance_.failedCnt_.store(0);
+    instance_.droppedCnt_.store(0);
+    instance_.doneCnt_.store(0);
+}
+
+bool AsyncWriter::DropOldest(EventRing& ring)
+{
+    auto cell = ring.Pop();
+    if (cell == nullptr) {
+        return false;
+    }
+    ReleaseCell(ring, cell);
+    droppedCnt_.fetch_add(1, std::memory_order_relaxed);
+    doneCnt_.fetch_add(1, std::memory_order_release);
+    HILOG_DEBUG(LOG_CORE, "async queue is full, drop the oldest event");
+    return true;
+}
+
+size_t AsyncWriter::DrainRing(EventRing& ring)
+{
+    EventRing::Cell* cells[MAX_SENT_CNT_OF_ROUND];
+    size_t cellCnt = 0;
+    for (; cellCnt < MAX_SENT_CNT_OF_ROUND; ++cellCnt) {
+        cells[cellCnt] = ring.Pop();
+        if (cells[cellCnt] == nullptr) {
+            break;
+        }
+    }
+    if (cellCnt == 0) {
+        return 0;
+    }
+    RawData* rawDatas[MAX_SENT_CNT_OF_ROUND];
+    int retCodes[MAX_SENT_CNT_OF_ROUND];
+    size_t dataCnt = 0;
+    for (size_t i = 0; i < cellCnt; ++i) {
+        if (cells[i]->data == nullptr || cells[i]->data->IsEmpty()) {
+            failedCnt_.fetch_add(1, std::memory_order_relaxed); // buffer of the cell failed to be allocated
+            continue;
+        }
+        rawDatas[dataCnt++] = cells[i]->data.get();
+    }
+    if (dataCnt > 0) {
+        Transport::GetInstance().SendData(rawDatas, dataCnt, retCodes);
+    }
+    for (size_t i = 0; i < dataCnt; ++i) {
+        (retCodes[i] == SUCCESS ? sentCnt_ : failedCnt_).fetch_add(1, std::memory_order_relaxed);
+    }
+    for (size_t i = 0; i < cellCnt; ++i) {
+        ReleaseCell(ring, cells[i]);
+    }
+    doneCnt_.fetch_add(cellCnt, std::memory_order_release);
+    return cellCnt;
+}
+
+void AsyncWriter::NotifyWorker()
+{
+    // pairs with the idle flag set by the worker before it checks the rings again
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (isWorkerIdle_.load()) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        workerCond_.notify_one();
+    }
+}
+
+void AsyncWriter::ReleaseCell(EventRing& ring, EventRing::Cell* cell)
+{
+    if (cell->data != nullptr) {
+        queuedBytes_.fetch_sub(cell->data->GetDataLength(), std::memory_order_relaxed);
+        // buffer expanded by an oversized event is not kept for the following events
+        if (cell->data->GetCapacity() > MAX_KEPT_CAPACITY) {
+            cell->data.reset();
+        }
+    }
+    ring.Release(cell);
+}
+
+void AsyncWriter::Run()
+{
+    // on linux, the nice value set with a zero id only applies to the calling thread
+    if (setpriority(PRIO_PROCESS, 0, LOW_PRIORITY_NICE) != 0) {
+        HILOG_DEBUG(LOG_CORE, "failed to lower priority of async writer");
+    }
+    pthread_setname_np(pthread_self(), WORKER_NAME);
+    while (true) {
+        // events in the priority ring are always sent before the normal ones
+        if (DrainRing(priorityRing_) > 0 || DrainRing(normalRing_) > 0) {
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(mutex_);
+        flushCond_.notify_all();
+        if (isStopped_.load() && priorityRing_.IsEmpty() && normalRing_.IsEmpty()) {
+            isWorkerRunning_.store(false, std::memory_order_release);
+            flushCond_.notify_all();
+            return;
+        }
+        isWorkerIdle_.store(true);
+        workerCond_.wait_for(lock, std::chrono::milliseconds(IDLE_WAIT_TIME), [this] {
+            return isStopped_.load() || !priorityRing_.IsEmpty() || !normalRing_.IsEmpty();
+        });
+        isWorkerIdle_.store(false);
+    }
+}
+
+void AsyncWriter::StartWorker()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (isWorkerRunning_.load(std::memory_order_acquire) || isStopped_.load()) {
+        return;
+    }
+    std::thread worker(&AsyncWriter::Run, this);
+    worker.detach();
+    isWorkerRunning_.store(true, std::memory_order_release);
+}
+
+void AsyncWriter::Stop()
+{
+    isEnabled_.store(false, std::memory_order_release);
+    std::unique_lock<std::mutex> lock(mutex_);
+    isStopped_.store(true);
+    workerCond_.notify_one();
+    (void)flushCond_.wait_for(lock, std::chrono::milliseconds(MAX_EXIT_WAIT_TIME), [this] {
+        return !isWorkerRunning_.load();
+    });
+}
+
+int AsyncWriter::TryPush(EventRing& ring, RawData& rawData)
+{
+    size_t len = rawData.GetDataLength();
+    if (queuedBytes_.fetch_add(len, std::memory_order_relaxed) + len > MAX_QUEUED_BYTES) {
+        queuedBytes_.fetch_sub(len, std::memory_order_relaxed);
+        return ERR_SEND_FAIL;
+    }
+    auto cell = ring.AcquireToPush();
+    if (cell == nullptr) {
+        queuedBytes_.fetch_sub(len, std::memory_order_relaxed);
+        return ERR_SEND_FAIL;
+    }
+    if (cell->data == nullptr) {
+        cell->data.reset(new(std::nothrow) RawData());
+    } else {
+        cell->data->Reset();
+    }
+    int ret = SUCCESS;
+    if (cell->data == nullptr || !cell->data->Append(rawData.GetData(), len)) {
+        // the acquired cell has to be committed, it is counted as failed by the worker
+        if (cell->data != nullptr) {
+            cell->data->Reset();
+        }
+        queuedBytes_.fetch_sub(len, std::memory_order_relaxed);
+        ret = ERR_RAW_DATA_WROTE_EXCEPTION;
+    }
+    queuedCnt_.fetch_add(1, std::memory_order_release);
+    ring.CommitPush(cell);
+    return ret;
+}
+} // namespace HiviewDFX
+} // namespace OHOS
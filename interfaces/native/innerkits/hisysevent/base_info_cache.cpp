@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "base_info_cache.h"
+
+#include <atomic>
+#include <ctime>
+#include <pthread.h>
+#include <unistd.h>
+
+#include "raw_data_base_def.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+namespace {
+constexpr uint32_t INVALID_ID = UINT32_MAX;
+constexpr uint32_t ROOT_UID = 0;
+constexpr int64_t INVALID_TIME_ZONE = INT64_MIN;
+
+// time zone value and its index are packed together, so that they are always updated as a whole
+constexpr int64_t TIME_ZONE_INDEX_RANGE = 256;
+constexpr int64_t TIME_ZONE_INDEX_MASK = TIME_ZONE_INDEX_RANGE - 1;
+
+std::atomic<uint32_t> g_pid { INVALID_ID };
+std::atomic<uint32_t> g_uid { INVALID_ID };
+std::atomic<int64_t> g_timeZone { INVALID_TIME_ZONE };
+thread_local uint32_t g_tid = INVALID_ID;
+}
+
+void BaseInfoCache::RegisterForkHandler()
+{
+    static int ret = pthread_atfork(nullptr, nullptr, ResetAfterFork);
+    (void)ret;
+}
+
+void BaseInfoCache::ResetAfterFork()
+{
+    // only the thread calling fork is left in the child process
+    g_pid.store(INVALID_ID, std::memory_order_relaxed);
+    g_uid.store(INVALID_ID, std::memory_order_relaxed);
+    g_tid = INVALID_ID;
+}
+
+uint32_t BaseInfoCache::GetPid()
+{
+    uint32_t pid = g_pid.load(std::memory_order_relaxed);
+    if (pid == INVALID_ID) {
+        RegisterForkHandler();
+        pid = static_cast<uint32_t>(getprocpid());
+        g_pid.store(pid, std::memory_order_relaxed);
+    }
+    return pid;
+}
+
+uint32_t BaseInfoCache::GetTid()
+{
+    if (g_tid == INVALID_ID) {
+        RegisterForkHandler();
+        g_tid = static_cast<uint32_t>(getproctid());
+    }
+    return g_tid;
+}
+
+uint32_t BaseInfoCache::GetUid()
+{
+    uint32_t uid = g_uid.load(std::memory_order_relaxed);
+    if (uid != INVALID_ID) {
+        return uid;
+    }
+    RegisterForkHandler();
+    uid = static_cast<uint32_t>(getuid());
+    // root process may drop its privilege by setuid later, e.g. processes forked by appspawn, so uid of root
+    // is never cached
+    if (uid != ROOT_UID) {
+        g_uid.store(uid, std::memory_order_relaxed);
+    }
+    return uid;
+}
+
+uint8_t BaseInfoCache::GetTimeZone()
+{
+    // timezone is updated by tzset while the time zone of system changes, it is parsed again only if it changes
+    int64_t tz = static_cast<int64_t>(timezone);
+    int64_t cachedTimeZone = g_timeZone.load(std::memory_order_relaxed);
+    if (cachedTimeZone != INVALID_TIME_ZONE) {
+        int64_t index = cachedTimeZone & TIME_ZONE_INDEX_MASK;
+        if ((cachedTimeZone - index) / TIME_ZONE_INDEX_RANGE == tz) {
+            return static_cast<uint8_t>(index);
+        }
+    }
+    int64_t index = Encoded::ParseTimeZone(static_cast<long>(tz)) & TIME_ZONE_INDEX_MASK;
+    g_timeZone.store(tz * TIME_ZONE_INDEX_RANGE + index, std::memory_order_relaxed);
+    return static_cast<uint8_t>(index);
+}
+} // namespace HiviewDFX
+} // namespace OHOS
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "congestion_control.h"
+
+#include <chrono>
+
+namespace OHOS {
+namespace HiviewDFX {
+namespace {
+constexpr uint32_t BREAK_THRESHOLD = 3; // sends failed in a row
+constexpr int64_t BREAK_TIME = 100 * 1000 * 1000; // 100ms
+
+inline int64_t GetSteadyTimeInNanoSec()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+}
+
+bool CongestionControl::IsSendAllowed(bool isHigherPriority)
+{
+    if (state_.load(std::memory_order_relaxed) != BROKEN || isHigherPriority) {
+        return true;
+    }
+    // one send is allowed to probe the destination once the circuit has been broken for a while
+    auto now = GetSteadyTimeInNanoSec();
+    auto brokenUntil = brokenUntil_.load(std::memory_order_relaxed);
+    if (now >= brokenUntil &&
+        brokenUntil_.compare_exchange_strong(brokenUntil, now + BREAK_TIME, std::memory_order_relaxed)) {
+        return true;
+    }
+    skippedCnt_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+void CongestionControl::OnSendBlocked()
+{
+    uint8_t state = NORMAL;
+    if (state_.compare_exchange_strong(state, CONGESTED, std::memory_order_relaxed)) {
+        congestedCnt_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void CongestionControl::OnSendFailed()
+{
+    if (failedCnt_.fetch_add(1, std::memory_order_relaxed) + 1 < BREAK_THRESHOLD) {
+        return;
+    }
+    brokenUntil_.store(GetSteadyTimeInNanoSec() + BREAK_TIME, std::memory_order_relaxed);
+    if (state_.exchange(BROKEN, std::memory_order_relaxed) != BROKEN) {
+        brokenCnt_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void CongestionControl::OnSendSucceeded()
+{
+    if (state_.load(std::memory_order_relaxed) == NORMAL) {
+        return;
+    }
+    failedCnt_.store(0, std::memory_order_relaxed);
+    if (state_.exchange(NORMAL, std::memory_order_relaxed) != NORMAL) {
+        recoveredCnt_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+CongestionStats CongestionControl::GetStats() const
+{
+    CongestionStats stats;
+    stats.congestedCnt = congestedCnt_.load(std::memory_order_relaxed);
+    stats.brokenCnt = brokenCnt_.load(std::memory_order_relaxed);
+    stats.recoveredCnt = recoveredCnt_.load(std::memory_order_relaxed);
+    stats.skippedCnt = skippedCnt_.load(std::memory_order_relaxed);
+    return stats;
+}
+} // namespace HiviewDFX
+} // namespace OHOS
@@ -0,0 +1,529 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "event_control.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <ctime>
+#include <fcntl.h>
+#include <new>
+#include <pthread.h>
+#include <pwd.h>
+#include <securec.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+
+#include "base_info_cache.h"
+#include "hilog/log.h"
+#include "hisysevent.h"
+
+#undef LOG_DOMAIN
+#define LOG_DOMAIN 0xD002D08
+
+#undef LOG_TAG
+#define LOG_TAG "HISYSEVENT_EVENT_CONTROL"
+
+namespace OHOS {
+namespace HiviewDFX {
+namespace {
+constexpr char EVENT_CONTROL_PATH[] = "/dev/shm/hisysevent_control";
+constexpr mode_t CONTROL_MODE = 0644;
+constexpr char HIVIEW_USER_NAME[] = "hiview";
+constexpr char PROBER_NAME[] = "HiSysEventCtrl";
+constexpr uid_t ROOT_UID = 0;
+constexpr size_t PASSWD_BUFFER_SIZE = 1024;
+constexpr size_t BITS_PER_WORD = 64;
+constexpr uint64_t FNV_OFFSET_BASIS = 0xCBF29CE484222325ULL;
+constexpr uint64_t FNV_PRIME = 0x100000001B3ULL;
+constexpr uint64_t MIX_MULTIPLIER = 0xFF51AFD7ED558CCDULL;
+constexpr uint64_t FINAL_MIX_MULTIPLIER = 0xC4CEB9FE1A85EC53ULL;
+constexpr uint64_t WEYL_INCREMENT = 0x9E3779B97F4A7C15ULL;
+constexpr unsigned int MIX_SHIFT = 33;
+constexpr unsigned int DRAW_SHIFT = 32;
+constexpr double DRAW_RANGE = 4294967296.0; // 2^32, draws are in [0, DRAW_RANGE)
+constexpr double FULL_RATE = 1.0;
+constexpr int64_t MS_PER_SECOND = 1000;
+constexpr int64_t NS_PER_MS = 1000000;
+
+// uid of hiview is looked up by its user name, only root is trusted if the user isn't found
+uid_t GetHiviewUid()
+{
+    static uid_t hiviewUid = [] {
+        struct passwd pwd {};
+        struct passwd* result = nullptr;
+        char buffer[PASSWD_BUFFER_SIZE] = { 0 };
+        if (getpwnam_r(HIVIEW_USER_NAME, &pwd, buffer, sizeof(buffer), &result) != 0 || result == nullptr) {
+            HILOG_DEBUG(LOG_CORE, "user of hiview is not found");
+            return ROOT_UID;
+        }
+        return result->pw_uid;
+    }();
+    return hiviewUid;
+}
+
+// block published by others is never trusted, since it decides which events are dropped by all writers
+inline bool IsTrustedBlockFile(const struct stat& fileStat)
+{
+    return (fileStat.st_uid == ROOT_UID || fileStat.st_uid == GetHiviewUid()) &&
+        (fileStat.st_mode & (S_IWGRP | S_IWOTH)) == 0;
+}
+
+int64_t GetCoarseTimeMills()
+{
+    struct timespec ts {};
+    (void)clock_gettime(CLOCK_MONOTONIC_COARSE, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * MS_PER_SECOND + ts.tv_nsec / NS_PER_MS;
+}
+
+// hash of the domain is the seed of the names in it
+uint64_t Hash(uint64_t seed, std::string_view str)
+{
+    uint64_t hash = seed;
+    for (char ch : str) {
+        hash = (hash ^ static_cast<uint8_t>(ch)) * FNV_PRIME;
+    }
+    hash ^= hash >> MIX_SHIFT;
+    hash *= MIX_MULTIPLIER;
+    return hash ^ (hash >> MIX_SHIFT);
+}
+
+inline std::string_view GetEntryField(const char* field, size_t maxLen)
+{
+    return std::string_view(field, strnlen(field, maxLen));
+}
+
+inline bool TestBit(const std::atomic<uint64_t>* bits, size_t bitCnt, uint64_t hash)
+{
+    size_t pos = hash % bitCnt;
+    return (bits[pos / BITS_PER_WORD].load(std::memory_order_relaxed) & (1ULL << (pos % BITS_PER_WORD))) != 0;
+}
+
+inline void SetBit(uint64_t* bits, size_t bitCnt, uint64_t hash)
+{
+    size_t pos = hash % bitCnt;
+    bits[pos / BITS_PER_WORD] |= (1ULL << (pos % BITS_PER_WORD));
+}
+
+// entries being updated are skipped, the caller sees the result either before or after the update
+bool ReadEntry(const EventControlEntry& entry, std::string_view domain, std::string_view name, double& keptRate,
+    uint32_t& samplingKey)
+{
+    uint32_t seq = entry.seq.load(std::memory_order_acquire);
+    if ((seq & 1) != 0) {
+        return false;
+    }
+    bool isMatched = GetEntryField(entry.domain, sizeof(entry.domain)) == domain &&
+        GetEntryField(entry.name, sizeof(entry.name)) == name;
+    double rate = entry.keptRate;
+    uint32_t key = entry.samplingKey;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (!isMatched || entry.seq.load(std::memory_order_relaxed) != seq) {
+        return false;
+    }
+    keptRate = rate;
+    samplingKey = key;
+    return true;
+}
+
+bool FindEntry(const EventControlBlock& block, std::string_view domain, std::string_view name, double& keptRate,
+    uint32_t& samplingKey)
+{
+    for (const auto& entry : block.entries) {
+        if (ReadEntry(entry, domain, name, keptRate, samplingKey)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool IsEntryMatched(const EventControlEntry& entry, std::string_view domain, std::string_view name)
+{
+    double keptRate = 0;
+    uint32_t samplingKey = SAMPLING_BY_RANDOM;
+    return ReadEntry(entry, domain, name, keptRate, samplingKey);
+}
+
+// rate of the event is the lower one of its domain and its name, along with the key of that one
+void GetControlledRate(const EventControlBlock& block, const char* domain, const char* eventName, double& keptRate,
+    uint32_t& samplingKey)
+{
+    std::string_view domainField = GetEntryField(domain, MAX_DOMAIN_LENGTH);
+    uint64_t domainHash = Hash(FNV_OFFSET_BASIS, domainField);
+    if (!TestBit(block.domainBits, CONTROLLED_DOMAIN_BIT_CNT, domainHash)) {
+        return;
+    }
+    (void)FindEntry(block, domainField, "", keptRate, samplingKey);
+    if (keptRate <= 0) {
+        return;
+    }
+    std::string_view nameField = GetEntryField(eventName, MAX_EVENT_NAME_LENGTH);
+    if (!TestBit(block.eventBits, CONTROLLED_EVENT_BIT_CNT, Hash(domainHash, nameField))) {
+        return;
+    }
+    double eventRate = FULL_RATE;
+    uint32_t eventKey = SAMPLING_BY_RANDOM;
+    if (FindEntry(block, domainField, nameField, eventRate, eventKey) && eventRate < keptRate) {
+        keptRate = eventRate;
+        samplingKey = eventKey;
+    }
+}
+
+// finalizer of murmur3, by which keys next to each other are spread over the whole range
+uint64_t Mix(uint64_t key)
+{
+    key ^= key >> MIX_SHIFT;
+    key *= MIX_MULTIPLIER;
+    key ^= key >> MIX_SHIFT;
+    key *= FINAL_MIX_MULTIPLIER;
+    return key ^ (key >> MIX_SHIFT);
+}
+
+// draw of the uid or the pid is the same in all processes, so the same users are kept by every event of the key
+uint32_t GetSamplingDraw(uint32_t samplingKey)
+{
+    if (samplingKey == SAMPLING_BY_UID) {
+        return static_cast<uint32_t>(Mix(BaseInfoCache::GetUid()) >> DRAW_SHIFT);
+    }
+    if (samplingKey == SAMPLING_BY_PID) {
+        return static_cast<uint32_t>(Mix(BaseInfoCache::GetPid()) >> DRAW_SHIFT);
+    }
+    thread_local uint64_t state = Mix((static_cast<uint64_t>(BaseInfoCache::GetTid()) << DRAW_SHIFT) ^
+        static_cast<uint64_t>(GetCoarseTimeMills()));
+    state += WEYL_INCREMENT;
+    return static_cast<uint32_t>(Mix(state) >> DRAW_SHIFT);
+}
+
+void UpdateEntry(EventControlEntry& entry, std::string_view domain, std::string_view name, double keptRate = 0,
+    uint32_t samplingKey = SAMPLING_BY_RANDOM)
+{
+    uint32_t seq = entry.seq.load(std::memory_order_relaxed);
+    entry.seq.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    entry.keptRate = keptRate;
+    entry.samplingKey = samplingKey;
+    (void)memset_s(entry.domain, sizeof(entry.domain), 0, sizeof(entry.domain));
+    (void)memset_s(entry.name, sizeof(entry.name), 0, sizeof(entry.name));
+    if (!domain.empty()) {
+        (void)memcpy_s(entry.domain, sizeof(entry.domain) - 1, domain.data(), domain.size());
+        if (!name.empty()) {
+            (void)memcpy_s(entry.name, sizeof(entry.name) - 1, name.data(), name.size());
+        }
+    }
+    entry.seq.store(seq + 2, std::memory_order_release); // 2: the entry is stable again
+}
+}
+
+EventControl::EventControl(const std::string& path) : path_(path)
+{
+    // block published before is mapped at once, the one published later is mapped by the prober
+    (void)MapBlock();
+}
+
+EventControl::~EventControl()
+{
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        isStopped_ = true;
+        proberCond_.notify_all();
+        proberCond_.wait(lock, [this] {
+            return !isProberRunning_;
+        });
+    }
+    auto block = block_.load(std::memory_order_relaxed);
+    if (block != nullptr) {
+        munmap(const_cast<EventControlBlock*>(block), sizeof(EventControlBlock));
+    }
+}
+
+EventControl& EventControl::GetInstance()
+{
+    // control is never destroyed, for the block is still checked by the events wrote on exit
+    __attribute__((no_destroy)) static EventControl control(EVENT_CONTROL_PATH);
+    static int ret = pthread_atfork(nullptr, nullptr, [] {
+        GetInstance().ResetAfterFork();
+    });
+    (void)ret;
+    return control;
+}
+
+bool EventControl::IsDropped(const char* domain, const char* eventName, int type)
+{
+    double sampleRate = FULL_RATE;
+    return IsDropped(domain, eventName, type, sampleRate);
+}
+
+bool EventControl::IsDropped(const char* domain, const char* eventName, int type, double& sampleRate)
+{
+    sampleRate = FULL_RATE;
+    const EventControlBlock* block = GetBlock();
+    if (block == nullptr || domain == nullptr || eventName == nullptr) {
+        return false;
+    }
+    double keptRate = FULL_RATE;
+    uint32_t samplingKey = SAMPLING_BY_RANDOM;
+    if (block->usedEntryCnt.load(std::memory_order_acquire) != 0) {
+        GetControlledRate(*block, domain, eventName, keptRate, samplingKey);
+    }
+    uint32_t level = block->samplingLevel.load(std::memory_order_relaxed);
+    if (level != 0 && level <= MAX_SAMPLING_LEVEL &&
+        (type == HiSysEvent::EventType::STATISTIC || type == HiSysEvent::EventType::BEHAVIOR)) {
+        keptRate = std::min(keptRate, FULL_RATE / (1U << level));
+    }
+    if (keptRate >= FULL_RATE) {
+        return false;
+    }
+    // one draw is compared with all the rates, so events kept at a lower rate are always kept at a higher one
+    if (keptRate <= 0 || GetSamplingDraw(samplingKey) >= keptRate * DRAW_RANGE) {
+        return true;
+    }
+    sampleRate = keptRate;
+    return false;
+}
+
+const EventControlBlock* EventControl::GetBlock()
+{
+    // the writer never looks for the block, which is left to the prober started by the first writer
+    const EventControlBlock* block = block_.load(std::memory_order_acquire);
+    if (block == nullptr && !isProberStarted_.load(std::memory_order_relaxed) && !isProberStarted_.exchange(true)) {
+        StartProber();
+    }
+    return block;
+}
+
+bool EventControl::MapBlock()
+{
+    int fd = TEMP_FAILURE_RETRY(open(path_.c_str(), O_RDONLY | O_CLOEXEC));
+    if (fd < 0) {
+        return false;
+    }
+    struct stat fileStat {};
+    void* addr = MAP_FAILED;
+    if (fstat(fd, &fileStat) == 0 && IsTrustedBlockFile(fileStat) &&
+        static_cast<size_t>(fileStat.st_size) >= sizeof(EventControlBlock)) {
+        addr = mmap(nullptr, sizeof(EventControlBlock), PROT_READ, MAP_SHARED, fd, 0);
+    }
+    close(fd);
+    if (addr == MAP_FAILED) {
+        return false;
+    }
+    auto block = static_cast<const EventControlBlock*>(addr);
+    if (block->magic != EVENT_CONTROL_MAGIC || block->version != EVENT_CONTROL_VERSION) {
+        HILOG_WARN(LOG_CORE, "invalid event control block");
+        munmap(addr, sizeof(EventControlBlock));
+        return false;
+    }
+    block_.store(block, std::memory_order_release);
+    return true;
+}
+
+void EventControl::StartProber()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (isStopped_) {
+        return;
+    }
+    isProberRunning_ = true;
+    std::thread prober(&EventControl::RunProber, this);
+    prober.detach();
+}
+
+void EventControl::RunProber()
+{
+    pthread_setname_np(pthread_self(), PROBER_NAME);
+    // the block is looked for at once, since the prober of a forked child is started long after the construction
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!MapBlock() && !proberCond_.wait_for(lock, std::chrono::milliseconds(MAP_RETRY_INTERVAL), [this] {
+        return isStopped_;
+    })) {}
+    isProberRunning_ = false;
+    proberCond_.notify_all();
+}
+
+void EventControl::ResetAfterFork()
+{
+    // the prober of the parent process is gone in the child process, which starts its own one if it needs
+    new (&mutex_) std::mutex();
+    new (&proberCond_) std::condition_variable();
+    isProberRunning_ = false;
+    isProberStarted_.store(false);
+}
+
+EventControlPublisher::~EventControlPublisher()
+{
+    if (block_ != nullptr) {
+        munmap(block_, sizeof(EventControlBlock));
+    }
+    if (fd_ >= 0) {
+        close(fd_);
+    }
+}
+
+bool EventControlPublisher::Init(const std::string& path)
+{
+    if (block_ != nullptr) {
+        return false;
+    }
+    // the block is updated in place, so writers which have mapped it never miss the updates
+    int fd = TEMP_FAILURE_RETRY(open(path.c_str(), O_CREAT | O_RDWR | O_CLOEXEC, CONTROL_MODE));
+    if (fd < 0) {
+        HILOG_WARN(LOG_CORE, "failed to open event control block, errno=%{public}d", errno);
+        return false;
+    }
+    struct stat fileStat {};
+    if (flock(fd, LOCK_EX | LOCK_NB) != 0 || fstat(fd, &fileStat) != 0 ||
+        (static_cast<size_t>(fileStat.st_size) < sizeof(EventControlBlock) &&
+        ftruncate(fd, static_cast<off_t>(sizeof(EventControlBlock))) != 0)) {
+        close(fd);
+        return false;
+    }
+    void* addr = mmap(nullptr, sizeof(EventControlBlock), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (addr == MAP_FAILED) {
+        close(fd);
+        return false;
+    }
+    // the file may be left with another mode, which is never trusted by the writers
+    (void)fchmod(fd, CONTROL_MODE);
+    fd_ = fd;
+    block_ = static_cast<EventControlBlock*>(addr);
+    // block published by the last publisher is kept, otherwise it's set up before the magic is published
+    if (block_->magic != EVENT_CONTROL_MAGIC || block_->version != EVENT_CONTROL_VERSION) {
+        (void)memset_s(block_, sizeof(EventControlBlock), 0, sizeof(EventControlBlock));
+        block_->version = EVENT_CONTROL_VERSION;
+        std::atomic_thread_fence(std::memory_order_release);
+        block_->magic = EVENT_CONTROL_MAGIC;
+    }
+    return true;
+}
+
+bool EventControlPublisher::Disable(std::string_view domain, std::string_view eventName)
+{
+    return SetSamplingRate(domain, eventName, 0);
+}
+
+bool EventControlPublisher::Enable(std::string_view domain, std::string_view eventName)
+{
+    if (block_ == nullptr) {
+        return false;
+    }
+    for (auto& entry : block_->entries) {
+        if (IsEntryMatched(entry, domain, eventName)) {
+            UpdateEntry(entry, "", "");
+            block_->usedEntryCnt.fetch_sub(1, std::memory_order_release);
+            RebuildBits();
+            return true;
+        }
+    }
+    return false;
+}
+
+bool EventControlPublisher::SetSamplingRate(std::string_view domain, std::string_view eventName, double rate,
+    SamplingKey key)
+{
+    if (block_ == nullptr || domain.empty() || domain.size() > MAX_DOMAIN_LENGTH ||
+        eventName.size() > MAX_EVENT_NAME_LENGTH || !(rate >= 0 && rate <= FULL_RATE) || key > SAMPLING_BY_PID) {
+        return false;
+    }
+    if (rate >= FULL_RATE) {
+        (void)Enable(domain, eventName);
+        return true;
+    }
+    for (auto& entry : block_->entries) {
+        if (IsEntryMatched(entry, domain, eventName)) {
+            UpdateEntry(entry, domain, eventName, rate, key);
+            return true;
+        }
+    }
+    return AddEntry(domain, eventName, rate, key);
+}
+
+bool EventControlPublisher::SetSamplingLevel(uint32_t level)
+{
+    if (block_ == nullptr || level > MAX_SAMPLING_LEVEL) {
+        return false;
+    }
+    block_->samplingLevel.store(level, std::memory_order_relaxed);
+    return true;
+}
+
+void EventControlPublisher::Reset()
+{
+    if (block_ == nullptr) {
+        return;
+    }
+    block_->usedEntryCnt.store(0, std::memory_order_release);
+    block_->samplingLevel.store(0, std::memory_order_relaxed);
+    for (auto& entry : block_->entries) {
+        if (entry.domain[0] != '\0') {
+            UpdateEntry(entry, "", "");
+        }
+    }
+    RebuildBits();
+}
+
+bool EventControlPublisher::AddEntry(std::string_view domain, std::string_view eventName, double rate,
+    SamplingKey key)
+{
+    for (auto& entry : block_->entries) {
+        if (entry.domain[0] != '\0') {
+            continue;
+        }
+        UpdateEntry(entry, domain, eventName, rate, key);
+        uint64_t domainHash = Hash(FNV_OFFSET_BASIS, domain);
+        size_t domainPos = domainHash % CONTROLLED_DOMAIN_BIT_CNT;
+        block_->domainBits[domainPos / BITS_PER_WORD].fetch_or(1ULL << (domainPos % BITS_PER_WORD),
+            std::memory_order_relaxed);
+        if (!eventName.empty()) {
+            size_t eventPos = Hash(domainHash, eventName) % CONTROLLED_EVENT_BIT_CNT;
+            block_->eventBits[eventPos / BITS_PER_WORD].fetch_or(1ULL << (eventPos % BITS_PER_WORD),
+                std::memory_order_relaxed);
+        }
+        block_->usedEntryCnt.fetch_add(1, std::memory_order_release);
+        return true;
+    }
+    HILOG_WARN(LOG_CORE, "too many events controlled");
+    return false;
+}
+
+void EventControlPublisher::RebuildBits()
+{
+    // bits are shared by the entries of the same hash, so they are rebuilt from the entries left
+    uint64_t domainBits[CONTROLLED_DOMAIN_BIT_CNT / BITS_PER_WORD] = { 0 };
+    uint64_t eventBits[CONTROLLED_EVENT_BIT_CNT / BITS_PER_WORD] = { 0 };
+    for (const auto& entry : block_->entries) {
+        if (entry.domain[0] == '\0') {
+            continue;
+        }
+        uint64_t domainHash = Hash(FNV_OFFSET_BASIS, GetEntryField(entry.domain, sizeof(entry.domain)));
+        SetBit(domainBits, CONTROLLED_DOMAIN_BIT_CNT, domainHash);
+        if (entry.name[0] != '\0') {
+            SetBit(eventBits, CONTROLLED_EVENT_BIT_CNT,
+                Hash(domainHash, GetEntryField(entry.name, sizeof(entry.name))));
+        }
+    }
+    for (size_t i = 0; i < CONTROLLED_DOMAIN_BIT_CNT / BITS_PER_WORD; ++i) {
+        block_->domainBits[i].store(domainBits[i], std::memory_order_relaxed);
+    }
+    for (size_t i = 0; i < CONTROLLED_EVENT_BIT_CNT / BITS_PER_WORD; ++i) {
+        block_->eventBits[i].store(eventBits[i], std::memory_order_relaxed);
+    }
+}
+} // namespace HiviewDFX
+} // namespace OHOS
@@ -0,0 +1,465 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "event_journal.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <dirent.h>
+#include <fcntl.h>
+#include <new>
+#include <pthread.h>
+#include <securec.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+
+#include "def.h"
+#include "hilog/log.h"
+
+#undef LOG_DOMAIN
+#define LOG_DOMAIN 0xD002D08
+
+#undef LOG_TAG
+#define LOG_TAG "HISYSEVENT_EVENT_JOURNAL"
+
+namespace OHOS {
+namespace HiviewDFX {
+namespace {
+constexpr char DRAINER_NAME[] = "HiSysEventJrnl";
+constexpr char JOURNAL_PREFIX[] = "hisysevent_";
+constexpr char JOURNAL_SUFFIX[] = ".journal";
+constexpr uint32_t RECORD_FREE = 0;
+constexpr uint32_t RECORD_COMMITTED = 1;
+constexpr uint32_t RECORD_PADDING = 2;
+constexpr size_t RECORD_ALIGNMENT = 16;
+constexpr mode_t JOURNAL_MODE = 0660;
+constexpr uint32_t FNV_OFFSET_BASIS = 2166136261U;
+constexpr uint32_t FNV_PRIME = 16777619U;
+
+inline size_t GetRecordSize(size_t dataLen)
+{
+    return (sizeof(EventJournalRecord) + dataLen + RECORD_ALIGNMENT - 1) & ~(RECORD_ALIGNMENT - 1);
+}
+
+inline bool IsPowerOfTwo(size_t value)
+{
+    return value != 0 && (value & (value - 1)) == 0;
+}
+
+uint32_t GetChecksum(const uint8_t* data, size_t len)
+{
+    uint32_t checksum = FNV_OFFSET_BASIS;
+    for (size_t i = 0; i < len; ++i) {
+        checksum = (checksum ^ data[i]) * FNV_PRIME;
+    }
+    return checksum;
+}
+
+bool IsJournalName(const std::string& name)
+{
+    constexpr size_t prefixLen = sizeof(JOURNAL_PREFIX) - 1;
+    constexpr size_t suffixLen = sizeof(JOURNAL_SUFFIX) - 1;
+    return name.size() > prefixLen + suffixLen && name.compare(0, prefixLen, JOURNAL_PREFIX) == 0 &&
+        name.compare(name.size() - suffixLen, suffixLen, JOURNAL_SUFFIX) == 0;
+}
+
+int OpenLockedFile(const std::string& path, int flags)
+{
+    int fd = TEMP_FAILURE_RETRY(open(path.c_str(), flags | O_RDWR | O_CLOEXEC, JOURNAL_MODE));
+    if (fd < 0) {
+        return -1;
+    }
+    // the lock is held until the process exits, so journals locked are never replayed by others
+    if (flock(fd, LOCK_EX | LOCK_NB) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+}
+
+EventJournalFile::~EventJournalFile()
+{
+    if (header_ != nullptr) {
+        munmap(header_, size_);
+    }
+    if (fd_ >= 0) {
+        close(fd_);
+    }
+}
+
+bool EventJournalFile::Create(const std::string& path, size_t capacity)
+{
+    if (header_ != nullptr || !IsPowerOfTwo(capacity)) {
+        return false;
+    }
+    int fd = OpenLockedFile(path, O_CREAT | O_EXCL);
+    if (fd < 0) {
+        HILOG_WARN(LOG_CORE, "failed to create journal, errno=%{public}d", errno);
+        return false;
+    }
+    size_t size = sizeof(EventJournalHeader) + capacity;
+    if (ftruncate(fd, static_cast<off_t>(size)) != 0 || !Map(fd, size)) {
+        close(fd);
+        unlink(path.c_str());
+        return false;
+    }
+    header_->magic = EVENT_JOURNAL_MAGIC;
+    header_->version = EVENT_JOURNAL_VERSION;
+    header_->capacity = capacity;
+    header_->writePos.store(0, std::memory_order_relaxed);
+    header_->readPos.store(0, std::memory_order_relaxed);
+    return true;
+}
+
+bool EventJournalFile::Open(const std::string& path)
+{
+    if (header_ != nullptr) {
+        return false;
+    }
+    int fd = OpenLockedFile(path, 0);
+    struct stat st = {};
+    if (fd < 0 || fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) <= sizeof(EventJournalHeader) ||
+        !Map(fd, static_cast<size_t>(st.st_size))) {
+        if (fd >= 0) {
+            close(fd);
+        }
+        return false;
+    }
+    // journal is replayed only if it's framed as this version does
+    return header_->magic == EVENT_JOURNAL_MAGIC && header_->version == EVENT_JOURNAL_VERSION &&
+        IsPowerOfTwo(header_->capacity) && header_->capacity + sizeof(EventJournalHeader) == size_ &&
+        header_->writePos.load(std::memory_order_relaxed) - header_->readPos.load(std::memory_order_relaxed) <=
+        header_->capacity;
+}
+
+int EventJournalFile::Append(const RawData& rawData)
+{
+    if (header_ == nullptr) {
+        return ERR_DOES_NOT_INIT;
+    }
+    size_t len = rawData.GetDataLength();
+    size_t recordSize = GetRecordSize(len);
+    size_t capacity = header_->capacity;
+    if (recordSize > capacity / 2) { // 2 records at most are reserved while the journal wraps around
+        return ERR_OVER_SIZE;
+    }
+    uint64_t pos = header_->writePos.load(std::memory_order_relaxed);
+    size_t offset = 0;
+    size_t reservedSize = 0;
+    do {
+        offset = pos & (capacity - 1);
+        // record is never split, the room left at the end of the journal is filled with a padding record
+        reservedSize = (capacity - offset >= recordSize) ? recordSize : (capacity - offset + recordSize);
+        if (pos + reservedSize - header_->readPos.load(std::memory_order_acquire) > capacity) {
+            return ERR_SEND_FAIL; // the journal is full
+        }
+    } while (!header_->writePos.compare_exchange_weak(pos, pos + reservedSize, std::memory_order_relaxed));
+    if (reservedSize != recordSize) {
+        auto padding = reinterpret_cast<EventJournalRecord*>(records_ + offset);
+        padding->len = static_cast<uint32_t>(capacity - offset - sizeof(EventJournalRecord));
+        padding->state.store(RECORD_PADDING, std::memory_order_release);
+        offset = 0;
+    }
+    auto record = reinterpret_cast<EventJournalRecord*>(records_ + offset);
+    record->len = static_cast<uint32_t>(len);
+    auto data = reinterpret_cast<uint8_t*>(record + 1);
+    if (memcpy_s(data, capacity - offset - sizeof(EventJournalRecord), rawData.GetData(), len) != EOK) {
+        // the record reserved has to be released, which is skipped by the drainer as a padding one
+        record->state.store(RECORD_PADDING, std::memory_order_release);
+        return ERR_RAW_DATA_WROTE_EXCEPTION;
+    }
+    record->checksum = GetChecksum(data, len);
+    record->state.store(RECORD_COMMITTED, std::memory_order_release);
+    return SUCCESS;
+}
+
+bool EventJournalFile::Replay(const std::function<bool(RawData&)>& handler, uint64_t& corruptedCnt, bool isOrphan)
+{
+    if (header_ == nullptr) {
+        return true;
+    }
+    size_t capacity = header_->capacity;
+    uint64_t pos = header_->readPos.load(std::memory_order_relaxed);
+    uint64_t writePos = header_->writePos.load(std::memory_order_acquire);
+    RawData rawData;
+    while (pos != writePos) {
+        size_t offset = pos & (capacity - 1);
+        auto record = reinterpret_cast<EventJournalRecord*>(records_ + offset);
+        uint32_t state = record->state.load(std::memory_order_acquire);
+        size_t len = record->len;
+        size_t recordSize = GetRecordSize(len);
+        if (state == RECORD_FREE && !isOrphan) {
+            break; // the record is being appended
+        }
+        if (recordSize > capacity - offset || (state == RECORD_FREE && len == 0)) {
+            // frame of the record is broken, the records after it can't be found any more
+            ++corruptedCnt;
+            pos = writePos;
+            break;
+        }
+        if (state == RECORD_COMMITTED && GetChecksum(reinterpret_cast<uint8_t*>(record + 1), len) == record->checksum) {
+            rawData.Reset();
+            if (rawData.Append(reinterpret_cast<uint8_t*>(record + 1), len) && !handler(rawData)) {
+                return false;
+            }
+        } else if (state != RECORD_PADDING) {
+            ++corruptedCnt; // the record was torn by the crash of its writer
+        }
+        // records consumed are cleared before they are released, so they are free once they are reserved again
+        (void)memset_s(record, recordSize, 0, recordSize);
+        pos += recordSize;
+        header_->readPos.store(pos, std::memory_order_release);
+        writePos = header_->writePos.load(std::memory_order_acquire);
+    }
+    header_->readPos.store(pos, std::memory_order_release);
+    return true;
+}
+
+bool EventJournalFile::IsEmpty() const
+{
+    return header_ == nullptr || header_->readPos.load(std::memory_order_acquire) ==
+        header_->writePos.load(std::memory_order_acquire);
+}
+
+bool EventJournalFile::Map(int fd, size_t size)
+{
+    void* addr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (addr == MAP_FAILED) {
+        return false;
+    }
+    fd_ = fd;
+    size_ = size;
+    header_ = static_cast<EventJournalHeader*>(addr);
+    records_ = static_cast<uint8_t*>(addr) + sizeof(EventJournalHeader);
+    return true;
+}
+
+__attribute__((no_destroy)) EventJournal EventJournal::instance_;
+
+EventJournal& EventJournal::GetInstance()
+{
+    return instance_;
+}
+
+int EventJournal::Enable(const std::string& dir, size_t capacity, SendFunc sendFunc)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (isEnabled_.load(std::memory_order_acquire)) {
+        return SUCCESS;
+    }
+    if (file_ != nullptr || isStopped_.load() || sendFunc == nullptr) {
+        return ERR_DOES_NOT_INIT;
+    }
+    size_t journalCapacity = MIN_CAPACITY;
+    while (journalCapacity < std::min(capacity, MAX_CAPACITY)) {
+        journalCapacity <<= 1;
+    }
+    CollectOrphans(dir);
+    // the name is never reused by the processes restarted later, whose pids may be the same
+    auto startTime = std::chrono::steady_clock::now().time_since_epoch().count();
+    std::string path = dir + "/" + JOURNAL_PREFIX + std::to_string(getpid()) + "_" + std::to_string(startTime) +
+        JOURNAL_SUFFIX;
+    auto file = new(std::nothrow) EventJournalFile();
+    if (file == nullptr || !file->Create(path, journalCapacity)) {
+        delete file;
+        return ERR_DOES_NOT_INIT;
+    }
+    static int ret = [] {
+        (void)pthread_atfork(nullptr, nullptr, ResetAfterFork);
+        return atexit(StopOnExit);
+    }();
+    if (ret != 0) {
+        HILOG_WARN(LOG_CORE, "failed to register the stop hook on exit, ret=%{public}d", ret);
+    }
+    file_ = file;
+    path_ = path;
+    sendFunc_ = sendFunc;
+    isDrainerRunning_.store(true);
+    std::thread drainer(&EventJournal::Run, this);
+    drainer.detach();
+    isEnabled_.store(true, std::memory_order_release);
+    return SUCCESS;
+}
+
+bool EventJournal::IsEnabled() const
+{
+    return isEnabled_.load(std::memory_order_acquire);
+}
+
+int EventJournal::Append(const RawData& rawData)
+{
+    if (!isEnabled_.load(std::memory_order_acquire)) {
+        return ERR_DOES_NOT_INIT;
+    }
+    int ret = file_->Append(rawData);
+    if (ret != SUCCESS) {
+        droppedCnt_.fetch_add(1, std::memory_order_relaxed);
+        return ret;
+    }
+    appendedCnt_.fetch_add(1, std::memory_order_relaxed);
+    NotifyDrainer();
+    return SUCCESS;
+}
+
+EventJournalStats EventJournal::GetStats() const
+{
+    EventJournalStats stats;
+    stats.appendedCnt = appendedCnt_.load(std::memory_order_relaxed);
+    stats.replayedCnt = replayedCnt_.load(std::memory_order_relaxed);
+    stats.droppedCnt = droppedCnt_.load(std::memory_order_relaxed);
+    stats.corruptedCnt = corruptedCnt_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void EventJournal::StopOnExit()
+{
+    instance_.Stop();
+}
+
+void EventJournal::ResetAfterFork()
+{
+    // the journal of the parent process is left to it, the child process enables its own one if it needs
+    new (&instance_.mutex_) std::mutex();
+    new (&instance_.drainerCond_) std::condition_variable();
+    instance_.isEnabled_.store(false);
+    instance_.isDrainerRunning_.store(false);
+    instance_.isDrainerIdle_.store(false);
+    instance_.appendedCnt_.store(0);
+    instance_.replayedCnt_.store(0);
+    instance_.droppedCnt_.store(0);
+    instance_.corruptedCnt_.store(0);
+    delete instance_.file_;
+    instance_.file_ = nullptr;
+    instance_.path_.clear();
+    instance_.orphanPaths_.clear();
+}
+
+void EventJournal::CollectOrphans(const std::string& dir)
+{
+    // journals left by processes exited are replayed by this one, those still locked are skipped in replaying
+    DIR* dirp = opendir(dir.c_str());
+    if (dirp == nullptr) {
+        return;
+    }
+    while (struct dirent* entry = readdir(dirp)) {
+        if (orphanPaths_.size() >= MAX_ORPHAN_CNT) {
+            break;
+        }
+        if (IsJournalName(entry->d_name)) {
+            orphanPaths_.emplace_back(dir + "/" + entry->d_name);
+        }
+    }
+    closedir(dirp);
+}
+
+void EventJournal::NotifyDrainer()
+{
+    // pairs with the idle flag set by the drainer before it checks the journal again
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (isDrainerIdle_.load() && isDrainerIdle_.exchange(false)) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        drainerCond_.notify_one();
+    }
+}
+
+bool EventJournal::ReplayOrphans()
+{
+    while (!orphanPaths_.empty()) {
+        EventJournalFile orphan;
+        if (orphan.Open(orphanPaths_.back())) {
+            uint64_t corruptedCnt = 0;
+            bool isReplayed = orphan.Replay([this] (RawData& rawData) {
+                if (!sendFunc_(rawData)) {
+                    return false;
+                }
+                replayedCnt_.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }, corruptedCnt, true);
+            corruptedCnt_.fetch_add(corruptedCnt, std::memory_order_relaxed);
+            if (!isReplayed) {
+                return false;
+            }
+            // the file is removed while it's still locked, so it's never replayed twice
+            unlink(orphanPaths_.back().c_str());
+        }
+        orphanPaths_.pop_back();
+    }
+    return true;
+}
+
+void EventJournal::Run()
+{
+    pthread_setname_np(pthread_self(), DRAINER_NAME);
+    int retryInterval = MIN_RETRY_INTERVAL;
+    while (!isStopped_.load()) {
+        uint64_t corruptedCnt = 0;
+        bool isReplayed = ReplayOrphans() && file_->Replay([this] (RawData& rawData) {
+            if (!sendFunc_(rawData)) {
+                return false;
+            }
+            replayedCnt_.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }, corruptedCnt, false);
+        corruptedCnt_.fetch_add(corruptedCnt, std::memory_order_relaxed);
+        if (!isReplayed) {
+            // the server is still unavailable, the records are kept until it's back
+            WaitForRetry(retryInterval);
+            continue;
+        }
+        retryInterval = MIN_RETRY_INTERVAL;
+        std::unique_lock<std::mutex> lock(mutex_);
+        isDrainerIdle_.store(true);
+        drainerCond_.wait_for(lock, std::chrono::milliseconds(IDLE_WAIT_TIME), [this] {
+            return isStopped_.load() || !file_->IsEmpty();
+        });
+        isDrainerIdle_.store(false);
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    isDrainerRunning_.store(false);
+    drainerCond_.notify_all();
+}
+
+void EventJournal::Stop()
+{
+    // records left are kept in the file, which are replayed by the processes started later
+    std::unique_lock<std::mutex> lock(mutex_);
+    isEnabled_.store(false, std::memory_order_release);
+    isStopped_.store(true);
+    drainerCond_.notify_all();
+    bool isDrainerStopped = drainerCond_.wait_for(lock, std::chrono::milliseconds(MAX_EXIT_WAIT_TIME), [this] {
+        return !isDrainerRunning_.load();
+    });
+    // journal drained completely is removed, so it's not left to be scanned by the processes started later
+    if (isDrainerStopped && file_ != nullptr && file_->IsEmpty()) {
+        unlink(path_.c_str());
+    }
+}
+
+void EventJournal::WaitForRetry(int& retryInterval)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    drainerCond_.wait_for(lock, std::chrono::milliseconds(retryInterval), [this] {
+        return isStopped_.load();
+    });
+    retryInterval = std::min(retryInterval * 2, MAX_RETRY_INTERVAL); // 2: the interval is doubled on each failure
+}
+} // namespace HiviewDFX
+} // namespace OHOS
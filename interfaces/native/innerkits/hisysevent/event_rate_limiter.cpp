@@ -0,0 +1,331 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "event_rate_limiter.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <new>
+#include <pthread.h>
+#include <sstream>
+#include <sys/stat.h>
+#include <thread>
+
+#include "event_route_table.h"
+#include "hilog/log.h"
+#include "hisysevent.h"
+
+#undef LOG_DOMAIN
+#define LOG_DOMAIN 0xD002D08
+
+#undef LOG_TAG
+#define LOG_TAG "EVENT_RATE_LIMITER"
+
+namespace OHOS {
+namespace HiviewDFX {
+namespace {
+constexpr char RATE_LIMIT_CONFIG_PATH[] = "/system/etc/hiview/hisysevent_rate_limit.conf";
+constexpr char RELOADER_NAME[] = "HiSysEventLimit";
+constexpr char COMMENT_PREFIX = '#';
+constexpr uint64_t FNV_OFFSET_BASIS = 0xCBF29CE484222325ULL;
+constexpr uint64_t FNV_PRIME = 0x100000001B3ULL;
+constexpr uint64_t MIX_MULTIPLIER = 0xFF51AFD7ED558CCDULL;
+constexpr unsigned int MIX_SHIFT = 33;
+constexpr double NS_PER_SECOND = 1000000000.0;
+constexpr double MIN_RATE = 1.0 / 3600; // 1 event per hour, so the tolerance of the max burst never overflows
+constexpr uint64_t MAX_BURST = 1000000;
+
+inline bool IsValidType(int type)
+{
+    return type >= HiSysEvent::EventType::FAULT && type <= HiSysEvent::EventType::BEHAVIOR;
+}
+
+inline std::string_view GetHeaderField(const char* field, size_t maxLen)
+{
+    return std::string_view(field, strnlen(field, maxLen));
+}
+}
+
+bool RateLimitTable::AddPolicy(std::string_view domain, std::string_view name, double rate, uint64_t burst,
+    uint8_t exemptTypeMask)
+{
+    if (domain.empty() || domain.size() > MAX_DOMAIN_LENGTH || name.empty() || name.size() > MAX_EVENT_NAME_LENGTH ||
+        !std::isfinite(rate) || rate < 0 || (rate > 0 && (rate < MIN_RATE || burst == 0)) || burst > MAX_BURST) {
+        return false;
+    }
+    uint64_t domainHash = Hash(FNV_OFFSET_BASIS, domain);
+    uint64_t hash = Hash(domainHash, name);
+    RateLimitPolicy* policy = Find(domainHash, domain, name);
+    if (policy == nullptr) {
+        // policies of different names sharing one hash are never expected, the latter is refused if so
+        if (index_.find(hash) != index_.end()) {
+            return false;
+        }
+        policies_.emplace_back(std::make_unique<RateLimitPolicy>());
+        policy = policies_.back().get();
+        policy->domain = domain;
+        policy->name = name;
+        index_.emplace(hash, policy);
+        domainHashes_.emplace(domainHash);
+    }
+    // policy added again replaces the old one, events over 1 per nanosecond are never limited by the rate
+    policy->interval = (rate > 0) ? std::max<uint64_t>(std::llround(NS_PER_SECOND / rate), 1) : 0;
+    policy->burstTolerance = (burst > 0) ? (burst - 1) * policy->interval : 0;
+    policy->exemptTypeMask = exemptTypeMask & ALL_EVENT_TYPES;
+    return true;
+}
+
+bool RateLimitTable::LoadConfig(const std::string& configPath)
+{
+    std::ifstream file(configPath);
+    if (!file.is_open()) {
+        HILOG_DEBUG(LOG_CORE, "no rate limit config");
+        return false;
+    }
+    std::string line;
+    size_t lineNo = 0;
+    while (std::getline(file, line)) {
+        ++lineNo;
+        std::istringstream fields(line);
+        std::string domain;
+        if (!(fields >> domain) || domain.front() == COMMENT_PREFIX) {
+            continue;
+        }
+        std::string name;
+        double rate = 0;
+        uint64_t burst = 0;
+        uint8_t exemptTypeMask = 0;
+        std::string typeName;
+        bool isValid = static_cast<bool>(fields >> name >> rate >> burst);
+        while (isValid && (fields >> typeName)) {
+            isValid = ParseEventTypeMask(typeName, exemptTypeMask);
+        }
+        if (!isValid || !AddPolicy(domain, name, rate, burst, exemptTypeMask)) {
+            HILOG_WARN(LOG_CORE, "invalid rate limit policy at line %{public}zu", lineNo);
+            return false;
+        }
+    }
+    return true;
+}
+
+RateLimitPolicy* RateLimitTable::Find(std::string_view domain, std::string_view name) const
+{
+    uint64_t domainHash = Hash(FNV_OFFSET_BASIS, domain);
+    if (domainHashes_.find(domainHash) == domainHashes_.end()) {
+        return nullptr;
+    }
+    RateLimitPolicy* policy = Find(domainHash, domain, name);
+    return (policy != nullptr) ? policy : Find(domainHash, domain, ANY_EVENT_NAME);
+}
+
+RateLimitPolicy* RateLimitTable::Find(uint64_t domainHash, std::string_view domain, std::string_view name) const
+{
+    auto iter = index_.find(Hash(domainHash, name));
+    if (iter == index_.end() || iter->second->domain != domain || iter->second->name != name) {
+        return nullptr;
+    }
+    return iter->second;
+}
+
+size_t RateLimitTable::GetPolicyCnt() const
+{
+    return policies_.size();
+}
+
+void RateLimitTable::InheritBuckets(const RateLimitTable& oldTable)
+{
+    for (auto& policy : policies_) {
+        RateLimitPolicy* oldPolicy = oldTable.Find(Hash(FNV_OFFSET_BASIS, policy->domain), policy->domain,
+            policy->name);
+        if (oldPolicy != nullptr && oldPolicy->interval == policy->interval &&
+            oldPolicy->burstTolerance == policy->burstTolerance) {
+            policy->theoreticalArrivalTime.store(oldPolicy->theoreticalArrivalTime.load(std::memory_order_relaxed),
+                std::memory_order_relaxed);
+        }
+    }
+}
+
+uint64_t RateLimitTable::Hash(uint64_t seed, std::string_view str)
+{
+    // hash of the domain is the seed of the names in it, the length keeps "AB"+"C" apart from "A"+"BC"
+    uint64_t hash = (seed ^ str.size()) * FNV_PRIME;
+    for (char ch : str) {
+        hash = (hash ^ static_cast<uint8_t>(ch)) * FNV_PRIME;
+    }
+    hash ^= hash >> MIX_SHIFT;
+    hash *= MIX_MULTIPLIER;
+    return hash ^ (hash >> MIX_SHIFT);
+}
+
+EventRateLimiter::EventRateLimiter(const std::string& configPath) : configPath_(configPath)
+{}
+
+EventRateLimiter::~EventRateLimiter()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    isStopped_ = true;
+    reloaderCond_.notify_all();
+    reloaderCond_.wait(lock, [this] {
+        return !isReloaderRunning_;
+    });
+}
+
+EventRateLimiter& EventRateLimiter::GetInstance()
+{
+    // limiter is never destroyed, for the policies are still looked up by the events wrote on exit
+    __attribute__((no_destroy)) static EventRateLimiter limiter(RATE_LIMIT_CONFIG_PATH);
+    static int ret = pthread_atfork(nullptr, nullptr, [] {
+        GetInstance().ResetAfterFork();
+    });
+    (void)ret;
+    return limiter;
+}
+
+bool EventRateLimiter::IsAllowed(const HiSysEventHeader& header)
+{
+    // the writer never loads the config, which is left to the reloader started by the first event
+    if (!isReloaderStarted_.load(std::memory_order_relaxed) && !isReloaderStarted_.exchange(true)) {
+        StartReloader();
+    }
+    if (table_.load(std::memory_order_acquire) == nullptr) {
+        return true;
+    }
+    return IsAllowed(GetHeaderField(header.domain, MAX_DOMAIN_LENGTH),
+        GetHeaderField(header.name, MAX_EVENT_NAME_LENGTH), header.type + 1);
+}
+
+bool EventRateLimiter::IsAllowed(std::string_view domain, std::string_view name, int type)
+{
+    const RateLimitTable* table = table_.load(std::memory_order_acquire);
+    if (table == nullptr) {
+        return true;
+    }
+    RateLimitPolicy* policy = table->Find(domain, name);
+    if (policy == nullptr || (IsValidType(type) && (policy->exemptTypeMask & GetEventTypeMask(type)) != 0)) {
+        return true;
+    }
+    if (policy->interval == 0) {
+        return false;
+    }
+    // one token is taken by pushing the time of the bucket being full by the interval, unless it's beyond the burst
+    uint64_t now = GetCurrentTimeNanos();
+    uint64_t arrivalTime = policy->theoreticalArrivalTime.load(std::memory_order_relaxed);
+    uint64_t newArrivalTime = 0;
+    do {
+        uint64_t baseTime = std::max(arrivalTime, now);
+        if (baseTime - now > policy->burstTolerance) {
+            return false;
+        }
+        newArrivalTime = baseTime + policy->interval;
+    } while (!policy->theoreticalArrivalTime.compare_exchange_weak(arrivalTime, newArrivalTime,
+        std::memory_order_relaxed));
+    return true;
+}
+
+bool EventRateLimiter::Reload()
+{
+    std::lock_guard<std::mutex> lock(reloadMutex_);
+    std::string configId;
+    struct stat configStat {};
+    if (stat(configPath_.c_str(), &configStat) == 0) {
+        configId = std::to_string(configStat.st_dev) + "_" + std::to_string(configStat.st_ino) + "_" +
+            std::to_string(configStat.st_size) + "_" + std::to_string(configStat.st_mtim.tv_sec) + "_" +
+            std::to_string(configStat.st_mtim.tv_nsec);
+    }
+    if (configId == configId_) {
+        return false;
+    }
+    configId_ = configId;
+    std::unique_ptr<RateLimitTable> table;
+    if (!configId.empty()) {
+        table = std::make_unique<RateLimitTable>();
+        // policies loaded before are kept if the config is invalid
+        if (!table->LoadConfig(configPath_)) {
+            return false;
+        }
+    }
+    if (table == nullptr && currentTable_ == nullptr) {
+        return false;
+    }
+    HILOG_INFO(LOG_CORE, "%{public}zu rate limit policies are loaded", (table == nullptr) ? 0 : table->GetPolicyCnt());
+    if (table != nullptr && currentTable_ != nullptr) {
+        table->InheritBuckets(*currentTable_);
+    }
+    table_.store(table.get(), std::memory_order_release);
+    uint64_t now = GetCurrentTimeNanos();
+    retiredTables_.erase(std::remove_if(retiredTables_.begin(), retiredTables_.end(), [now] (const auto& retired) {
+        return now - retired.retiredTime >= RETIRED_TABLE_GRACE_PERIOD;
+    }), retiredTables_.end());
+    if (currentTable_ != nullptr) {
+        retiredTables_.push_back({ std::move(currentTable_), now });
+    }
+    currentTable_ = std::move(table);
+    return true;
+}
+
+size_t EventRateLimiter::GetPolicyCnt() const
+{
+    const RateLimitTable* table = table_.load(std::memory_order_acquire);
+    return (table == nullptr) ? 0 : table->GetPolicyCnt();
+}
+
+void EventRateLimiter::StartReloader()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (isStopped_) {
+        return;
+    }
+    isReloaderRunning_ = true;
+    std::thread reloader(&EventRateLimiter::RunReloader, this);
+    reloader.detach();
+}
+
+void EventRateLimiter::RunReloader()
+{
+    pthread_setname_np(pthread_self(), RELOADER_NAME);
+    std::unique_lock<std::mutex> lock(mutex_);
+    do {
+        lock.unlock();
+        (void)Reload();
+        lock.lock();
+    } while (!reloaderCond_.wait_for(lock, std::chrono::milliseconds(RELOAD_CHECK_INTERVAL), [this] {
+        return isStopped_;
+    }));
+    isReloaderRunning_ = false;
+    reloaderCond_.notify_all();
+}
+
+void EventRateLimiter::ResetAfterFork()
+{
+    // the reloader of the parent process is gone in the child process, which starts its own one
+    new (&reloadMutex_) std::mutex();
+    new (&mutex_) std::mutex();
+    new (&reloaderCond_) std::condition_variable();
+    isReloaderRunning_ = false;
+    isReloaderStarted_.store(false);
+}
+
+uint64_t EventRateLimiter::GetCurrentTimeNanos()
+{
+    struct timespec ts {};
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * static_cast<uint64_t>(NS_PER_SECOND) + static_cast<uint64_t>(ts.tv_nsec);
+}
+} // namespace HiviewDFX
+} // namespace OHOS
@@ -0,0 +1,255 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "event_route_table.h"
+
+#include <algorithm>
+#include <climits>
+#include <fstream>
+#include <securec.h>
+#include <sstream>
+#include <utility>
+
+#include "hilog/log.h"
+#include "hisysevent.h"
+
+#undef LOG_DOMAIN
+#define LOG_DOMAIN 0xD002D08
+
+#undef LOG_TAG
+#define LOG_TAG "EVENT_ROUTE_TABLE"
+
+namespace OHOS {
+namespace HiviewDFX {
+namespace {
+constexpr uint64_t HASH_SEED = 0;
+constexpr uint64_t HASH_MULTIPLIER = 0x9E3779B97F4A7C15ULL; // 2^64 / golden ratio
+constexpr unsigned int TAIL_ROTATION = 29;
+constexpr unsigned int HASH_SHIFT = 32;
+constexpr size_t SLOT_CNT_OF_RULE = 2; // load factor of the slots is kept under 0.5
+constexpr char COMMENT_PREFIX = '#';
+
+struct BuiltinRule {
+    const char* domain;
+    const char* name;
+    uint8_t typeMask;
+};
+
+constexpr BuiltinRule BUILTIN_RULES[] = {
+    { "AAFWK", "APP_INPUT_BLOCK", ALL_EVENT_TYPES },
+    { "AAFWK", "BUSSINESS_THREAD_BLOCK_3S", ALL_EVENT_TYPES },
+    { "AAFWK", "BUSSINESS_THREAD_BLOCK_6S", ALL_EVENT_TYPES },
+    { "AAFWK", "LIFECYCLE_HALF_TIMEOUT", ALL_EVENT_TYPES },
+    { "AAFWK", "LIFECYCLE_TIMEOUT", ALL_EVENT_TYPES },
+    { "AAFWK", "THREAD_BLOCK_3S", ALL_EVENT_TYPES },
+    { "AAFWK", "THREAD_BLOCK_6S", ALL_EVENT_TYPES },
+    { "ACE", "UI_BLOCK_3S", ALL_EVENT_TYPES },
+    { "ACE", "UI_BLOCK_6S", ALL_EVENT_TYPES },
+    { "ACE", "UI_BLOCK_RECOVERED", ALL_EVENT_TYPES },
+    { "FRAMEWORK", "IPC_FULL", ALL_EVENT_TYPES },
+    { "FRAMEWORK", "IPC_FULL_WARNING", ALL_EVENT_TYPES },
+    { "FRAMEWORK", "SERVICE_BLOCK", ALL_EVENT_TYPES },
+    { "FRAMEWORK", "SERVICE_TIMEOUT", ALL_EVENT_TYPES },
+    { "FRAMEWORK", "SERVICE_WARNING", ALL_EVENT_TYPES },
+    { "RELIABILITY", ANY_EVENT_NAME, GetEventTypeMask(HiSysEvent::EventType::FAULT) },
+    { "GRAPHIC", "NO_DRAW", ALL_EVENT_TYPES },
+    { "MULTIMODALINPUT", "TARGET_POINTER_EVENT_FAILURE", ALL_EVENT_TYPES },
+    { "POWER", "SCREEN_ON_TIMEOUT", ALL_EVENT_TYPES },
+    { "WINDOWMANAGER", "NO_FOCUS_WINDOW", ALL_EVENT_TYPES },
+    { "SCHEDULE_EXT", "SYSTEM_LOAD_LEVEL_CHANGED", ALL_EVENT_TYPES },
+};
+}
+
+bool ParseEventTypeMask(const std::string& typeName, uint8_t& typeMask)
+{
+    static const std::pair<const char*, int> types[] = {
+        { "FAULT", HiSysEvent::EventType::FAULT },
+        { "STATISTIC", HiSysEvent::EventType::STATISTIC },
+        { "SECURITY", HiSysEvent::EventType::SECURITY },
+        { "BEHAVIOR", HiSysEvent::EventType::BEHAVIOR },
+    };
+    for (const auto& type : types) {
+        if (typeName == type.first) {
+            typeMask |= GetEventTypeMask(type.second);
+            return true;
+        }
+    }
+    return false;
+}
+
+EventRouteTable EventRouteTable::Load(const std::string& configPath)
+{
+    EventRouteTable table;
+    if (!table.LoadConfig(configPath)) {
+        table = EventRouteTable();
+        table.AddBuiltinRules();
+    }
+    return table;
+}
+
+bool EventRouteTable::AddRule(std::string_view domain, std::string_view name, uint8_t typeMask)
+{
+    if (domain.empty() || domain.size() > MAX_DOMAIN_LENGTH || name.empty() || name.size() > MAX_EVENT_NAME_LENGTH ||
+        (typeMask & ALL_EVENT_TYPES) == 0) {
+        return false;
+    }
+    // rule added again replaces the old one
+    auto rule = const_cast<EventRouteRule*>(Find(domain, name));
+    if (rule != nullptr) {
+        rule->typeMask = typeMask & ALL_EVENT_TYPES;
+        return true;
+    }
+    EventRouteRule newRule;
+    if (memcpy_s(newRule.domain, sizeof(newRule.domain), domain.data(), domain.size()) != EOK ||
+        memcpy_s(newRule.name, sizeof(newRule.name), name.data(), name.size()) != EOK) {
+        return false;
+    }
+    newRule.domainLen = static_cast<uint8_t>(domain.size());
+    newRule.nameLen = static_cast<uint8_t>(name.size());
+    newRule.typeMask = typeMask & ALL_EVENT_TYPES;
+    newRule.hash = Hash(Hash(HASH_SEED, domain), name);
+    rules_.emplace_back(newRule);
+    ++ruleCnt_;
+    // rule with empty name marks the domain, so events of other domains are told apart by one probe
+    if (Find(domain, "") == nullptr) {
+        EventRouteRule domainRule = newRule;
+        (void)memset_s(domainRule.name, sizeof(domainRule.name), 0, sizeof(domainRule.name));
+        domainRule.nameLen = 0;
+        domainRule.typeMask = 0;
+        domainRule.hash = Hash(Hash(HASH_SEED, domain), "");
+        rules_.emplace_back(domainRule);
+    }
+    Rehash();
+    return true;
+}
+
+void EventRouteTable::AddBuiltinRules()
+{
+    for (const auto& rule : BUILTIN_RULES) {
+        (void)AddRule(rule.domain, rule.name, rule.typeMask);
+    }
+}
+
+bool EventRouteTable::LoadConfig(const std::string& configPath)
+{
+    // each line is "DOMAIN NAME [TYPE ...]", events of all types are matched if no type is given
+    std::ifstream file(configPath);
+    if (!file.is_open()) {
+        HILOG_DEBUG(LOG_CORE, "no route config, builtin rules are used");
+        return false;
+    }
+    std::string line;
+    size_t lineNo = 0;
+    while (std::getline(file, line)) {
+        ++lineNo;
+        std::istringstream fields(line);
+        std::string domain;
+        std::string name;
+        if (!(fields >> domain) || domain.front() == COMMENT_PREFIX) {
+            continue;
+        }
+        uint8_t typeMask = 0;
+        std::string typeName;
+        bool isValid = static_cast<bool>(fields >> name);
+        while (isValid && (fields >> typeName)) {
+            isValid = ParseEventTypeMask(typeName, typeMask);
+        }
+        if (!isValid || !AddRule(domain, name, (typeMask == 0) ? ALL_EVENT_TYPES : typeMask)) {
+            HILOG_WARN(LOG_CORE, "invalid rule at line %{public}zu", lineNo);
+            return false;
+        }
+    }
+    return true;
+}
+
+bool EventRouteTable::IsHigherPriority(std::string_view domain, std::string_view name, int type) const
+{
+    if (type < HiSysEvent::EventType::FAULT || type > HiSysEvent::EventType::BEHAVIOR) {
+        return false;
+    }
+    uint64_t domainHash = Hash(HASH_SEED, domain);
+    if (Find(domainHash, domain, "") == nullptr) {
+        return false;
+    }
+    const EventRouteRule* rule = Find(domainHash, domain, name);
+    if (rule == nullptr) {
+        rule = Find(domainHash, domain, ANY_EVENT_NAME);
+    }
+    return rule != nullptr && (rule->typeMask & GetEventTypeMask(type)) != 0;
+}
+
+size_t EventRouteTable::GetRuleCnt() const
+{
+    return ruleCnt_;
+}
+
+uint64_t EventRouteTable::Hash(uint64_t seed, std::string_view str)
+{
+    // names are told apart by their heads, lengths and tails mostly, the rest is compared once the slot is probed
+    uint64_t head = 0;
+    uint64_t tail = 0;
+    size_t len = std::min(str.size(), sizeof(head));
+    size_t tailPos = str.size() - len;
+    for (size_t i = 0; i < len; ++i) {
+        head |= static_cast<uint64_t>(static_cast<uint8_t>(str[i])) << (i * CHAR_BIT);
+        tail |= static_cast<uint64_t>(static_cast<uint8_t>(str[tailPos + i])) << (i * CHAR_BIT);
+    }
+    uint64_t hash = (seed ^ head ^ ((tail << TAIL_ROTATION) | (tail >> (sizeof(tail) * CHAR_BIT - TAIL_ROTATION))) ^
+        str.size()) * HASH_MULTIPLIER;
+    return hash ^ (hash >> HASH_SHIFT);
+}
+
+const EventRouteRule* EventRouteTable::Find(std::string_view domain, std::string_view name) const
+{
+    return Find(Hash(HASH_SEED, domain), domain, name);
+}
+
+const EventRouteRule* EventRouteTable::Find(uint64_t domainHash, std::string_view domain,
+    std::string_view name) const
+{
+    if (slots_.empty()) {
+        return nullptr;
+    }
+    // hash of the domain is shared by the probes of the names in it
+    uint64_t hash = Hash(domainHash, name);
+    size_t mask = slots_.size() - 1;
+    for (size_t pos = hash & mask; slots_[pos] >= 0; pos = (pos + 1) & mask) {
+        const auto& rule = rules_[slots_[pos]];
+        if (rule.hash == hash && std::string_view(rule.domain, rule.domainLen) == domain &&
+            std::string_view(rule.name, rule.nameLen) == name) {
+            return &rule;
+        }
+    }
+    return nullptr;
+}
+
+void EventRouteTable::Rehash()
+{
+    size_t slotCnt = 1;
+    while (slotCnt < rules_.size() * SLOT_CNT_OF_RULE) {
+        slotCnt <<= 1;
+    }
+    slots_.assign(slotCnt, -1);
+    size_t mask = slotCnt - 1;
+    for (size_t i = 0; i < rules_.size(); ++i) {
+        size_t pos = rules_[i].hash & mask;
+        while (slots_[pos] >= 0) {
+            pos = (pos + 1) & mask;
+        }
+        slots_[pos] = static_cast<int32_t>(i);
+    }
+}
+} // namespace HiviewDFX
+} // namespace OHOS
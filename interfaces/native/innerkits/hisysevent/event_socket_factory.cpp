@@ -16,13 +16,12 @@
 #include "event_socket_factory.h"
 
 #include "def.h"
-#include "hisysevent.h"
+#include "event_route_table.h"
 #include "hilog/log.h"
 #include "raw_data_base_def.h"
 
-#include <algorithm>
-#include <list>
-#include <string>
+#include <cstring>
+#include <string_view>
 
 #undef LOG_DOMAIN
 #define LOG_DOMAIN 0xD002D08
@@ -43,80 +42,55 @@ struct sockaddr_un higherPriorityAddr = {
     .sun_path = "/dev/unix/socket/hisysevent_fast",
 };
 
-inline bool IsHigherPriorityEventName(const std::list<std::string>& events, const std::string& name)
+struct sockaddr_un sharedMemoryRingAddr = {
+    .sun_family = AF_UNIX,
+    .sun_path = "/dev/unix/socket/hisysevent_ring",
+};
+
+constexpr char ROUTE_CONFIG_PATH[] = "/system/etc/hiview/hisysevent_priority.conf";
+
+// table is never destroyed, for it is still used by the async writer flushing events on exit
+const EventRouteTable& GetRouteTable()
 {
-    auto iter = std::find(events.begin(), events.end(), name);
-    return iter != events.end();
+    __attribute__((no_destroy)) static const EventRouteTable table = EventRouteTable::Load(ROUTE_CONFIG_PATH);
+    return table;
 }
 
-bool IsHigherPriorityAafwkEvent(const std::string& name)
+inline std::string_view GetHeaderField(const char* field, size_t maxLen)
 {
-    static std::list<std::string> events {
-        "APP_INPUT_BLOCK", "BUSSINESS_THREAD_BLOCK_3S", "BUSSINESS_THREAD_BLOCK_6S",
-        "LIFECYCLE_HALF_TIMEOUT", "LIFECYCLE_TIMEOUT", "THREAD_BLOCK_3S", "THREAD_BLOCK_6S" };
-    return IsHigherPriorityEventName(events, name);
+    return std::string_view(field, strnlen(field, maxLen));
+}
 }
 
-bool IsHigerPriorityAceEvent(const std::string& name)
+EventSocket& EventSocketFactory::GetEventSocket(RawData& data)
 {
-    static std::list<std::string> events {
-        "UI_BLOCK_3S", "UI_BLOCK_6S", "UI_BLOCK_RECOVERED" };
-    return IsHigherPriorityEventName(events, name);
+    return IsHigherPriorityEvent(data) ? higherPriorityAddr : normalAddr;
 }
 
-bool IsHigerPriorityFrameworkEvent(const std::string& name)
+EventSocket& EventSocketFactory::GetSharedMemoryRingSocket()
 {
-    static std::list<std::string> events {
-        "IPC_FULL", "IPC_FULL_WARNING", "SERVICE_BLOCK", "SERVICE_TIMEOUT", "SERVICE_WARNING" };
-    return IsHigherPriorityEventName(events, name);
+    return sharedMemoryRingAddr;
 }
 
-bool IsHigherPriorityEvent(const std::string& domain, const std::string& name, int type)
+EventSocket& EventSocketFactory::GetEventSocket(const HiSysEventHeader& header)
 {
-    if (domain == "AAFWK") {
-        return IsHigherPriorityAafwkEvent(name);
-    } else if (domain == "ACE") {
-        return IsHigerPriorityAceEvent(name);
-    } else if (domain == "FRAMEWORK") {
-        return IsHigerPriorityFrameworkEvent(name);
-    } else if (domain == "RELIABILITY") {
-        return type == HiSysEvent::EventType::FAULT;
-    } else if (domain == "GRAPHIC") {
-        return name == "NO_DRAW";
-    } else if (domain == "MULTIMODALINPUT") {
-        return name == "TARGET_POINTER_EVENT_FAILURE";
-    } else if (domain == "POWER") {
-        return name == "SCREEN_ON_TIMEOUT";
-    } else if (domain == "WINDOWMANAGER") {
-        return name == "NO_FOCUS_WINDOW";
-    } else if (domain == "SCHEDULE_EXT") {
-        return name == "SYSTEM_LOAD_LEVEL_CHANGED";
-    } else {
-        return false;
-    }
+    return IsHigherPriorityEvent(header) ? higherPriorityAddr : normalAddr;
 }
 
-void ParseEventInfo(RawData& data, std::string& domain, std::string& name, int& type)
+bool EventSocketFactory::IsHigherPriorityEvent(RawData& data)
 {
     if (size_t len = data.GetDataLength(); len < sizeof(int32_t) + sizeof(struct HiSysEventHeader)) {
         HILOG_WARN(LOG_CORE, "length[%{public}zu] of data is invalid", len);
-        return;
+        return false;
     }
-    auto originalData = data.GetData();
-    struct HiSysEventHeader header = *(reinterpret_cast<struct HiSysEventHeader*>(originalData + sizeof(int32_t)));
-    domain = std::string(header.domain);
-    name = std::string(header.name);
-    type = static_cast<int>(header.type) + 1; // transform type to HiSysEvent::EventType
-}
+    return IsHigherPriorityEvent(*reinterpret_cast<struct HiSysEventHeader*>(data.GetData() + sizeof(int32_t)));
 }
 
-EventSocket& EventSocketFactory::GetEventSocket(RawData& data)
+bool EventSocketFactory::IsHigherPriorityEvent(const HiSysEventHeader& header)
 {
-    std::string domain;
-    std::string name;
-    int type = HiSysEvent::EventType::FAULT;
-    ParseEventInfo(data, domain, name, type);
-    return IsHigherPriorityEvent(domain, name, type) ? higherPriorityAddr : normalAddr;
+    int type = static_cast<int>(header.type) + 1; // transform type to HiSysEvent::EventType
+    return GetRouteTable().IsHigherPriority(GetHeaderField(header.domain, MAX_DOMAIN_LENGTH + 1),
+        GetHeaderField(header.name, MAX_EVENT_NAME_LENGTH + 1), type);
 }
 }
 }
@@ -15,6 +15,7 @@
 
 #include "hisysevent.h"
 
+#include <algorithm>
 #include <cctype>
 #include <chrono>
 #include <ctime>
@@ -22,7 +23,11 @@
 #include <sys/time.h>
 #include <unistd.h>
 
+#include "async_writer.h"
+#include "base_info_cache.h"
 #include "def.h"
+#include "event_rate_limiter.h"
+#include "event_socket_factory.h"
 #include "hilog/log.h"
 #ifdef HIVIEWDFX_HITRACE_ENABLED
 #include "hitrace/trace.h"
@@ -38,6 +43,123 @@
 
 namespace OHOS {
 namespace HiviewDFX {
+namespace {
+// raw data with capacity over this size won't be kept for reusing after the event is wrote
+constexpr size_t MAX_REUSED_RAW_DATA_CAPACITY = 16 * 1024;
+
+thread_local std::shared_ptr<RawData> g_reusedRawData = nullptr;
+
+std::shared_ptr<RawData> AcquireRawData()
+{
+    if (g_reusedRawData == nullptr) {
+        g_reusedRawData = std::make_shared<RawData>();
+        return g_reusedRawData;
+    }
+    if (g_reusedRawData.use_count() > 1) {
+        // raw data of this thread is still used by another event, no reusing
+        return std::make_shared<RawData>();
+    }
+    g_reusedRawData->Reset();
+    return g_reusedRawData;
+}
+
+void RecycleRawData(std::shared_ptr<RawData>& rawData)
+{
+    if (rawData == nullptr || rawData != g_reusedRawData) {
+        return;
+    }
+    rawData = nullptr;
+    if (g_reusedRawData.use_count() == 1 && g_reusedRawData->GetCapacity() > MAX_REUSED_RAW_DATA_CAPACITY) {
+        g_reusedRawData = nullptr;
+    }
+}
+
+template<typename Encoder, typename T>
+size_t GetEncodedArrayParamValueSize(const HiSysEventParam& param)
+{
+    auto array = reinterpret_cast<const T*>(param.v.array);
+    if (array == nullptr) {
+        return 0;
+    }
+    auto value = Encoded::ArrayView<T>(array, param.arraySize).Truncate(MAX_ARRAY_SIZE);
+    if constexpr (std::is_same_v<T, char*>) {
+        for (auto item : value) {
+            if (item == nullptr) {
+                return 0;
+            }
+        }
+    }
+    return Encoder::GetEncodedValueSize(value);
+}
+
+// size of the encoded value, 0 means the param is invalid and will be discarded
+size_t GetEncodedParamValueSize(const HiSysEventParam& param)
+{
+    switch (param.t) {
+        case HISYSEVENT_BOOL:
+            return Encoded::SignedVarintParamEncoder<bool>::GetEncodedValueSize(param.v.b);
+        case HISYSEVENT_INT8:
+            return Encoded::SignedVarintParamEncoder<int8_t>::GetEncodedValueSize(param.v.i8);
+        case HISYSEVENT_UINT8:
+            return Encoded::UnsignedVarintParamEncoder<uint8_t>::GetEncodedValueSize(param.v.ui8);
+        case HISYSEVENT_INT16:
+            return Encoded::SignedVarintParamEncoder<int16_t>::GetEncodedValueSize(param.v.i16);
+        case HISYSEVENT_UINT16:
+            return Encoded::UnsignedVarintParamEncoder<uint16_t>::GetEncodedValueSize(param.v.ui16);
+        case HISYSEVENT_INT32:
+            return Encoded::SignedVarintParamEncoder<int32_t>::GetEncodedValueSize(param.v.i32);
+        case HISYSEVENT_UINT32:
+            return Encoded::UnsignedVarintParamEncoder<uint32_t>::GetEncodedValueSize(param.v.ui32);
+        case HISYSEVENT_INT64:
+            return Encoded::SignedVarintParamEncoder<int64_t>::GetEncodedValueSize(param.v.i64);
+        case HISYSEVENT_UINT64:
+            return Encoded::UnsignedVarintParamEncoder<uint64_t>::GetEncodedValueSize(param.v.ui64);
+        case HISYSEVENT_FLOAT:
+            return Encoded::FloatingNumberParamEncoder<float>::GetEncodedValueSize(param.v.f);
+        case HISYSEVENT_DOUBLE:
+            return Encoded::FloatingNumberParamEncoder<double>::GetEncodedValueSize(param.v.d);
+        case HISYSEVENT_STRING:
+            return (param.v.s == nullptr) ? 0 : Encoded::StringParamEncoder::GetEncodedValueSize(param.v.s);
+        case HISYSEVENT_BOOL_ARRAY:
+            return GetEncodedArrayParamValueSize<Encoded::SignedVarintArrayParamEncoder<bool>, bool>(param);
+        case HISYSEVENT_INT8_ARRAY:
+            return GetEncodedArrayParamValueSize<Encoded::SignedVarintArrayParamEncoder<int8_t>, int8_t>(param);
+        case HISYSEVENT_UINT8_ARRAY:
+            return GetEncodedArrayParamValueSize<Encoded::UnsignedVarintArrayParamEncoder<uint8_t>, uint8_t>(param);
+        case HISYSEVENT_INT16_ARRAY:
+            return GetEncodedArrayParamValueSize<Encoded::SignedVarintArrayParamEncoder<int16_t>, int16_t>(param);
+        case HISYSEVENT_UINT16_ARRAY:
+            return GetEncodedArrayParamValueSize<Encoded::UnsignedVarintArrayParamEncoder<uint16_t>, uint16_t>(param);
+        case HISYSEVENT_INT32_ARRAY:
+            return GetEncodedArrayParamValueSize<Encoded::SignedVarintArrayParamEncoder<int32_t>, int32_t>(param);
+        case HISYSEVENT_UINT32_ARRAY:
+            return GetEncodedArrayParamValueSize<Encoded::UnsignedVarintArrayParamEncoder<uint32_t>, uint32_t>(param);
+        case HISYSEVENT_INT64_ARRAY:
+            return GetEncodedArrayParamValueSize<Encoded::SignedVarintArrayParamEncoder<int64_t>, int64_t>(param);
+        case HISYSEVENT_UINT64_ARRAY:
+            return GetEncodedArrayParamValueSize<Encoded::UnsignedVarintArrayParamEncoder<uint64_t>, uint64_t>(param);
+        case HISYSEVENT_FLOAT_ARRAY:
+            return GetEncodedArrayParamValueSize<Encoded::FloatingNumberArrayParamEncoder<float>, float>(param);
+        case HISYSEVENT_DOUBLE_ARRAY:
+            return GetEncodedArrayParamValueSize<Encoded::FloatingNumberArrayParamEncoder<double>, double>(param);
+        case HISYSEVENT_STRING_ARRAY:
+            return GetEncodedArrayParamValueSize<Encoded::StringArrayParamEncoder, char*>(param);
+        default:
+            return 0;
+    }
+}
+
+size_t GetEncodedParamSize(const HiSysEventParam& param)
+{
+    size_t valueSize = GetEncodedParamValueSize(param);
+    if (valueSize == 0) {
+        return 0;
+    }
+    return Encoded::RawDataEncoder::StringValueEncodedSize(param.name) +
+        Encoded::RawDataEncoder::ValueTypeEncodedSize() + valueSize;
+}
+}
+
 HiSysEvent::EventBase::EventBase(const std::string& domain, const std::string& eventName, int type,
     uint64_t timeStamp)
 {
@@ -50,6 +172,23 @@ HiSysEvent::EventBase::EventBase(const std::string& domain, const std::string& e
         SetRetCode(ERR_EVENT_NAME_INVALID);
         return;
     }
+    InitHeader(domain, eventName, type, timeStamp);
+}
+
+HiSysEvent::EventBase::EventBase(const std::string& domain, const std::string& eventName, int type,
+    uint64_t timeStamp, bool isNameValidated)
+{
+    retCode_ = 0;
+    if (!isNameValidated && !StringFilter::GetInstance().IsValidName(eventName, MAX_EVENT_NAME_LENGTH)) {
+        SetRetCode(ERR_EVENT_NAME_INVALID);
+        return;
+    }
+    InitHeader(domain, eventName, type, timeStamp);
+}
+
+void HiSysEvent::EventBase::InitHeader(const std::string& domain, const std::string& eventName, int type,
+    uint64_t timeStamp)
+{
     // append domain to header
     if (memcpy_s(header_.domain, MAX_DOMAIN_LENGTH + 1, domain.c_str(), domain.length()) != EOK) {
         SetRetCode(ERR_RAW_DATA_WROTE_EXCEPTION);
@@ -66,6 +205,16 @@ HiSysEvent::EventBase::EventBase(const std::string& domain, const std::string& e
     header_.timestamp = timeStamp;
 }
 
+HiSysEvent::EventBase::EventBase(const Encoded::HiSysEventHeader& header, uint64_t timeStamp) : header_(header)
+{
+    header_.timestamp = timeStamp;
+}
+
+HiSysEvent::EventBase::~EventBase()
+{
+    RecycleRawData(rawData_);
+}
+
 int HiSysEvent::EventBase::GetRetCode()
 {
     return retCode_;
@@ -89,15 +238,17 @@ void HiSysEvent::EventBase::AppendParam(std::shared_ptr<Encoded::EncodedParam> p
 
 void HiSysEvent::EventBase::WritebaseInfo()
 {
-    rawData_ = std::make_shared<RawData>();
     if (rawData_ == nullptr) {
+        rawData_ = AcquireRawData();
+    }
+    if (rawData_ == nullptr || rawData_->GetData() == nullptr) {
         SetRetCode(ERR_RAW_DATA_WROTE_EXCEPTION);
         return;
     }
-    header_.timeZone = static_cast<uint8_t>(ParseTimeZone(timezone));
-    header_.pid = static_cast<uint32_t>(getprocpid());
-    header_.tid = static_cast<uint32_t>(getproctid());
-    header_.uid = static_cast<uint32_t>(getuid());
+    header_.timeZone = BaseInfoCache::GetTimeZone();
+    header_.pid = BaseInfoCache::GetPid();
+    header_.tid = BaseInfoCache::GetTid();
+    header_.uid = BaseInfoCache::GetUid();
 #ifdef HIVIEWDFX_HITRACE_ENABLED
     HiTraceId hitraceId = HiTraceChain::GetId();
     if (hitraceId.IsValid()) {
@@ -132,11 +283,26 @@ void HiSysEvent::EventBase::WritebaseInfo()
         SetRetCode(ERR_RAW_DATA_WROTE_EXCEPTION);
         return;
     }
+    // rate is wrote as a base info of the sampled event, so that its counts can be scaled back by the receiver
+    if (sampleRate_ < 1.0) {
+        AppendEncodedParam<Encoded::FloatingNumberParamEncoder<double>>(Encoded::BASE_INFO_KEY_SAMPLE_RATE,
+            sampleRate_);
+    }
+    baseInfoParamCnt_ = paramCnt_;
+}
+
+void HiSysEvent::EventBase::ReserveParamsSpace(size_t size)
+{
+    if (rawData_ == nullptr) {
+        return;
+    }
+    // failure of reserving is tolerable, raw data will be expanded while params are appended
+    (void)rawData_->Reserve(rawData_->GetDataLength() + size);
 }
 
 size_t HiSysEvent::EventBase::GetParamCnt()
 {
-    return paramCnt_;
+    return paramCnt_ - baseInfoParamCnt_;
 }
 
 std::shared_ptr<Encoded::RawData> HiSysEvent::EventBase::GetEventRawData()
@@ -150,7 +316,71 @@ std::shared_ptr<Encoded::RawData> HiSysEvent::EventBase::GetEventRawData()
     return rawData_;
 }
 
-int HiSysEvent::CheckKey(const std::string& key)
+const Encoded::HiSysEventHeader& HiSysEvent::EventBase::GetHeader() const
+{
+    return header_;
+}
+
+void HiSysEvent::EventBase::SetRawData(std::shared_ptr<Encoded::RawData> rawData)
+{
+    rawData_ = rawData;
+}
+
+void HiSysEvent::EventBase::SetSampleRate(double sampleRate)
+{
+    sampleRate_ = sampleRate;
+}
+
+HiSysEvent::PreparedEventBase::PreparedEventBase(const std::string& domain, const std::string& eventName, int type)
+    : domain_(domain), eventName_(eventName)
+{
+    EventBase eventBase(domain, eventName, type);
+    retCode_ = eventBase.GetRetCode();
+    header_ = eventBase.header_;
+}
+
+int HiSysEvent::PreparedEventBase::GetRetCode() const
+{
+    return retCode_;
+}
+
+void HiSysEvent::PreparedEventBase::AppendKey(std::string_view key, bool isArray, Encoded::ValueType valueType)
+{
+    EncodedKey encodedKey = { std::string(key), isArray, valueType, encodedKeys_.size(), 0 };
+    int ret = CheckKey(key);
+    if (ret == SUCCESS && validKeyCnt_ >= MAX_PARAM_NUMBER) {
+        ret = ERR_KEY_NUMBER_TOO_MUCH;
+    }
+    Encoded::RawData data;
+    if (ret == SUCCESS && !(Encoded::RawDataEncoder::StringValueEncoded(data, key) &&
+        Encoded::RawDataEncoder::ValueTypeEncoded(data, isArray, valueType, 0))) {
+        ret = ERR_VALUE_INVALID;
+    }
+    if (ret != SUCCESS) {
+        // the param with this key is always discarded while the event is wrote
+        if (retCode_ >= SUCCESS) {
+            retCode_ = ret;
+        }
+        keys_.emplace_back(std::move(encodedKey));
+        return;
+    }
+    encodedKeys_.insert(encodedKeys_.end(), data.GetData(), data.GetData() + data.GetDataLength());
+    encodedKey.encodedLen = data.GetDataLength();
+    keys_.emplace_back(std::move(encodedKey));
+    validKeyCnt_++;
+}
+
+bool HiSysEvent::PreparedEventBase::IsKeyMatched(size_t index, bool isArray, Encoded::ValueType valueType) const
+{
+    return (index < keys_.size()) && (keys_[index].isArray == isArray) && (keys_[index].valueType == valueType);
+}
+
+size_t HiSysEvent::PreparedEventBase::GetKeyCnt() const
+{
+    return keys_.size();
+}
+
+int HiSysEvent::CheckKey(std::string_view key)
 {
     if (!StringFilter::GetInstance().IsValidName(key, MAX_PARAM_NAME_LENGTH)) {
         return ERR_KEY_NAME_INVALID;
@@ -158,6 +388,11 @@ int HiSysEvent::CheckKey(const std::string& key)
     return SUCCESS;
 }
 
+int HiSysEvent::CheckKey(const std::string& key)
+{
+    return CheckKey(std::string_view(key));
+}
+
 int HiSysEvent::CheckValue(const std::string& value)
 {
     if (value.length() > MAX_STRING_LENGTH) {
@@ -226,7 +461,10 @@ void HiSysEvent::SendSysEvent(EventBase& eventBase)
         (void)ExplainThenReturnRetCode(ERR_RAW_DATA_WROTE_EXCEPTION);
         return;
     }
-    int r = Transport::GetInstance().SendData(*(eventBase.GetEventRawData()));
+    auto& asyncWriter = AsyncWriter::GetInstance();
+    // the server is routed by the header kept by the event, rather than by the one parsed out of the raw data
+    int r = asyncWriter.IsEnabled() ? asyncWriter.Write(*rawData) :
+        Transport::GetInstance().SendData(*rawData, EventSocketFactory::GetEventSocket(eventBase.GetHeader()));
     if (r != SUCCESS) {
         eventBase.SetRetCode(r);
         (void)ExplainThenReturnRetCode(r);
@@ -235,11 +473,16 @@ void HiSysEvent::SendSysEvent(EventBase& eventBase)
 
 void HiSysEvent::AppendHexData(EventBase& eventBase, const std::string& key, uint64_t value)
 {
-    eventBase.AppendParam(std::make_shared<Encoded::UnsignedVarintEncodedParam<uint64_t>>(key, value));
+    eventBase.AppendEncodedParam<Encoded::UnsignedVarintParamEncoder<uint64_t>>(key, value);
 }
 
 void HiSysEvent::WritebaseInfo(EventBase& eventBase)
 {
+    // events over the rate limited are discarded before any data is encoded
+    if (!EventRateLimiter::GetInstance().IsAllowed(eventBase.GetHeader())) {
+        eventBase.SetRetCode(ERR_WRITE_IN_HIGH_FREQ);
+        return;
+    }
     eventBase.WritebaseInfo();
 }
 
@@ -253,7 +496,7 @@ void HiSysEvent::AppendBoolParam(EventBase& eventBase, const HiSysEventParam& pa
     if (!CheckParamValidity(eventBase, param.name)) {
         return;
     }
-    eventBase.AppendParam(std::make_shared<Encoded::SignedVarintEncodedParam<bool>>(param.name, param.v.b));
+    eventBase.AppendEncodedParam<Encoded::SignedVarintParamEncoder<bool>>(param.name, param.v.b);
 }
 
 void HiSysEvent::AppendInt8Param(EventBase& eventBase, const HiSysEventParam& param)
@@ -261,7 +504,7 @@ void HiSysEvent::AppendInt8Param(EventBase& eventBase, const HiSysEventParam& pa
     if (!CheckParamValidity(eventBase, param.name)) {
         return;
     }
-    eventBase.AppendParam(std::make_shared<Encoded::SignedVarintEncodedParam<int8_t>>(param.name, param.v.i8));
+    eventBase.AppendEncodedParam<Encoded::SignedVarintParamEncoder<int8_t>>(param.name, param.v.i8);
 }
 
 void HiSysEvent::AppendUint8Param(EventBase& eventBase, const HiSysEventParam& param)
@@ -269,7 +512,7 @@ void HiSysEvent::AppendUint8Param(EventBase& eventBase, const HiSysEventParam& p
     if (!CheckParamValidity(eventBase, param.name)) {
         return;
     }
-    eventBase.AppendParam(std::make_shared<Encoded::UnsignedVarintEncodedParam<uint8_t>>(param.name, param.v.ui8));
+    eventBase.AppendEncodedParam<Encoded::UnsignedVarintParamEncoder<uint8_t>>(param.name, param.v.ui8);
 }
 
 void HiSysEvent::AppendInt16Param(EventBase& eventBase, const HiSysEventParam& param)
@@ -277,7 +520,7 @@ void HiSysEvent::AppendInt16Param(EventBase& eventBase, const HiSysEventParam& p
     if (!CheckParamValidity(eventBase, param.name)) {
         return;
     }
-    eventBase.AppendParam(std::make_shared<Encoded::SignedVarintEncodedParam<int16_t>>(param.name, param.v.i16));
+    eventBase.AppendEncodedParam<Encoded::SignedVarintParamEncoder<int16_t>>(param.name, param.v.i16);
 }
 
 void HiSysEvent::AppendUint16Param(EventBase& eventBase, const HiSysEventParam& param)
@@ -285,7 +528,7 @@ void HiSysEvent::AppendUint16Param(EventBase& eventBase, const HiSysEventParam&
     if (!CheckParamValidity(eventBase, param.name)) {
         return;
     }
-    eventBase.AppendParam(std::make_shared<Encoded::UnsignedVarintEncodedParam<uint16_t>>(param.name, param.v.ui16));
+    eventBase.AppendEncodedParam<Encoded::UnsignedVarintParamEncoder<uint16_t>>(param.name, param.v.ui16);
 }
 
 void HiSysEvent::AppendInt32Param(EventBase& eventBase, const HiSysEventParam& param)
@@ -293,7 +536,7 @@ void HiSysEvent::AppendInt32Param(EventBase& eventBase, const HiSysEventParam& p
     if (!CheckParamValidity(eventBase, param.name)) {
         return;
     }
-    eventBase.AppendParam(std::make_shared<Encoded::SignedVarintEncodedParam<int32_t>>(param.name, param.v.i32));
+    eventBase.AppendEncodedParam<Encoded::SignedVarintParamEncoder<int32_t>>(param.name, param.v.i32);
 }
 
 void HiSysEvent::AppendUint32Param(EventBase& eventBase, const HiSysEventParam& param)
@@ -301,7 +544,7 @@ void HiSysEvent::AppendUint32Param(EventBase& eventBase, const HiSysEventParam&
     if (!CheckParamValidity(eventBase, param.name)) {
         return;
     }
-    eventBase.AppendParam(std::make_shared<Encoded::UnsignedVarintEncodedParam<uint32_t>>(param.name, param.v.ui32));
+    eventBase.AppendEncodedParam<Encoded::UnsignedVarintParamEncoder<uint32_t>>(param.name, param.v.ui32);
 }
 
 void HiSysEvent::AppendInt64Param(EventBase& eventBase, const HiSysEventParam& param)
@@ -309,7 +552,7 @@ void HiSysEvent::AppendInt64Param(EventBase& eventBase, const HiSysEventParam& p
     if (!CheckParamValidity(eventBase, param.name)) {
         return;
     }
-    eventBase.AppendParam(std::make_shared<Encoded::SignedVarintEncodedParam<int64_t>>(param.name, param.v.i64));
+    eventBase.AppendEncodedParam<Encoded::SignedVarintParamEncoder<int64_t>>(param.name, param.v.i64);
 }
 
 void HiSysEvent::AppendUint64Param(EventBase& eventBase, const HiSysEventParam& param)
@@ -317,7 +560,7 @@ void HiSysEvent::AppendUint64Param(EventBase& eventBase, const HiSysEventParam&
     if (!CheckParamValidity(eventBase, param.name)) {
         return;
     }
-    eventBase.AppendParam(std::make_shared<Encoded::UnsignedVarintEncodedParam<uint64_t>>(param.name, param.v.ui64));
+    eventBase.AppendEncodedParam<Encoded::UnsignedVarintParamEncoder<uint64_t>>(param.name, param.v.ui64);
 }
 
 void HiSysEvent::AppendFloatParam(EventBase& eventBase, const HiSysEventParam& param)
@@ -325,7 +568,7 @@ void HiSysEvent::AppendFloatParam(EventBase& eventBase, const HiSysEventParam& p
     if (!CheckParamValidity(eventBase, param.name)) {
         return;
     }
-    eventBase.AppendParam(std::make_shared<Encoded::FloatingNumberEncodedParam<float>>(param.name, param.v.f));
+    eventBase.AppendEncodedParam<Encoded::FloatingNumberParamEncoder<float>>(param.name, param.v.f);
 }
 
 void HiSysEvent::AppendDoubleParam(EventBase& eventBase, const HiSysEventParam& param)
@@ -333,7 +576,7 @@ void HiSysEvent::AppendDoubleParam(EventBase& eventBase, const HiSysEventParam&
     if (!CheckParamValidity(eventBase, param.name)) {
         return;
     }
-    eventBase.AppendParam(std::make_shared<Encoded::FloatingNumberEncodedParam<double>>(param.name, param.v.d));
+    eventBase.AppendEncodedParam<Encoded::FloatingNumberParamEncoder<double>>(param.name, param.v.d);
 }
 
 void HiSysEvent::AppendStringParam(EventBase& eventBase, const HiSysEventParam& param)
@@ -345,9 +588,11 @@ void HiSysEvent::AppendStringParam(EventBase& eventBase, const HiSysEventParam&
     if (!CheckParamValidity(eventBase, param.name)) {
         return;
     }
-    IsWarnAndUpdate(CheckValue(std::string(param.v.s)), eventBase);
-    auto rawStr = StringFilter::GetInstance().EscapeToRaw(std::string(param.v.s));
-    eventBase.AppendParam(std::make_shared<Encoded::StringEncodedParam>(param.name, rawStr));
+    std::string_view value(param.v.s);
+    if (value.length() > MAX_STRING_LENGTH) {
+        eventBase.SetRetCode(ERR_VALUE_LENGTH_TOO_LONG);
+    }
+    eventBase.AppendEncodedParam<Encoded::StringParamEncoder>(param.name, value);
 }
 
 void HiSysEvent::AppendBoolArrayParam(EventBase& eventBase, const HiSysEventParam& param)
@@ -356,11 +601,12 @@ void HiSysEvent::AppendBoolArrayParam(EventBase& eventBase, const HiSysEventPara
     if (!CheckArrayValidity(eventBase, array)) {
         return;
     }
-    std::vector<bool> value(array, array + param.arraySize);
+    Encoded::ArrayView<bool> value(array, param.arraySize);
     if (!CheckArrayParamsValidity(eventBase, param.name, value)) {
         return;
     }
-    eventBase.AppendParam(std::make_shared<Encoded::SignedVarintEncodedArrayParam<bool>>(param.name, value));
+    eventBase.AppendEncodedParam<Encoded::SignedVarintArrayParamEncoder<bool>>(param.name,
+        value.Truncate(MAX_ARRAY_SIZE));
 }
 
 void HiSysEvent::AppendInt8ArrayParam(EventBase& eventBase, const HiSysEventParam& param)
@@ -369,11 +615,12 @@ void HiSysEvent::AppendInt8ArrayParam(EventBase& eventBase, const HiSysEventPara
     if (!CheckArrayValidity(eventBase, array)) {
         return;
     }
-    std::vector<int8_t> value(array, array + param.arraySize);
+    Encoded::ArrayView<int8_t> value(array, param.arraySize);
     if (!CheckArrayParamsValidity(eventBase, param.name, value)) {
         return;
     }
-    eventBase.AppendParam(std::make_shared<Encoded::SignedVarintEncodedArrayParam<int8_t>>(param.name, value));
+    eventBase.AppendEncodedParam<Encoded::SignedVarintArrayParamEncoder<int8_t>>(param.name,
+        value.Truncate(MAX_ARRAY_SIZE));
 }
 
 void HiSysEvent::AppendUint8ArrayParam(EventBase& eventBase, const HiSysEventParam& param)
@@ -382,11 +629,12 @@ void HiSysEvent::AppendUint8ArrayParam(EventBase& eventBase, const HiSysEventPar
     if (!CheckArrayValidity(eventBase, array)) {
         return;
     }
-    std::vector<uint8_t> value(array, array + param.arraySize);
+    Encoded::ArrayView<uint8_t> value(array, param.arraySize);
     if (!CheckArrayParamsValidity(eventBase, param.name, value)) {
         return;
     }
-    eventBase.AppendParam(std::make_shared<Encoded::UnsignedVarintEncodedArrayParam<uint8_t>>(param.name, value));
+    eventBase.AppendEncodedParam<Encoded::UnsignedVarintArrayParamEncoder<uint8_t>>(param.name,
+        value.Truncate(MAX_ARRAY_SIZE));
 }
 
 void HiSysEvent::AppendInt16ArrayParam(EventBase& eventBase, const HiSysEventParam& param)
@@ -395,11 +643,12 @@ void HiSysEvent::AppendInt16ArrayParam(EventBase& eventBase, const HiSysEventPar
     if (!CheckArrayValidity(eventBase, array)) {
         return;
     }
-    std::vector<int16_t> value(array, array + param.arraySize);
+    Encoded::ArrayView<int16_t> value(array, param.arraySize);
     if (!CheckArrayParamsValidity(eventBase, param.name, value)) {
         return;
     }
-    eventBase.AppendParam(std::make_shared<Encoded::SignedVarintEncodedArrayParam<int16_t>>(param.name, value));
+    eventBase.AppendEncodedParam<Encoded::SignedVarintArrayParamEncoder<int16_t>>(param.name,
+        value.Truncate(MAX_ARRAY_SIZE));
 }
 
 void HiSysEvent::AppendUint16ArrayParam(EventBase& eventBase, const HiSysEventParam& param)
@@ -408,11 +657,12 @@ void HiSysEvent::AppendUint16ArrayParam(EventBase& eventBase, const HiSysEventPa
     if (!CheckArrayValidity(eventBase, array)) {
         return;
     }
-    std::vector<uint16_t> value(array, array + param.arraySize);
+    Encoded::ArrayView<uint16_t> value(array, param.arraySize);
     if (!CheckArrayParamsValidity(eventBase, param.name, value)) {
         return;
     }
-    eventBase.AppendParam(std::make_shared<Encoded::UnsignedVarintEncodedArrayParam<uint16_t>>(param.name, value));
+    eventBase.AppendEncodedParam<Encoded::UnsignedVarintArrayParamEncoder<uint16_t>>(param.name,
+        value.Truncate(MAX_ARRAY_SIZE));
 }
 
 void HiSysEvent::AppendInt32ArrayParam(EventBase& eventBase, const HiSysEventParam& param)
@@ -421,11 +671,12 @@ void HiSysEvent::AppendInt32ArrayParam(EventBase& eventBase, const HiSysEventPar
     if (!CheckArrayValidity(eventBase, array)) {
         return;
     }
-    std::vector<int32_t> value(array, array + param.arraySize);
+    Encoded::ArrayView<int32_t> value(array, param.arraySize);
     if (!CheckArrayParamsValidity(eventBase, param.name, value)) {
         return;
     }
-    eventBase.AppendParam(std::make_shared<Encoded::SignedVarintEncodedArrayParam<int32_t>>(param.name, value));
+    eventBase.AppendEncodedParam<Encoded::SignedVarintArrayParamEncoder<int32_t>>(param.name,
+        value.Truncate(MAX_ARRAY_SIZE));
 }
 
 void HiSysEvent::AppendUint32ArrayParam(EventBase& eventBase, const HiSysEventParam& param)
@@ -434,11 +685,12 @@ void HiSysEvent::AppendUint32ArrayParam(EventBase& eventBase, const HiSysEventPa
     if (!CheckArrayValidity(eventBase, array)) {
         return;
     }
-    std::vector<uint32_t> value(array, array + param.arraySize);
+    Encoded::ArrayView<uint32_t> value(array, param.arraySize);
     if (!CheckArrayParamsValidity(eventBase, param.name, value)) {
         return;
     }
-    eventBase.AppendParam(std::make_shared<Encoded::UnsignedVarintEncodedArrayParam<uint32_t>>(param.name, value));
+    eventBase.AppendEncodedParam<Encoded::UnsignedVarintArrayParamEncoder<uint32_t>>(param.name,
+        value.Truncate(MAX_ARRAY_SIZE));
 }
 
 void HiSysEvent::AppendInt64ArrayParam(EventBase& eventBase, const HiSysEventParam& param)
@@ -447,11 +699,12 @@ void HiSysEvent::AppendInt64ArrayParam(EventBase& eventBase, const HiSysEventPar
     if (!CheckArrayValidity(eventBase, array)) {
         return;
     }
-    std::vector<int64_t> value(array, array + param.arraySize);
+    Encoded::ArrayView<int64_t> value(array, param.arraySize);
     if (!CheckArrayParamsValidity(eventBase, param.name, value)) {
         return;
     }
-    eventBase.AppendParam(std::make_shared<Encoded::SignedVarintEncodedArrayParam<int64_t>>(param.name, value));
+    eventBase.AppendEncodedParam<Encoded::SignedVarintArrayParamEncoder<int64_t>>(param.name,
+        value.Truncate(MAX_ARRAY_SIZE));
 }
 
 void HiSysEvent::AppendUint64ArrayParam(EventBase& eventBase, const HiSysEventParam& param)
@@ -460,11 +713,12 @@ void HiSysEvent::AppendUint64ArrayParam(EventBase& eventBase, const HiSysEventPa
     if (!CheckArrayValidity(eventBase, array)) {
         return;
     }
-    std::vector<uint64_t> value(array, array + param.arraySize);
+    Encoded::ArrayView<uint64_t> value(array, param.arraySize);
     if (!CheckArrayParamsValidity(eventBase, param.name, value)) {
         return;
     }
-    eventBase.AppendParam(std::make_shared<Encoded::UnsignedVarintEncodedArrayParam<uint64_t>>(param.name, value));
+    eventBase.AppendEncodedParam<Encoded::UnsignedVarintArrayParamEncoder<uint64_t>>(param.name,
+        value.Truncate(MAX_ARRAY_SIZE));
 }
 
 void HiSysEvent::AppendFloatArrayParam(EventBase& eventBase, const HiSysEventParam& param)
@@ -473,11 +727,12 @@ void HiSysEvent::AppendFloatArrayParam(EventBase& eventBase, const HiSysEventPar
     if (!CheckArrayValidity(eventBase, array)) {
         return;
     }
-    std::vector<float> value(array, array + param.arraySize);
+    Encoded::ArrayView<float> value(array, param.arraySize);
     if (!CheckArrayParamsValidity(eventBase, param.name, value)) {
         return;
     }
-    eventBase.AppendParam(std::make_shared<Encoded::FloatingNumberEncodedArrayParam<float>>(param.name, value));
+    eventBase.AppendEncodedParam<Encoded::FloatingNumberArrayParamEncoder<float>>(param.name,
+        value.Truncate(MAX_ARRAY_SIZE));
 }
 
 void HiSysEvent::AppendDoubleArrayParam(EventBase& eventBase, const HiSysEventParam& param)
@@ -486,11 +741,12 @@ void HiSysEvent::AppendDoubleArrayParam(EventBase& eventBase, const HiSysEventPa
     if (!CheckArrayValidity(eventBase, array)) {
         return;
     }
-    std::vector<double> value(array, array + param.arraySize);
+    Encoded::ArrayView<double> value(array, param.arraySize);
     if (!CheckArrayParamsValidity(eventBase, param.name, value)) {
         return;
     }
-    eventBase.AppendParam(std::make_shared<Encoded::FloatingNumberEncodedArrayParam<double>>(param.name, value));
+    eventBase.AppendEncodedParam<Encoded::FloatingNumberArrayParamEncoder<double>>(param.name,
+        value.Truncate(MAX_ARRAY_SIZE));
 }
 
 void HiSysEvent::AppendStringArrayParam(EventBase& eventBase, const HiSysEventParam& param)
@@ -500,22 +756,23 @@ void HiSysEvent::AppendStringArrayParam(EventBase& eventBase, const HiSysEventPa
         eventBase.SetRetCode(ERR_VALUE_INVALID);
         return;
     }
-    for (size_t i = 0; i < param.arraySize; ++i) {
-        if (auto temp = array + i; *temp == nullptr) {
+    Encoded::ArrayView<char*> value(array, param.arraySize);
+    auto validValue = value.Truncate(MAX_ARRAY_SIZE);
+    for (auto item : validValue) {
+        if (item == nullptr) {
             eventBase.SetRetCode(ERR_VALUE_INVALID);
             return;
         }
     }
-    std::vector<std::string> value(array, array + param.arraySize);
     if (!CheckArrayParamsValidity(eventBase, param.name, value)) {
         return;
     }
-    std::vector<std::string> rawStrs;
-    for (auto& item : value) {
-        IsWarnAndUpdate(CheckValue(item), eventBase);
-        rawStrs.emplace_back(StringFilter::GetInstance().EscapeToRaw(item));
+    for (auto item : validValue) {
+        if (std::string_view(item).length() > MAX_STRING_LENGTH) {
+            eventBase.SetRetCode(ERR_VALUE_LENGTH_TOO_LONG);
+        }
     }
-    eventBase.AppendParam(std::make_shared<Encoded::StringEncodedArrayParam>(param.name, rawStrs));
+    eventBase.AppendEncodedParam<Encoded::StringArrayParamEncoder>(param.name, validValue);
 }
 
 void HiSysEvent::InnerWrite(EventBase& eventBase)
@@ -529,11 +786,31 @@ void HiSysEvent::InnerWrite(EventBase& eventBase, const HiSysEventParam params[]
     if (params == nullptr || size == 0) {
         return;
     }
+    size_t encodedSize = 0;
+    for (size_t i = 0; i < size; ++i) {
+        encodedSize += GetEncodedParamSize(params[i]);
+    }
+    eventBase.ReserveParamsSpace(encodedSize);
     for (size_t i = 0; i < size; ++i) {
         AppendParam(eventBase, params[i]);
     }
 }
 
+void HiSysEvent::InnerWrite(EventBase& eventBase, HiSysEventParamFiller filler, void* context)
+{
+    if (filler == nullptr) {
+        return;
+    }
+    // buffer is taken out of the thread while it's being filled, so events wrote by the filler get their own one
+    thread_local std::vector<HiSysEventParam> filledParams;
+    std::vector<HiSysEventParam> params;
+    params.swap(filledParams);
+    params.resize(MAX_PARAM_NUMBER);
+    size_t size = filler(context, params.data(), params.size());
+    InnerWrite(eventBase, params.data(), std::min(size, params.size()));
+    params.swap(filledParams);
+}
+
 void HiSysEvent::AppendParam(EventBase& eventBase, const HiSysEventParam& param)
 {
     using AppendParamFunc = void (*)(EventBase&, const HiSysEventParam&);
@@ -553,5 +830,275 @@ void HiSysEvent::AppendParam(EventBase& eventBase, const HiSysEventParam& param)
         eventBase.SetRetCode(ERR_VALUE_INVALID);
     }
 }
+
+template<typename Encoder, typename T>
+void HiSysEvent::AppendPreparedValue(EventBase& eventBase, const PreparedEventBase& event, size_t index,
+    const T& value)
+{
+    if (!event.IsKeyMatched(index, Encoder::IS_ARRAY, Encoder::VALUE_TYPE)) {
+        eventBase.SetRetCode(ERR_VALUE_INVALID);
+        return;
+    }
+    event.AppendValue<Encoder>(eventBase, index, value);
+}
+
+template<typename Encoder, typename T>
+void HiSysEvent::AppendPreparedArrayValue(EventBase& eventBase, const PreparedEventBase& event, size_t index,
+    const HiSysEventParam& param)
+{
+    // null array or null string item of array is invalid
+    if (GetEncodedArrayParamValueSize<Encoder, T>(param) == 0) {
+        eventBase.SetRetCode(ERR_VALUE_INVALID);
+        return;
+    }
+    AppendPreparedValue<Encoder>(eventBase, event, index,
+        Encoded::ArrayView<T>(reinterpret_cast<const T*>(param.v.array), param.arraySize));
+}
+
+void HiSysEvent::AppendPreparedParam(EventBase& eventBase, const PreparedEventBase& event, size_t index,
+    const HiSysEventParam& param)
+{
+    switch (param.t) {
+        case HISYSEVENT_BOOL:
+            AppendPreparedValue<Encoded::SignedVarintParamEncoder<bool>>(eventBase, event, index, param.v.b);
+            break;
+        case HISYSEVENT_INT8:
+            AppendPreparedValue<Encoded::SignedVarintParamEncoder<int8_t>>(eventBase, event, index, param.v.i8);
+            break;
+        case HISYSEVENT_UINT8:
+            AppendPreparedValue<Encoded::UnsignedVarintParamEncoder<uint8_t>>(eventBase, event, index, param.v.ui8);
+            break;
+        case HISYSEVENT_INT16:
+            AppendPreparedValue<Encoded::SignedVarintParamEncoder<int16_t>>(eventBase, event, index, param.v.i16);
+            break;
+        case HISYSEVENT_UINT16:
+            AppendPreparedValue<Encoded::UnsignedVarintParamEncoder<uint16_t>>(eventBase, event, index, param.v.ui16);
+            break;
+        case HISYSEVENT_INT32:
+            AppendPreparedValue<Encoded::SignedVarintParamEncoder<int32_t>>(eventBase, event, index, param.v.i32);
+            break;
+        case HISYSEVENT_UINT32:
+            AppendPreparedValue<Encoded::UnsignedVarintParamEncoder<uint32_t>>(eventBase, event, index, param.v.ui32);
+            break;
+        case HISYSEVENT_INT64:
+            AppendPreparedValue<Encoded::SignedVarintParamEncoder<int64_t>>(eventBase, event, index, param.v.i64);
+            break;
+        case HISYSEVENT_UINT64:
+            AppendPreparedValue<Encoded::UnsignedVarintParamEncoder<uint64_t>>(eventBase, event, index, param.v.ui64);
+            break;
+        case HISYSEVENT_FLOAT:
+            AppendPreparedValue<Encoded::FloatingNumberParamEncoder<float>>(eventBase, event, index, param.v.f);
+            break;
+        case HISYSEVENT_DOUBLE:
+            AppendPreparedValue<Encoded::FloatingNumberParamEncoder<double>>(eventBase, event, index, param.v.d);
+            break;
+        case HISYSEVENT_STRING:
+            if (param.v.s == nullptr) {
+                eventBase.SetRetCode(ERR_VALUE_INVALID);
+                break;
+            }
+            AppendPreparedValue<Encoded::StringParamEncoder>(eventBase, event, index, std::string_view(param.v.s));
+            break;
+        case HISYSEVENT_BOOL_ARRAY:
+            AppendPreparedArrayValue<Encoded::SignedVarintArrayParamEncoder<bool>, bool>(eventBase, event,
+                index, param);
+            break;
+        case HISYSEVENT_INT8_ARRAY:
+            AppendPreparedArrayValue<Encoded::SignedVarintArrayParamEncoder<int8_t>, int8_t>(eventBase,
+                event, index, param);
+            break;
+        case HISYSEVENT_UINT8_ARRAY:
+            AppendPreparedArrayValue<Encoded::UnsignedVarintArrayParamEncoder<uint8_t>, uint8_t>(eventBase,
+                event, index, param);
+            break;
+        case HISYSEVENT_INT16_ARRAY:
+            AppendPreparedArrayValue<Encoded::SignedVarintArrayParamEncoder<int16_t>, int16_t>(eventBase,
+                event, index, param);
+            break;
+        case HISYSEVENT_UINT16_ARRAY:
+            AppendPreparedArrayValue<Encoded::UnsignedVarintArrayParamEncoder<uint16_t>, uint16_t>(eventBase,
+                event, index, param);
+            break;
+        case HISYSEVENT_INT32_ARRAY:
+            AppendPreparedArrayValue<Encoded::SignedVarintArrayParamEncoder<int32_t>, int32_t>(eventBase,
+                event, index, param);
+            break;
+        case HISYSEVENT_UINT32_ARRAY:
+            AppendPreparedArrayValue<Encoded::UnsignedVarintArrayParamEncoder<uint32_t>, uint32_t>(eventBase,
+                event, index, param);
+            break;
+        case HISYSEVENT_INT64_ARRAY:
+            AppendPreparedArrayValue<Encoded::SignedVarintArrayParamEncoder<int64_t>, int64_t>(eventBase,
+                event, index, param);
+            break;
+        case HISYSEVENT_UINT64_ARRAY:
+            AppendPreparedArrayValue<Encoded::UnsignedVarintArrayParamEncoder<uint64_t>, uint64_t>(eventBase,
+                event, index, param);
+            break;
+        case HISYSEVENT_FLOAT_ARRAY:
+            AppendPreparedArrayValue<Encoded::FloatingNumberArrayParamEncoder<float>, float>(eventBase,
+                event, index, param);
+            break;
+        case HISYSEVENT_DOUBLE_ARRAY:
+            AppendPreparedArrayValue<Encoded::FloatingNumberArrayParamEncoder<double>, double>(eventBase,
+                event, index, param);
+            break;
+        case HISYSEVENT_STRING_ARRAY:
+            AppendPreparedArrayValue<Encoded::StringArrayParamEncoder, char*>(eventBase, event, index, param);
+            break;
+        default:
+            eventBase.SetRetCode(ERR_VALUE_INVALID);
+            break;
+    }
+}
+
+int HiSysEvent::Write(const char* func, int64_t line, const PreparedEventBase& event,
+    const HiSysEventParam params[], size_t size)
+{
+    double sampleRate = 1.0;
+    if (EventControl::GetInstance().IsDropped(event.domain_.c_str(), event.eventName_.c_str(),
+        event.header_.type + 1, sampleRate)) {
+        return ERR_DOMAIN_MASKED;
+    }
+    ControlParam param = {
+        HISYSEVENT_DEFAULT_PERIOD,
+        HISYSEVENT_DEFAULT_THRESHOLD
+    };
+    uint64_t timeStamp = WriteController::CheckLimitWritingEvent(param, event.domain_.c_str(),
+        event.eventName_.c_str(), func, line);
+    if (timeStamp == INVALID_TIME_STAMP) {
+        return ERR_WRITE_IN_HIGH_FREQ;
+    }
+    if (event.retCode_ < SUCCESS) {
+        return ExplainThenReturnRetCode(event.retCode_);
+    }
+
+    EventBase eventBase(event.header_, timeStamp);
+    eventBase.SetSampleRate(sampleRate);
+    IsWarnAndUpdate(event.retCode_, eventBase);
+    WritebaseInfo(eventBase);
+    if (IsError(eventBase)) {
+        return ExplainThenReturnRetCode(eventBase.GetRetCode());
+    }
+
+    if (params != nullptr) {
+        size_t encodedSize = event.encodedKeys_.size();
+        for (size_t i = 0; i < size; ++i) {
+            encodedSize += GetEncodedParamValueSize(params[i]);
+        }
+        eventBase.ReserveParamsSpace(encodedSize);
+        // params are matched with the prepared keys by their indexes, so the names of them are ignored
+        for (size_t i = 0; i < size; ++i) {
+            AppendPreparedParam(eventBase, event, i, params[i]);
+        }
+    }
+    if (IsError(eventBase)) {
+        return ExplainThenReturnRetCode(eventBase.GetRetCode());
+    }
+
+    SendSysEvent(eventBase);
+    return eventBase.GetRetCode();
+}
+
+size_t HiSysEvent::Batch::GetSize() const
+{
+    return retCodes_.size();
+}
+
+std::shared_ptr<Encoded::RawData> HiSysEvent::Batch::AcquireRawData()
+{
+    if (usedRawDataCnt_ < rawDataPool_.size()) {
+        auto& rawData = rawDataPool_[usedRawDataCnt_++];
+        rawData->Reset();
+        return rawData;
+    }
+    auto rawData = std::make_shared<Encoded::RawData>();
+    rawDataPool_.emplace_back(rawData);
+    usedRawDataCnt_++;
+    return rawData;
+}
+
+int HiSysEvent::Batch::AddRetCode(int retCode)
+{
+    rawDatas_.emplace_back(nullptr);
+    retCodes_.emplace_back(retCode);
+    return retCode;
+}
+
+int HiSysEvent::Batch::AddEvent(EventBase& eventBase)
+{
+    if (IsError(eventBase)) {
+        return AddRetCode(ExplainThenReturnRetCode(eventBase.GetRetCode()));
+    }
+    auto rawData = eventBase.GetEventRawData();
+    if (rawData == nullptr) {
+        return AddRetCode(ExplainThenReturnRetCode(ERR_RAW_DATA_WROTE_EXCEPTION));
+    }
+    rawDatas_.emplace_back(rawData);
+    retCodes_.emplace_back(eventBase.GetRetCode());
+    return eventBase.GetRetCode();
+}
+
+std::vector<int> HiSysEvent::Batch::Write()
+{
+    std::vector<Encoded::RawData*> sentRawDatas;
+    std::vector<size_t> sentIndexes;
+    sentRawDatas.reserve(rawDatas_.size());
+    sentIndexes.reserve(rawDatas_.size());
+    for (size_t i = 0; i < rawDatas_.size(); ++i) {
+        if (rawDatas_[i] != nullptr) {
+            sentRawDatas.emplace_back(rawDatas_[i].get());
+            sentIndexes.emplace_back(i);
+        }
+    }
+    std::vector<int> sentRetCodes(sentRawDatas.size(), SUCCESS);
+    Transport::GetInstance().SendData(sentRawDatas.data(), sentRawDatas.size(), sentRetCodes.data());
+    for (size_t i = 0; i < sentIndexes.size(); ++i) {
+        if (sentRetCodes[i] != SUCCESS) {
+            retCodes_[sentIndexes[i]] = ExplainThenReturnRetCode(sentRetCodes[i]);
+        }
+    }
+    // the buffers are kept for events added later
+    std::vector<int> retCodes;
+    retCodes.swap(retCodes_);
+    rawDatas_.clear();
+    usedRawDataCnt_ = 0;
+    return retCodes;
+}
+
+void HiSysEvent::EnableAsyncMode(AsyncDropPolicy policy)
+{
+    AsyncWriter::GetInstance().Enable(policy == DROP_OLDEST ? AsyncWriter::DROP_OLDEST : AsyncWriter::DROP_NEWEST);
+}
+
+void HiSysEvent::DisableAsyncMode()
+{
+    AsyncWriter::GetInstance().Disable();
+}
+
+void HiSysEvent::FlushAsyncEvents()
+{
+    AsyncWriter::GetInstance().Flush();
+}
+
+int HiSysEvent::EnableSharedMemoryTransport()
+{
+    return Transport::GetInstance().EnableSharedMemoryRing(EventSocketFactory::GetSharedMemoryRingSocket());
+}
+
+void HiSysEvent::DisableSharedMemoryTransport()
+{
+    Transport::GetInstance().DisableSharedMemoryRing();
+}
+
+int HiSysEvent::EnableIoUringTransport()
+{
+    return Transport::GetInstance().SetIoUringEnabled(true);
+}
+
+int HiSysEvent::EnableEventJournal(const std::string& dir, size_t capacity)
+{
+    return Transport::GetInstance().EnableEventJournal(dir, capacity);
+}
 } // namespace HiviewDFX
 } // OHOS
@@ -15,6 +15,7 @@
 
 #include "hisysevent_c.h"
 
+#include <new>
 #include <string>
 
 #include "hilog/log.h"
@@ -35,9 +36,75 @@ int HiSysEventInnerWrite(const char* func, int64_t line, const std::string& doma
         domain.c_str(), name.c_str(), type, size);
     return HiSysEvent::Write(func, line, domain, name, HiSysEvent::EventType(type), params, size);
 }
+
+int HiSysEventInnerWriteLazy(const char* func, int64_t line, const std::string& domain, const std::string& name,
+    HiSysEventEventType type, HiSysEventParamFiller filler, void* context)
+{
+    HILOG_DEBUG(LOG_CORE, "domain=%{public}s, name=%{public}s, type=%{public}d", domain.c_str(), name.c_str(), type);
+    return HiSysEvent::Write(func, line, domain, name, HiSysEvent::EventType(type), filler, context);
+}
+
+int HiSysEventInnerWriteBatch(const char* func, int64_t line, const HiSysEventBatchEvent events[], size_t size,
+    int retCodes[])
+{
+    // buffers of the batch are kept by the thread for next batch
+    thread_local HiSysEvent::Batch batch;
+    for (size_t i = 0; i < size; ++i) {
+        const auto& event = events[i];
+        if (event.domain == nullptr) {
+            (void)batch.Add(func, line, "", "", HiSysEvent::EventType(event.type));
+        } else if (event.name == nullptr) {
+            (void)batch.Add(func, line, event.domain, "", HiSysEvent::EventType(event.type));
+        } else {
+            (void)batch.Add(func, line, event.domain, event.name, HiSysEvent::EventType(event.type), event.params,
+                event.size);
+        }
+    }
+    auto batchRetCodes = batch.Write();
+    int retCode = SUCCESS;
+    for (size_t i = 0; i < batchRetCodes.size(); ++i) {
+        if (retCodes != nullptr) {
+            retCodes[i] = batchRetCodes[i];
+        }
+        if (retCode == SUCCESS && batchRetCodes[i] < SUCCESS) {
+            retCode = batchRetCodes[i];
+        }
+    }
+    return retCode;
+}
+
+void HiSysEventInnerPrepare(HiSysEvent::PreparedEventBase& event, const HiSysEventParam params[], size_t size)
+{
+    constexpr struct {
+        bool isArray;
+        Encoded::ValueType valueType;
+    } paramTypes[] = {
+        {false, Encoded::ValueType::UNKNOWN}, {false, Encoded::ValueType::INT64}, {false, Encoded::ValueType::INT64},
+        {false, Encoded::ValueType::UINT64}, {false, Encoded::ValueType::INT64}, {false, Encoded::ValueType::UINT64},
+        {false, Encoded::ValueType::INT64}, {false, Encoded::ValueType::UINT64}, {false, Encoded::ValueType::INT64},
+        {false, Encoded::ValueType::UINT64}, {false, Encoded::ValueType::FLOAT}, {false, Encoded::ValueType::DOUBLE},
+        {false, Encoded::ValueType::STRING}, {true, Encoded::ValueType::INT64}, {true, Encoded::ValueType::INT64},
+        {true, Encoded::ValueType::UINT64}, {true, Encoded::ValueType::INT64}, {true, Encoded::ValueType::UINT64},
+        {true, Encoded::ValueType::INT64}, {true, Encoded::ValueType::UINT64}, {true, Encoded::ValueType::INT64},
+        {true, Encoded::ValueType::UINT64}, {true, Encoded::ValueType::FLOAT}, {true, Encoded::ValueType::DOUBLE},
+        {true, Encoded::ValueType::STRING},
+    };
+    for (size_t i = 0; params != nullptr && i < size; ++i) {
+        size_t paramType = params[i].t;
+        if (paramType >= sizeof(paramTypes) / sizeof(paramTypes[0])) {
+            paramType = HISYSEVENT_INVALID;
+        }
+        // key with unknown value type is prepared as well, which keeps the indexes of the followed params
+        event.AppendKey(params[i].name, paramTypes[paramType].isArray, paramTypes[paramType].valueType);
+    }
+}
 } // namespace HiviewDFX
 } // namespace OHOS
 
+struct HiSysEventPreparedEvent : public OHOS::HiviewDFX::HiSysEvent::PreparedEventBase {
+    using PreparedEventBase::PreparedEventBase;
+};
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -54,6 +121,61 @@ int HiSysEvent_Write(const char* func, int64_t line, const char* domain, const c
     return OHOS::HiviewDFX::HiSysEventInnerWrite(func, line, domain, name, type, params, size);
 }
 
+int HiSysEvent_WriteLazy(const char* func, int64_t line, const char* domain, const char* name,
+    HiSysEventEventType type, HiSysEventParamFiller filler, void* context)
+{
+    if (domain == nullptr) {
+        return OHOS::HiviewDFX::ERR_DOMAIN_NAME_INVALID;
+    }
+    if (name == nullptr) {
+        return OHOS::HiviewDFX::ERR_EVENT_NAME_INVALID;
+    }
+    return OHOS::HiviewDFX::HiSysEventInnerWriteLazy(func, line, domain, name, type, filler, context);
+}
+
+int HiSysEvent_WriteBatch(const char* func, int64_t line, const HiSysEventBatchEvent events[], size_t size,
+    int retCodes[])
+{
+    if (events == nullptr || size == 0) {
+        return OHOS::HiviewDFX::ERR_EMPTY_EVENT;
+    }
+    return OHOS::HiviewDFX::HiSysEventInnerWriteBatch(func, line, events, size, retCodes);
+}
+
+HiSysEventPreparedEvent* HiSysEvent_PrepareEvent(const char* domain, const char* name, HiSysEventEventType type,
+    const HiSysEventParam params[], size_t size)
+{
+    if (domain == nullptr || name == nullptr) {
+        return nullptr;
+    }
+    auto event = new (std::nothrow) HiSysEventPreparedEvent(domain, name, type);
+    if (event == nullptr) {
+        return nullptr;
+    }
+    if (event->GetRetCode() < OHOS::HiviewDFX::SUCCESS) {
+        HILOG_WARN(LOG_CORE, "failed to prepare event, domain=%{public}s, name=%{public}s, error=%{public}d",
+            domain, name, event->GetRetCode());
+        delete event;
+        return nullptr;
+    }
+    OHOS::HiviewDFX::HiSysEventInnerPrepare(*event, params, size);
+    return event;
+}
+
+int HiSysEvent_WritePreparedEvent(const char* func, int64_t line, const HiSysEventPreparedEvent* event,
+    const HiSysEventParam params[], size_t size)
+{
+    if (event == nullptr) {
+        return OHOS::HiviewDFX::ERR_EMPTY_EVENT;
+    }
+    return OHOS::HiviewDFX::HiSysEvent::Write(func, line, *event, params, size);
+}
+
+void HiSysEvent_DestroyPreparedEvent(HiSysEventPreparedEvent* event)
+{
+    delete event;
+}
+
 #ifdef __cplusplus
 }
 #endif
\ No newline at end of file
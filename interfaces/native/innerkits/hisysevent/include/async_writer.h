@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HISYSEVENT_ASYNC_WRITER_H
+#define HISYSEVENT_ASYNC_WRITER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+#include "raw_data.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+using namespace Encoded;
+struct AsyncWriterStats {
+    uint64_t queuedCnt = 0;
+    uint64_t sentCnt = 0;
+    uint64_t failedCnt = 0;
+    uint64_t droppedCnt = 0;
+};
+
+// bounded multi-producer multi-consumer ring, each cell owns a buffer which is reused by the following events
+class EventRing {
+public:
+    struct Cell {
+        std::atomic<size_t> seq { 0 };
+        std::unique_ptr<RawData> data;
+    };
+
+    explicit EventRing(size_t capacity);
+    ~EventRing() = default;
+    EventRing& operator=(const EventRing&) = delete;
+    EventRing(const EventRing&) = delete;
+
+    Cell* AcquireToPush();
+    void CommitPush(Cell* cell);
+    Cell* Pop();
+    void Release(Cell* cell);
+    bool IsEmpty() const;
+    void Reset();
+
+private:
+    size_t capacity_;
+    std::unique_ptr<Cell[]> cells_;
+    alignas(64) std::atomic<size_t> head_ { 0 };
+    alignas(64) std::atomic<size_t> tail_ { 0 };
+};
+
+class AsyncWriter {
+public:
+    enum DropPolicy {
+        DROP_OLDEST = 0,
+        DROP_NEWEST = 1,
+    };
+
+    static AsyncWriter& GetInstance();
+    bool IsEnabled() const;
+    void Enable(int dropPolicy);
+    void Disable();
+    int Write(RawData& rawData);
+    void Flush();
+    AsyncWriterStats GetStats() const;
+
+private:
+    AsyncWriter();
+    ~AsyncWriter() = default;
+    AsyncWriter& operator=(const AsyncWriter&) = delete;
+    AsyncWriter(const AsyncWriter&) = delete;
+    AsyncWriter& operator=(const AsyncWriter&&) = delete;
+    AsyncWriter(const AsyncWriter&&) = delete;
+
+private:
+    static void FlushOnExit();
+    static void ResetAfterFork();
+    bool DropOldest(EventRing& ring);
+    size_t DrainRing(EventRing& ring);
+    void NotifyWorker();
+    void ReleaseCell(EventRing& ring, EventRing::Cell* cell);
+    void Run();
+    void StartWorker();
+    void Stop();
+    int TryPush(EventRing& ring, RawData& rawData);
+
+private:
+    static AsyncWriter instance_;
+    static constexpr size_t PRIORITY_RING_SIZE = 64;
+    static constexpr size_t NORMAL_RING_SIZE = 256;
+    static constexpr size_t MAX_QUEUED_BYTES = 1024 * 1024; // 1M
+    static constexpr size_t MAX_KEPT_CAPACITY = 16 * 1024; // 16K
+    static constexpr size_t MAX_SENT_CNT_OF_ROUND = 64;
+    static constexpr int LOW_PRIORITY_NICE = 10;
+    static constexpr int IDLE_WAIT_TIME = 100; // 100ms
+    static constexpr int FLUSH_CHECK_INTERVAL = 10; // 10ms
+    static constexpr int MAX_EXIT_WAIT_TIME = 500; // 500ms
+    static constexpr int MAX_DROP_TIMES = 4;
+    EventRing priorityRing_;
+    EventRing normalRing_;
+    std::atomic<bool> isEnabled_ { false };
+    std::atomic<bool> isWorkerRunning_ { false };
+    std::atomic<bool> isStopped_ { false };
+    std::atomic<bool> isWorkerIdle_ { false };
+    std::atomic<int> dropPolicy_ { DROP_NEWEST };
+    std::atomic<size_t> queuedBytes_ { 0 };
+    std::atomic<uint64_t> queuedCnt_ { 0 };
+    std::atomic<uint64_t> sentCnt_ { 0 };
+    std::atomic<uint64_t> failedCnt_ { 0 };
+    std::atomic<uint64_t> droppedCnt_ { 0 };
+    // count of queued events which are sent, failed to send or dropped as the oldest ones
+    std::atomic<uint64_t> doneCnt_ { 0 };
+    std::mutex mutex_;
+    std::condition_variable workerCond_;
+    std::condition_variable flushCond_;
+};
+} // namespace HiviewDFX
+} // namespace OHOS
+
+#endif // HISYSEVENT_ASYNC_WRITER_H
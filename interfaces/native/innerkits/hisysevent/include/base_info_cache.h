@@ -0,0 +1,38 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HISYSEVENT_BASE_INFO_CACHE_H
+#define HISYSEVENT_BASE_INFO_CACHE_H
+
+#include <cstdint>
+
+namespace OHOS {
+namespace HiviewDFX {
+// cache of the base info in event header, which hardly changes during the lifetime of a process or a thread
+class BaseInfoCache {
+public:
+    static uint32_t GetPid();
+    static uint32_t GetTid();
+    static uint32_t GetUid();
+    static uint8_t GetTimeZone();
+
+private:
+    static void RegisterForkHandler();
+    static void ResetAfterFork();
+};
+} // namespace HiviewDFX
+} // namespace OHOS
+
+#endif // HISYSEVENT_BASE_INFO_CACHE_H
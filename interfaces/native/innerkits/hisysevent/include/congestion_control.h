@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HISYSEVENT_CONGESTION_CONTROL_H
+#define HISYSEVENT_CONGESTION_CONTROL_H
+
+#include <atomic>
+#include <cstdint>
+
+namespace OHOS {
+namespace HiviewDFX {
+// times of a destination entering each congestion state, and events skipped while the circuit is broken
+struct CongestionStats {
+    uint64_t congestedCnt = 0;
+    uint64_t brokenCnt = 0;
+    uint64_t recoveredCnt = 0;
+    uint64_t skippedCnt = 0;
+};
+
+// congestion state of a destination:
+// NORMAL    -> CONGESTED, once the socket buffer of the destination is full;
+// CONGESTED -> BROKEN, after several sends failed in a row, sends of events with lower priority are
+//              skipped for a short while, except one probe for each while;
+// any state -> NORMAL, once an event is sent successfully.
+class CongestionControl {
+public:
+    bool IsSendAllowed(bool isHigherPriority);
+    void OnSendBlocked();
+    void OnSendFailed();
+    void OnSendSucceeded();
+    CongestionStats GetStats() const;
+
+private:
+    enum State : uint8_t {
+        NORMAL = 0,
+        CONGESTED,
+        BROKEN,
+    };
+
+private:
+    std::atomic<uint8_t> state_ { NORMAL };
+    std::atomic<uint32_t> failedCnt_ { 0 };
+    std::atomic<int64_t> brokenUntil_ { 0 };
+    std::atomic<uint64_t> congestedCnt_ { 0 };
+    std::atomic<uint64_t> brokenCnt_ { 0 };
+    std::atomic<uint64_t> recoveredCnt_ { 0 };
+    std::atomic<uint64_t> skippedCnt_ { 0 };
+};
+} // namespace HiviewDFX
+} // namespace OHOS
+
+#endif // HISYSEVENT_CONGESTION_CONTROL_H
@@ -112,11 +112,8 @@ public:
         if (rawData_ == nullptr) {
             return false;
         }
-        bool ret = RawDataEncoder::UnsignedVarintEncoded(*rawData_, EncodeType::LENGTH_DELIMITED, vals_.size());
-        for (auto item : vals_) {
-            ret = ret && RawDataEncoder::UnsignedVarintEncoded(*rawData_, EncodeType::VARINT, item);
-        }
-        return ret;
+        return RawDataEncoder::UnsignedVarintEncoded(*rawData_, EncodeType::LENGTH_DELIMITED, vals_.size()) &&
+            RawDataEncoder::UnsignedVarintArrayEncoded<T>(*rawData_, vals_.begin(), vals_.size());
     }
 
 private:
@@ -185,11 +182,8 @@ public:
         if (rawData_ == nullptr) {
             return false;
         }
-        bool ret = RawDataEncoder::UnsignedVarintEncoded(*rawData_, EncodeType::LENGTH_DELIMITED, vals_.size());
-        for (auto item : vals_) {
-            ret = ret && RawDataEncoder::SignedVarintEncoded(*rawData_, EncodeType::VARINT, item);
-        }
-        return ret;
+        return RawDataEncoder::UnsignedVarintEncoded(*rawData_, EncodeType::LENGTH_DELIMITED, vals_.size()) &&
+            RawDataEncoder::SignedVarintArrayEncoded<T>(*rawData_, vals_.begin(), vals_.size());
     }
 
 private:
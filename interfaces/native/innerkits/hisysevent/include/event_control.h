@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HISYSEVENT_EVENT_CONTROL_H
+#define HISYSEVENT_EVENT_CONTROL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+#include "def.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+static constexpr uint32_t EVENT_CONTROL_MAGIC = 0x48534543; // "HSEC"
+static constexpr uint32_t EVENT_CONTROL_VERSION = 2;
+static constexpr size_t CONTROLLED_DOMAIN_BIT_CNT = 1024;
+static constexpr size_t CONTROLLED_EVENT_BIT_CNT = 8192;
+static constexpr size_t MAX_CONTROLLED_ENTRY_CNT = 128;
+static constexpr uint32_t MAX_SAMPLING_LEVEL = 16;
+
+// key whose hash decides whether the event is kept, events of the same uid or pid are kept or dropped together
+enum SamplingKey : uint32_t {
+    SAMPLING_BY_RANDOM = 0,
+    SAMPLING_BY_UID,
+    SAMPLING_BY_PID,
+};
+
+// domain and name sampled, the name is empty if all events of the domain are sampled, rate 0 means disabled
+struct EventControlEntry {
+    std::atomic<uint32_t> seq; // odd while the entry is being updated
+    uint32_t samplingKey;
+    double keptRate;
+    char domain[MAX_DOMAIN_LENGTH + 1];
+    char name[MAX_EVENT_NAME_LENGTH + 1];
+};
+
+/*
+ * Layout of the control block, which is updated in place by the publisher and mapped read only by the writers.
+ * Bits of the hashes of the controlled domains and events are checked first, and the entries are compared only if
+ * the bit is set, so events neither controlled nor sharing a bit with the controlled ones are told apart by one load.
+ */
+struct EventControlBlock {
+    uint32_t magic;
+    uint32_t version;
+    std::atomic<uint32_t> usedEntryCnt; // bits are never checked if no entry is used
+    std::atomic<uint32_t> samplingLevel; // 1 of 2^level events of STATISTIC and BEHAVIOR is kept at most
+    std::atomic<uint64_t> domainBits[CONTROLLED_DOMAIN_BIT_CNT / 64];
+    std::atomic<uint64_t> eventBits[CONTROLLED_EVENT_BIT_CNT / 64];
+    EventControlEntry entries[MAX_CONTROLLED_ENTRY_CNT];
+};
+
+// control block of the writers, which is mapped once it is published, by the prober thread if it's published later
+class EventControl {
+public:
+    explicit EventControl(const std::string& path);
+    ~EventControl();
+    EventControl& operator=(const EventControl&) = delete;
+    EventControl(const EventControl&) = delete;
+
+    static EventControl& GetInstance();
+    bool IsDropped(const char* domain, const char* eventName, int type);
+    /*
+     * Event is kept at the lowest rate of its domain, its name and the sampling level, and the rate is given to be
+     * recorded with the event, so that the counts can be scaled back by the receiver.
+     */
+    bool IsDropped(const char* domain, const char* eventName, int type, double& sampleRate);
+
+private:
+    const EventControlBlock* GetBlock();
+    bool MapBlock();
+    void StartProber();
+    void RunProber();
+    void ResetAfterFork();
+
+private:
+    static constexpr int64_t MAP_RETRY_INTERVAL = 10000; // 10s
+    std::string path_;
+    std::atomic<const EventControlBlock*> block_ { nullptr };
+    std::atomic<bool> isProberStarted_ { false };
+    std::mutex mutex_;
+    std::condition_variable proberCond_;
+    bool isProberRunning_ = false;
+    bool isStopped_ = false;
+};
+
+// publisher of the control block, which is the daemon or a local stand-in, only one publisher is allowed at a time
+class EventControlPublisher {
+public:
+    EventControlPublisher() = default;
+    ~EventControlPublisher();
+    EventControlPublisher& operator=(const EventControlPublisher&) = delete;
+    EventControlPublisher(const EventControlPublisher&) = delete;
+
+    bool Init(const std::string& path);
+    bool Disable(std::string_view domain, std::string_view eventName = "");
+    bool Enable(std::string_view domain, std::string_view eventName = "");
+    // rate is in [0, 1], events are disabled by rate 0 and enabled by rate 1
+    bool SetSamplingRate(std::string_view domain, std::string_view eventName, double rate,
+        SamplingKey key = SAMPLING_BY_RANDOM);
+    bool SetSamplingLevel(uint32_t level);
+    void Reset();
+
+private:
+    void RebuildBits();
+    bool AddEntry(std::string_view domain, std::string_view eventName, double rate, SamplingKey key);
+
+private:
+    int fd_ = -1; // the file is locked through it until the publisher is destroyed
+    EventControlBlock* block_ = nullptr;
+};
+} // namespace HiviewDFX
+} // namespace OHOS
+
+#endif // HISYSEVENT_EVENT_CONTROL_H
@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HISYSEVENT_EVENT_JOURNAL_H
+#define HISYSEVENT_EVENT_JOURNAL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "raw_data.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+using namespace Encoded;
+static constexpr uint32_t EVENT_JOURNAL_MAGIC = 0x48534A4E; // "HSJN"
+static constexpr uint32_t EVENT_JOURNAL_VERSION = 1;
+
+/*
+ * Layout of the journal file: the header is followed by the records, each record is an EventJournalRecord followed
+ * by the data of one event, and aligned by 16 bytes. The state of a record is set after its data and checksum, so
+ * records torn by a crashed process are told apart and skipped in replaying.
+ */
+struct EventJournalHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t capacity; // bytes of the records, which is a power of 2
+    alignas(64) std::atomic<uint64_t> writePos;
+    alignas(64) std::atomic<uint64_t> readPos;
+};
+
+struct EventJournalRecord {
+    std::atomic<uint32_t> state;
+    uint32_t len;
+    uint32_t checksum;
+    uint32_t reserved;
+};
+
+struct EventJournalStats {
+    uint64_t appendedCnt = 0;
+    uint64_t replayedCnt = 0;
+    uint64_t droppedCnt = 0;
+    uint64_t corruptedCnt = 0;
+};
+
+// one file mapped by the journal, which is wrote by the process owning it or replayed by the others
+class EventJournalFile {
+public:
+    EventJournalFile() = default;
+    ~EventJournalFile();
+    EventJournalFile& operator=(const EventJournalFile&) = delete;
+    EventJournalFile(const EventJournalFile&) = delete;
+
+    bool Create(const std::string& path, size_t capacity);
+    bool Open(const std::string& path);
+    int Append(const RawData& rawData);
+    // records are removed once they are handled, the replay stops at the first record failed to be handled
+    bool Replay(const std::function<bool(RawData&)>& handler, uint64_t& corruptedCnt, bool isOrphan);
+    bool IsEmpty() const;
+
+private:
+    bool Map(int fd, size_t size);
+
+private:
+    int fd_ = -1; // the file is locked through it until the journal is destroyed
+    size_t size_ = 0;
+    EventJournalHeader* header_ = nullptr;
+    uint8_t* records_ = nullptr;
+};
+
+class EventJournal {
+public:
+    using SendFunc = std::function<bool(RawData&)>;
+
+    static EventJournal& GetInstance();
+    int Enable(const std::string& dir, size_t capacity, SendFunc sendFunc);
+    bool IsEnabled() const;
+    int Append(const RawData& rawData);
+    EventJournalStats GetStats() const;
+
+private:
+    EventJournal() = default;
+    ~EventJournal() = default;
+    EventJournal& operator=(const EventJournal&) = delete;
+    EventJournal(const EventJournal&) = delete;
+    EventJournal& operator=(const EventJournal&&) = delete;
+    EventJournal(const EventJournal&&) = delete;
+
+private:
+    static void StopOnExit();
+    static void ResetAfterFork();
+    void CollectOrphans(const std::string& dir);
+    void NotifyDrainer();
+    bool ReplayOrphans();
+    void Run();
+    void Stop();
+    void WaitForRetry(int& retryInterval);
+
+private:
+    static EventJournal instance_;
+    static constexpr size_t MIN_CAPACITY = 16 * 1024; // 16K
+    static constexpr size_t MAX_CAPACITY = 4 * 1024 * 1024; // 4M
+    static constexpr size_t MAX_ORPHAN_CNT = 8;
+    static constexpr int IDLE_WAIT_TIME = 1000; // 1s
+    static constexpr int MIN_RETRY_INTERVAL = 100; // 100ms
+    static constexpr int MAX_RETRY_INTERVAL = 5000; // 5s
+    static constexpr int MAX_EXIT_WAIT_TIME = 100; // 100ms
+    EventJournalFile* file_ = nullptr;
+    std::string path_;
+    SendFunc sendFunc_;
+    std::vector<std::string> orphanPaths_;
+    std::atomic<bool> isEnabled_ { false };
+    std::atomic<bool> isDrainerRunning_ { false };
+    std::atomic<bool> isDrainerIdle_ { false };
+    std::atomic<bool> isStopped_ { false };
+    std::atomic<uint64_t> appendedCnt_ { 0 };
+    std::atomic<uint64_t> replayedCnt_ { 0 };
+    std::atomic<uint64_t> droppedCnt_ { 0 };
+    std::atomic<uint64_t> corruptedCnt_ { 0 };
+    std::mutex mutex_;
+    std::condition_variable drainerCond_;
+};
+} // namespace HiviewDFX
+} // namespace OHOS
+
+#endif // HISYSEVENT_EVENT_JOURNAL_H
@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HISYSEVENT_EVENT_RATE_LIMITER_H
+#define HISYSEVENT_EVENT_RATE_LIMITER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "def.h"
+#include "raw_data_base_def.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+using namespace Encoded;
+// token bucket of the events matched, whose tokens are refilled at the rate and kept up to the burst
+struct RateLimitPolicy {
+    std::string domain;
+    std::string name;
+    uint64_t interval = 0; // nanoseconds to refill one token, 0 if no event is allowed
+    uint64_t burstTolerance = 0; // nanoseconds of the tokens in the bucket besides the one being taken
+    uint8_t exemptTypeMask = 0; // bit (type - 1) is set for each type of HiSysEvent::EventType never limited
+    std::atomic<uint64_t> theoreticalArrivalTime { 0 }; // time when the bucket is full again
+};
+
+// policies loaded from one version of the config, which are never changed once the table is published
+class RateLimitTable {
+public:
+    bool AddPolicy(std::string_view domain, std::string_view name, double rate, uint64_t burst,
+        uint8_t exemptTypeMask);
+    bool LoadConfig(const std::string& configPath);
+    RateLimitPolicy* Find(std::string_view domain, std::string_view name) const;
+    size_t GetPolicyCnt() const;
+    // tokens taken from the policies unchanged are carried over, so reloading never refills their buckets
+    void InheritBuckets(const RateLimitTable& oldTable);
+
+private:
+    static uint64_t Hash(uint64_t seed, std::string_view str);
+    RateLimitPolicy* Find(uint64_t domainHash, std::string_view domain, std::string_view name) const;
+
+private:
+    std::vector<std::unique_ptr<RateLimitPolicy>> policies_;
+    std::unordered_map<uint64_t, RateLimitPolicy*> index_; // policies are indexed by hash of domain and name
+    std::unordered_set<uint64_t> domainHashes_; // events of other domains are told apart by one lookup
+};
+
+/*
+ * Events are limited by the policy of their domain and name, or by the one named "*" of their domain. Each line
+ * of the config is "DOMAIN NAME RATE BURST [EXEMPT_TYPE ...]", in which the rate is events per second, e.g.
+ *     AAFWK * 10 50 FAULT
+ * The config is loaded by the reloader thread started by the first event, and reloaded once it's changed, which is
+ * checked every 10 seconds.
+ */
+class EventRateLimiter {
+public:
+    explicit EventRateLimiter(const std::string& configPath);
+    ~EventRateLimiter();
+    EventRateLimiter& operator=(const EventRateLimiter&) = delete;
+    EventRateLimiter(const EventRateLimiter&) = delete;
+
+    static EventRateLimiter& GetInstance();
+    bool IsAllowed(const HiSysEventHeader& header);
+    bool IsAllowed(std::string_view domain, std::string_view name, int type);
+    // returns true if the config has been changed since last loading
+    bool Reload();
+    size_t GetPolicyCnt() const;
+
+private:
+    static uint64_t GetCurrentTimeNanos();
+    void StartReloader();
+    void RunReloader();
+    void ResetAfterFork();
+
+private:
+    // table replaced may still be looked up by other threads, which is released after the grace period
+    struct RetiredTable {
+        std::unique_ptr<RateLimitTable> table;
+        uint64_t retiredTime = 0;
+    };
+
+    static constexpr int64_t RELOAD_CHECK_INTERVAL = 10000; // 10s
+    static constexpr uint64_t RETIRED_TABLE_GRACE_PERIOD = 10000000000; // 10s, far longer than one lookup
+    std::string configPath_;
+    std::atomic<const RateLimitTable*> table_ { nullptr };
+    std::mutex reloadMutex_;
+    std::string configId_; // device, inode, size and modified time of the config loaded
+    std::unique_ptr<RateLimitTable> currentTable_;
+    std::vector<RetiredTable> retiredTables_;
+    std::atomic<bool> isReloaderStarted_ { false };
+    std::mutex mutex_;
+    std::condition_variable reloaderCond_;
+    bool isReloaderRunning_ = false;
+    bool isStopped_ = false;
+};
+} // namespace HiviewDFX
+} // namespace OHOS
+
+#endif // HISYSEVENT_EVENT_RATE_LIMITER_H
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HISYSEVENT_EVENT_ROUTE_TABLE_H
+#define HISYSEVENT_EVENT_ROUTE_TABLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "def.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+static constexpr char ANY_EVENT_NAME[] = "*";
+static constexpr uint8_t ALL_EVENT_TYPES = 0xF; // bit (type - 1) is set for each type of HiSysEvent::EventType
+
+constexpr uint8_t GetEventTypeMask(int type)
+{
+    return static_cast<uint8_t>(1U << (type - 1));
+}
+
+// mask of the type named as "FAULT", "STATISTIC", "SECURITY" or "BEHAVIOR" is added, false is returned if not
+bool ParseEventTypeMask(const std::string& typeName, uint8_t& typeMask);
+
+struct EventRouteRule {
+    uint64_t hash = 0; // hash of both domain and name
+    char domain[MAX_DOMAIN_LENGTH + 1] = { 0 };
+    char name[MAX_EVENT_NAME_LENGTH + 1] = { 0 };
+    uint8_t domainLen = 0;
+    uint8_t nameLen = 0;
+    uint8_t typeMask = ALL_EVENT_TYPES;
+};
+
+/*
+ * Rules of events sent to the higher priority socket, which are looked up by the hash of domain and name without
+ * any allocation. A rule named "*" matches all events of the domain which are not matched by other rules.
+ */
+class EventRouteTable {
+public:
+    // rules are read from the config file, the builtin ones are used if it's absent or invalid
+    static EventRouteTable Load(const std::string& configPath);
+
+    bool AddRule(std::string_view domain, std::string_view name, uint8_t typeMask = ALL_EVENT_TYPES);
+    void AddBuiltinRules();
+    bool LoadConfig(const std::string& configPath);
+    bool IsHigherPriority(std::string_view domain, std::string_view name, int type) const;
+    size_t GetRuleCnt() const;
+
+private:
+    static uint64_t Hash(uint64_t seed, std::string_view str);
+    const EventRouteRule* Find(std::string_view domain, std::string_view name) const;
+    const EventRouteRule* Find(uint64_t domainHash, std::string_view domain, std::string_view name) const;
+    void Rehash();
+
+private:
+    std::vector<EventRouteRule> rules_;
+    std::vector<int32_t> slots_; // indexes of the rules, which are probed linearly from the hash
+    size_t ruleCnt_ = 0;
+};
+} // namespace HiviewDFX
+} // namespace OHOS
+
+#endif // HISYSEVENT_EVENT_ROUTE_TABLE_H
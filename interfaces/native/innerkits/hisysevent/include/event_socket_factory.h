@@ -20,6 +20,7 @@
 #include <sys/un.h>
 
 #include "raw_data.h"
+#include "raw_data_base_def.h"
 
 namespace OHOS {
 namespace HiviewDFX {
@@ -28,6 +29,10 @@ using EventSocket = struct sockaddr_un;
 class EventSocketFactory {
 public:
     static EventSocket& GetEventSocket(RawData& data);
+    static EventSocket& GetEventSocket(const HiSysEventHeader& header);
+    static EventSocket& GetSharedMemoryRingSocket();
+    static bool IsHigherPriorityEvent(RawData& data);
+    static bool IsHigherPriorityEvent(const HiSysEventHeader& header);
 };
 }
 }
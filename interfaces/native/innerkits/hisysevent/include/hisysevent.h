@@ -18,15 +18,21 @@
 
 #ifdef __cplusplus
 
+#include <array>
 #include <iostream>
 #include <string>
 #include <sstream>
+#include <string_view>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 #include "encoded_param.h"
 #include "def.h"
 #include "hisysevent_c.h"
+#include "param_encoder.h"
 #include "raw_data.h"
+#include "event_control.h"
 #include "stringfilter.h"
 #include "write_controller.h"
 
@@ -75,6 +81,16 @@ struct IsMaskedCvt {
 template<const char* domain>
 inline static constexpr bool isMasked = IsMaskedCvt<domain, DOMAIN_MASKS_DEF>::value;
 
+template<const char* domain>
+inline static constexpr bool isValidDomain = StringFilter::IsValidConstName(domain, MAX_DOMAIN_LENGTH);
+
+// whether the string is a literal, which could be validated in compile time
+#if defined(__GNUC__) || defined(__clang__)
+#define HISYSEVENT_IS_CONST_STR(str) __builtin_constant_p(str)
+#else
+#define HISYSEVENT_IS_CONST_STR(str) false
+#endif
+
 class HiSysEvent {
 public:
     friend class HiSysEvent;
@@ -269,8 +285,12 @@ public:
 public:
     template<typename... Types>
     static int Write(const char* func, int64_t line, const std::string &domain,
-        const std::string &eventName, EventType type, Types... keyValues)
+        const std::string &eventName, EventType type, Types&&... keyValues)
     {
+        double sampleRate = 1.0;
+        if (EventControl::GetInstance().IsDropped(domain.c_str(), eventName.c_str(), type, sampleRate)) {
+            return ERR_DOMAIN_MASKED;
+        }
         ControlParam param = {
 #ifdef HISYSEVENT_PERIOD
             HISYSEVENT_PERIOD,
@@ -288,13 +308,19 @@ public:
         if (timeStamp == INVALID_TIME_STAMP) {
             return ERR_WRITE_IN_HIGH_FREQ;
         }
-        return InnerWrite(domain, eventName, type, timeStamp, keyValues...);
+        return InnerWrite(domain, eventName, type, timeStamp, sampleRate, std::forward<Types>(keyValues)...);
     }
 
-    template<const char* domain, typename... Types, std::enable_if_t<!isMasked<domain>>* = nullptr>
+    template<const char* domain, bool isNameValidated = false, typename... Types,
+        std::enable_if_t<!isMasked<domain>>* = nullptr>
     static int Write(const char* func, int64_t line, const std::string& eventName,
-        EventType type, Types... keyValues)
+        EventType type, Types&&... keyValues)
     {
+        static_assert(isValidDomain<domain>, "invalid domain of hisysevent");
+        double sampleRate = 1.0;
+        if (EventControl::GetInstance().IsDropped(domain, eventName.c_str(), type, sampleRate)) {
+            return ERR_DOMAIN_MASKED;
+        }
         ControlParam param = {
 #ifdef HISYSEVENT_PERIOD
             HISYSEVENT_PERIOD,
@@ -312,34 +338,126 @@ public:
         if (timeStamp == INVALID_TIME_STAMP) {
             return ERR_WRITE_IN_HIGH_FREQ;
         }
-        return InnerWrite(std::string(domain), eventName, type, timeStamp, keyValues...);
+        EventBase eventBase(domain, eventName, type, timeStamp, isNameValidated);
+        eventBase.SetSampleRate(sampleRate);
+        return InnerWriteEvent(eventBase, std::forward<Types>(keyValues)...);
     }
 
-    template<const char* domain, typename... Types, std::enable_if_t<isMasked<domain>>* = nullptr>
-    inline static constexpr int Write(const char*, int64_t, const std::string&, EventType, Types...)
+    template<const char* domain, bool isNameValidated = false, typename... Types,
+        std::enable_if_t<isMasked<domain>>* = nullptr>
+    inline static constexpr int Write(const char*, int64_t, const std::string&, EventType, Types&&...)
     {
         // do nothing
         return ERR_DOMAIN_MASKED;
     }
 
+    // slot is owned by the call site, which is used to limit the writing only if the event name is constant
+    template<const char* domain, bool isNameValidated = false, typename... Types,
+        std::enable_if_t<!isMasked<domain>>* = nullptr>
+    static int Write(WriteControlSlot& slot, const char* func, int64_t line, const std::string& eventName,
+        EventType type, Types&&... keyValues)
+    {
+        static_assert(isValidDomain<domain>, "invalid domain of hisysevent");
+        double sampleRate = 1.0;
+        if (EventControl::GetInstance().IsDropped(domain, eventName.c_str(), type, sampleRate)) {
+            return ERR_DOMAIN_MASKED;
+        }
+        ControlParam param = {
+#ifdef HISYSEVENT_PERIOD
+            HISYSEVENT_PERIOD,
+#else
+            HISYSEVENT_DEFAULT_PERIOD,
+#endif
+#ifdef HISYSEVENT_THRESHOLD
+            HISYSEVENT_THRESHOLD
+#else
+            HISYSEVENT_DEFAULT_THRESHOLD
+#endif
+        };
+        uint64_t timeStamp = isNameValidated ?
+            WriteController::CheckLimitWritingEvent(param, slot, domain, eventName.c_str(), func) :
+            WriteController::CheckLimitWritingEvent(param, domain, eventName.c_str(), func, line);
+        if (timeStamp == INVALID_TIME_STAMP) {
+            return ERR_WRITE_IN_HIGH_FREQ;
+        }
+        EventBase eventBase(domain, eventName, type, timeStamp, isNameValidated);
+        eventBase.SetSampleRate(sampleRate);
+        return InnerWriteEvent(eventBase, std::forward<Types>(keyValues)...);
+    }
+
+    template<const char* domain, bool isNameValidated = false, typename... Types,
+        std::enable_if_t<isMasked<domain>>* = nullptr>
+    inline static constexpr int Write(WriteControlSlot&, const char*, int64_t, const std::string&, EventType,
+        Types&&...)
+    {
+        // do nothing
+        return ERR_DOMAIN_MASKED;
+    }
+
+    class PreparedEventBase;
+
 private:
     class EventBase {
     public:
         EventBase(const std::string& domain, const std::string& eventName, int type, uint64_t timeStamp = 0);
-        ~EventBase() = default;
+        // domain has been validated in compile time, so has the event name if isNameValidated is true
+        EventBase(const std::string& domain, const std::string& eventName, int type, uint64_t timeStamp,
+            bool isNameValidated);
+        // header has been validated and initialized by a prepared event
+        EventBase(const Encoded::HiSysEventHeader& header, uint64_t timeStamp);
+        ~EventBase();
 
     public:
         int GetRetCode();
         void SetRetCode(int retCode);
         void AppendParam(std::shared_ptr<Encoded::EncodedParam> param);
         void WritebaseInfo();
+        void ReserveParamsSpace(size_t size);
+        // count of the params wrote by the caller, base infos wrote as params are excluded
         size_t GetParamCnt();
         std::shared_ptr<Encoded::RawData> GetEventRawData();
+        const Encoded::HiSysEventHeader& GetHeader() const;
+        // encode the event into the raw data given rather than the one reused by the thread
+        void SetRawData(std::shared_ptr<Encoded::RawData> rawData);
+        // rate at which the event is kept by sampling, which is wrote with the event if it's lower than 1
+        void SetSampleRate(double sampleRate);
+
+        // encode param into raw data of the event directly, no EncodedParam object is needed
+        template<typename Encoder, typename... Args>
+        void AppendEncodedParam(Args&&... args)
+        {
+            if (rawData_ == nullptr) {
+                return;
+            }
+            if (Encoder::Encode(*rawData_, std::forward<Args>(args)...)) {
+                paramCnt_++;
+            }
+        }
+
+        // append a param whose key and value type have been encoded already, only the value is encoded here
+        template<typename Encoder, typename T>
+        void AppendPreparedParam(const uint8_t* encodedKey, size_t encodedKeyLen, const T& value)
+        {
+            if (rawData_ == nullptr) {
+                return;
+            }
+            if (rawData_->Append(const_cast<uint8_t*>(encodedKey), encodedKeyLen) &&
+                Encoder::EncodeValue(*rawData_, value)) {
+                paramCnt_++;
+            }
+        }
+
+    private:
+        void InitHeader(const std::string& domain, const std::string& eventName, int type, uint64_t timeStamp);
+
+        friend class PreparedEventBase;
 
     private:
         int retCode_ = 0;
         size_t paramCnt_ = 0;
+        size_t baseInfoParamCnt_ = 0;
         size_t paramCntWroteOffset_ = 0;
+        double sampleRate_ = 1.0;
         struct Encoded::HiSysEventHeader header_ = {
             {0}, {0}, 0, 0, 0, 0, 0, 0, 0, 0
         };
@@ -349,31 +467,300 @@ private:
         std::shared_ptr<Encoded::RawData> rawData_ = nullptr;
     };
 
+public:
+    // static parts of an event which are validated and encoded only once, the C API uses it directly
+    class PreparedEventBase {
+    public:
+        PreparedEventBase(const std::string& domain, const std::string& eventName, int type);
+
+    public:
+        int GetRetCode() const;
+        void AppendKey(std::string_view key, bool isArray, Encoded::ValueType valueType);
+        bool IsKeyMatched(size_t index, bool isArray, Encoded::ValueType valueType) const;
+        size_t GetKeyCnt() const;
+
+    protected:
+        template<typename Encoder, typename T>
+        void AppendValue(EventBase& eventBase, size_t index, const T& value) const
+        {
+            const EncodedKey& key = keys_[index];
+            if (key.encodedLen == 0) {
+                // the key is invalid, or there are too many keys
+                return;
+            }
+            if constexpr (Encoder::IS_ARRAY) {
+                if (value.size() == 0) {
+                    std::vector<bool> boolArrayValue;
+                    eventBase.AppendEncodedParam<Encoded::SignedVarintArrayParamEncoder<bool>>(key.key,
+                        boolArrayValue);
+                    return;
+                }
+                IsWarnAndUpdate(CheckArraySize(value.size()), eventBase);
+                if constexpr (std::is_same_v<Encoder, Encoded::StringArrayParamEncoder>) {
+                    // items beyond the max size are discarded, so they are never checked
+                    size_t checkedCnt = (value.size() > MAX_ARRAY_SIZE) ? MAX_ARRAY_SIZE : value.size();
+                    auto item = value.begin();
+                    for (size_t i = 0; i < checkedCnt; ++i, ++item) {
+                        if (std::string_view(*item).length() > MAX_STRING_LENGTH) {
+                            eventBase.SetRetCode(ERR_VALUE_LENGTH_TOO_LONG);
+                        }
+                    }
+                }
+            } else if constexpr (std::is_same_v<Encoder, Encoded::StringParamEncoder>) {
+                if (std::string_view(value).length() > MAX_STRING_LENGTH) {
+                    eventBase.SetRetCode(ERR_VALUE_LENGTH_TOO_LONG);
+                }
+            }
+            eventBase.AppendPreparedParam<Encoder>(encodedKeys_.data() + key.offset, key.encodedLen, value);
+        }
+
+    protected:
+        struct EncodedKey {
+            std::string key;
+            bool isArray;
+            Encoded::ValueType valueType;
+            size_t offset;
+            size_t encodedLen;
+        };
+
+        int retCode_ = SUCCESS;
+        std::string domain_;
+        std::string eventName_;
+        struct Encoded::HiSysEventHeader header_ = {
+            {0}, {0}, 0, 0, 0, 0, 0, 0, 0, 0
+        };
+        std::vector<EncodedKey> keys_;
+        std::vector<uint8_t> encodedKeys_;
+        size_t validKeyCnt_ = 0;
+
+        friend class HiSysEvent;
+    };
+
+    /*
+     * Event with fixed domain, name, type and keys. All of them are validated once, and the header and keys are
+     * encoded once as well, so that only the values need to be encoded while the event is wrote, e.g.
+     *     static HiSysEvent::PreparedEvent<int32_t, std::string> event(HiSysEvent::Domain::AAFWK, "START_ABILITY",
+     *         HiSysEvent::EventType::BEHAVIOR, {"PID", "ABILITY_NAME"});
+     *     event.Write(__FUNCTION__, __LINE__, pid, abilityName);
+     */
+    template<typename... Types>
+    class PreparedEvent : public PreparedEventBase {
+    public:
+        PreparedEvent(const std::string& domain, const std::string& eventName, EventType type,
+            const std::array<std::string_view, sizeof...(Types)>& keys)
+            : PreparedEventBase(domain, eventName, type)
+        {
+            AppendKeys(keys, std::index_sequence_for<Types...>());
+        }
+
+        int Write(const char* func, int64_t line, const Types&... values) const
+        {
+            double sampleRate = 1.0;
+            if (EventControl::GetInstance().IsDropped(domain_.c_str(), eventName_.c_str(), header_.type + 1,
+                sampleRate)) {
+                return ERR_DOMAIN_MASKED;
+            }
+            ControlParam param = {
+#ifdef HISYSEVENT_PERIOD
+                HISYSEVENT_PERIOD,
+#else
+                HISYSEVENT_DEFAULT_PERIOD,
+#endif
+#ifdef HISYSEVENT_THRESHOLD
+                HISYSEVENT_THRESHOLD
+#else
+                HISYSEVENT_DEFAULT_THRESHOLD
+#endif
+            };
+            uint64_t timeStamp = WriteController::CheckLimitWritingEvent(param, domain_.c_str(), eventName_.c_str(),
+                func, line);
+            if (timeStamp == INVALID_TIME_STAMP) {
+                return ERR_WRITE_IN_HIGH_FREQ;
+            }
+            if (retCode_ < SUCCESS) {
+                return ExplainThenReturnRetCode(retCode_);
+            }
+
+            EventBase eventBase(header_, timeStamp);
+            eventBase.SetSampleRate(sampleRate);
+            IsWarnAndUpdate(retCode_, eventBase);
+            WritebaseInfo(eventBase);
+            if (IsError(eventBase)) {
+                return ExplainThenReturnRetCode(eventBase.GetRetCode());
+            }
+
+            eventBase.ReserveParamsSpace(encodedKeys_.size() + (size_t(0) + ... +
+                EncoderOf<Types>::GetEncodedValueSize(values)));
+            AppendValues(eventBase, std::index_sequence_for<Types...>(), values...);
+            if (IsError(eventBase)) {
+                return ExplainThenReturnRetCode(eventBase.GetRetCode());
+            }
+
+            SendSysEvent(eventBase);
+            return eventBase.GetRetCode();
+        }
+
+    private:
+        template<typename T>
+        using EncoderOf = typename Encoded::ParamEncoderSelector<std::decay_t<T>>::Type;
+
+        static_assert((!std::is_void_v<EncoderOf<Types>> && ...), "invalid param type of hisysevent");
+
+        template<size_t... indexes>
+        void AppendKeys(const std::array<std::string_view, sizeof...(Types)>& keys, std::index_sequence<indexes...>)
+        {
+            (AppendKey(keys[indexes], EncoderOf<Types>::IS_ARRAY, EncoderOf<Types>::VALUE_TYPE), ...);
+        }
+
+        template<size_t... indexes>
+        void AppendValues(EventBase& eventBase, std::index_sequence<indexes...>, const Types&... values) const
+        {
+            (AppendValue<EncoderOf<Types>>(eventBase, indexes, values), ...);
+        }
+    };
+
+    static int Write(const char* func, int64_t line, const PreparedEventBase& event,
+        const HiSysEventParam params[], size_t size);
+
+    /*
+     * Events wrote together, which are encoded into buffers kept by the batch and sent by one system call for each
+     * server. Each event is limited by the write controller as if it were wrote alone, e.g.
+     *     HiSysEvent::Batch batch;
+     *     for (const auto& app : apps) {
+     *         batch.Add(__FUNCTION__, __LINE__, HiSysEvent::Domain::AAFWK, "APP_USAGE",
+     *             HiSysEvent::EventType::STATISTIC, "NAME", app.name, "DURATION", app.duration);
+     *     }
+     *     std::vector<int> retCodes = batch.Write();
+     */
+    class Batch {
+    public:
+        template<typename... Types>
+        int Add(const char* func, int64_t line, const std::string& domain, const std::string& eventName,
+            EventType type, Types&&... keyValues)
+        {
+            double sampleRate = 1.0;
+            if (EventControl::GetInstance().IsDropped(domain.c_str(), eventName.c_str(), type, sampleRate)) {
+                return AddRetCode(ERR_DOMAIN_MASKED);
+            }
+            ControlParam param = {
+#ifdef HISYSEVENT_PERIOD
+                HISYSEVENT_PERIOD,
+#else
+                HISYSEVENT_DEFAULT_PERIOD,
+#endif
+#ifdef HISYSEVENT_THRESHOLD
+                HISYSEVENT_THRESHOLD
+#else
+                HISYSEVENT_DEFAULT_THRESHOLD
+#endif
+            };
+            uint64_t timeStamp = WriteController::CheckLimitWritingEvent(param, domain.c_str(), eventName.c_str(),
+                func, line);
+            if (timeStamp == INVALID_TIME_STAMP) {
+                return AddRetCode(ERR_WRITE_IN_HIGH_FREQ);
+            }
+            EventBase eventBase(domain, eventName, type, timeStamp);
+            eventBase.SetSampleRate(sampleRate);
+            eventBase.SetRawData(AcquireRawData());
+            InnerEncodeEvent(eventBase, std::forward<Types>(keyValues)...);
+            return AddEvent(eventBase);
+        }
+
+        size_t GetSize() const;
+
+        // send all events added, the results of which are in the order of adding, the batch is empty after it
+        std::vector<int> Write();
+
+    private:
+        std::shared_ptr<Encoded::RawData> AcquireRawData();
+        int AddRetCode(int retCode);
+        int AddEvent(EventBase& eventBase);
+
+    private:
+        std::vector<std::shared_ptr<Encoded::RawData>> rawDataPool_;
+        size_t usedRawDataCnt_ = 0;
+        // raw data of the events added, nullptr if the event has failed before sending
+        std::vector<std::shared_ptr<Encoded::RawData>> rawDatas_;
+        std::vector<int> retCodes_;
+    };
+
+    enum AsyncDropPolicy {
+        DROP_OLDEST = 0,    // drop the oldest event queued to make room for the new one
+        DROP_NEWEST = 1     // drop the new event
+    };
+
+    /*
+     * In async mode, events are encoded and queued in bounded memory, and sent by a background thread. Fault events
+     * and events sent to the server of higher priority are sent first. Write returns ERR_SEND_FAIL if the event is
+     * dropped, results of sending are not returned. Events queued are flushed on exit of the process.
+     */
+    static void EnableAsyncMode(AsyncDropPolicy policy = DROP_NEWEST);
+    static void DisableAsyncMode();
+
+    // wait until all events queued before are sent or dropped
+    static void FlushAsyncEvents();
+
+    /*
+     * Events are wrote into a ring of shared memory which is handed over to the daemon once, and sent by sockets if
+     * the ring is full. The ring is never used unless it's enabled, and events are sent by sockets until the daemon
+     * maps it. The ring is disabled if the daemon stops consuming it for 1s, and events left in the ring by then are
+     * lost. Returns SUCCESS if the ring is handed over.
+     */
+    static int EnableSharedMemoryTransport();
+    static void DisableSharedMemoryTransport();
+
+    /*
+     * Events are submitted to io_uring and sent without waiting for the daemon, events are sent by sockets if too
+     * many of them are in flight, and those failed are retried as the ones failed through sockets. Returns
+     * ERR_DOES_NOT_INIT if io_uring is unavailable, and sockets are used as before.
+     */
+    static int EnableIoUringTransport();
+
+    /*
+     * Events failed to be sent are appended to a journal file mapped under the directory, and replayed by a
+     * background thread once the daemon is back. Journals left by exited processes are replayed as well.
+     */
+    static int EnableEventJournal(const std::string& dir, size_t capacity = 1024 * 1024); // 1M
+
 private:
     template<typename... Types>
     static int InnerWrite(const std::string& domain, const std::string& eventName,
-        int type, uint64_t timeStamp, Types... keyValues)
+        int type, uint64_t timeStamp, double sampleRate, Types&&... keyValues)
     {
         EventBase eventBase(domain, eventName, type, timeStamp);
-        if (IsError(eventBase)) {
+        eventBase.SetSampleRate(sampleRate);
+        return InnerWriteEvent(eventBase, std::forward<Types>(keyValues)...);
+    }
+
+    template<typename... Types>
+    static int InnerWriteEvent(EventBase& eventBase, Types&&... keyValues)
+    {
+        if (!InnerEncodeEvent(eventBase, std::forward<Types>(keyValues)...)) {
             return ExplainThenReturnRetCode(eventBase.GetRetCode());
         }
 
-        WritebaseInfo(eventBase);
+        SendSysEvent(eventBase);
+        return eventBase.GetRetCode();
+    }
+
+    template<typename... Types>
+    static bool InnerEncodeEvent(EventBase& eventBase, Types&&... keyValues)
+    {
         if (IsError(eventBase)) {
-            return ExplainThenReturnRetCode(eventBase.GetRetCode());
+            return false;
         }
 
-        InnerWrite(eventBase, keyValues...);
+        WritebaseInfo(eventBase);
         if (IsError(eventBase)) {
-            return ExplainThenReturnRetCode(eventBase.GetRetCode());
+            return false;
         }
 
-        SendSysEvent(eventBase);
-        return eventBase.GetRetCode();
+        eventBase.ReserveParamsSpace(Encoded::GetEncodedParamsSize(keyValues...));
+        InnerWrite(eventBase, std::forward<Types>(keyValues)...);
+        return !IsError(eventBase);
     }
 
-    static bool CheckParamValidity(EventBase& eventBase, const std::string &key)
+    static bool CheckParamValidity(EventBase& eventBase, std::string_view key)
     {
         if (IsWarnAndUpdate(CheckKey(key), eventBase)) {
             return false;
@@ -394,16 +781,15 @@ private:
         return true;
     }
 
-    template<typename T>
-    static bool CheckArrayParamsValidity(EventBase& eventBase, const std::string& key, const std::vector<T>& value)
+    template<typename Container>
+    static bool CheckArrayParamsValidity(EventBase& eventBase, std::string_view key, const Container& value)
     {
         if (!CheckParamValidity(eventBase, key)) {
             return false;
         }
         if (value.empty()) {
             std::vector<bool> boolArrayValue;
-            eventBase.AppendParam(std::make_shared<Encoded::SignedVarintEncodedArrayParam<bool>>(key,
-                boolArrayValue));
+            eventBase.AppendEncodedParam<Encoded::SignedVarintArrayParamEncoder<bool>>(key, boolArrayValue);
             return false;
         }
         IsWarnAndUpdate(CheckArraySize(value.size()), eventBase);
@@ -411,344 +797,321 @@ private:
     }
 
     template<typename... Types>
-    static void InnerWrite(EventBase& eventBase, const std::string& key, bool value, Types... keyValues)
+    static void InnerWrite(EventBase& eventBase, std::string_view key, bool value, Types&&... keyValues)
     {
         if (CheckParamValidity(eventBase, key)) {
-            eventBase.AppendParam(std::make_shared<Encoded::SignedVarintEncodedParam<bool>>(key, value));
+            eventBase.AppendEncodedParam<Encoded::SignedVarintParamEncoder<bool>>(key, value);
         }
-        InnerWrite(eventBase, keyValues...);
+        InnerWrite(eventBase, std::forward<Types>(keyValues)...);
     }
 
     template<typename... Types>
-    static void InnerWrite(EventBase& eventBase, const std::string& key, const char value, Types... keyValues)
+    static void InnerWrite(EventBase& eventBase, std::string_view key, const char value, Types&&... keyValues)
     {
         if (CheckParamValidity(eventBase, key)) {
-            eventBase.AppendParam(std::make_shared<Encoded::SignedVarintEncodedParam<int8_t>>(key,
-                static_cast<int8_t>(value)));
+            eventBase.AppendEncodedParam<Encoded::SignedVarintParamEncoder<int8_t>>(key, static_cast<int8_t>(value));
         }
-        InnerWrite(eventBase, keyValues...);
+        InnerWrite(eventBase, std::forward<Types>(keyValues)...);
     }
 
     template<typename... Types>
-    static void InnerWrite(EventBase& eventBase, const std::string& key, const unsigned char value,
-        Types... keyValues)
+    static void InnerWrite(EventBase& eventBase, std::string_view key, const unsigned char value,
+        Types&&... keyValues)
     {
         if (CheckParamValidity(eventBase, key)) {
-            eventBase.AppendParam(std::make_shared<Encoded::UnsignedVarintEncodedParam<uint8_t>>(key,
-                static_cast<uint8_t>(value)));
+            eventBase.AppendEncodedParam<Encoded::UnsignedVarintParamEncoder<uint8_t>>(key,
+                static_cast<uint8_t>(value));
         }
-        InnerWrite(eventBase, keyValues...);
+        InnerWrite(eventBase, std::forward<Types>(keyValues)...);
     }
 
     template<typename... Types>
-    static void InnerWrite(EventBase& eventBase, const std::string& key, const short value, Types... keyValues)
+    static void InnerWrite(EventBase& eventBase, std::string_view key, const short value, Types&&... keyValues)
     {
         if (CheckParamValidity(eventBase, key)) {
-            eventBase.AppendParam(std::make_shared<Encoded::SignedVarintEncodedParam<int16_t>>(key,
-                static_cast<int16_t>(value)));
+            eventBase.AppendEncodedParam<Encoded::SignedVarintParamEncoder<int16_t>>(key, static_cast<int16_t>(value));
         }
-        InnerWrite(eventBase, keyValues...);
+        InnerWrite(eventBase, std::forward<Types>(keyValues)...);
     }
 
     template<typename... Types>
-    static void InnerWrite(EventBase& eventBase, const std::string& key, const unsigned short value,
-        Types... keyValues)
+    static void InnerWrite(EventBase& eventBase, std::string_view key, const unsigned short value,
+        Types&&... keyValues)
     {
         if (CheckParamValidity(eventBase, key)) {
-            eventBase.AppendParam(std::make_shared<Encoded::UnsignedVarintEncodedParam<uint16_t>>(key,
-                static_cast<uint16_t>(value)));
+            eventBase.AppendEncodedParam<Encoded::UnsignedVarintParamEncoder<uint16_t>>(key,
+                static_cast<uint16_t>(value));
         }
-        InnerWrite(eventBase, keyValues...);
+        InnerWrite(eventBase, std::forward<Types>(keyValues)...);
     }
 
     template<typename... Types>
-    static void InnerWrite(EventBase& eventBase, const std::string& key, const int value, Types... keyValues)
+    static void InnerWrite(EventBase& eventBase, std::string_view key, const int value, Types&&... keyValues)
     {
         if (CheckParamValidity(eventBase, key)) {
-            eventBase.AppendParam(std::make_shared<Encoded::SignedVarintEncodedParam<int32_t>>(key, value));
+            eventBase.AppendEncodedParam<Encoded::SignedVarintParamEncoder<int32_t>>(key, value);
         }
-        InnerWrite(eventBase, keyValues...);
+        InnerWrite(eventBase, std::forward<Types>(keyValues)...);
     }
 
     template<typename... Types>
-    static void InnerWrite(EventBase& eventBase, const std::string& key, const unsigned int value,
-        Types... keyValues)
+    static void InnerWrite(EventBase& eventBase, std::string_view key, const unsigned int value,
+        Types&&... keyValues)
     {
         if (CheckParamValidity(eventBase, key)) {
-            eventBase.AppendParam(std::make_shared<Encoded::UnsignedVarintEncodedParam<uint32_t>>(key, value));
+            eventBase.AppendEncodedParam<Encoded::UnsignedVarintParamEncoder<uint32_t>>(key, value);
         }
-        InnerWrite(eventBase, keyValues...);
+        InnerWrite(eventBase, std::forward<Types>(keyValues)...);
     }
 
     template<typename... Types>
-    static void InnerWrite(EventBase& eventBase, const std::string& key, const long value, Types... keyValues)
+    static void InnerWrite(EventBase& eventBase, std::string_view key, const long value, Types&&... keyValues)
     {
         if (CheckParamValidity(eventBase, key)) {
-            eventBase.AppendParam(std::make_shared<Encoded::SignedVarintEncodedParam<int64_t>>(key,
-                static_cast<int64_t>(value)));
+            eventBase.AppendEncodedParam<Encoded::SignedVarintParamEncoder<int64_t>>(key, static_cast<int64_t>(value));
         }
-        InnerWrite(eventBase, keyValues...);
+        InnerWrite(eventBase, std::forward<Types>(keyValues)...);
     }
 
     template<typename... Types>
-    static void InnerWrite(EventBase& eventBase, const std::string& key, const unsigned long value,
-        Types... keyValues)
+    static void InnerWrite(EventBase& eventBase, std::string_view key, const unsigned long value,
+        Types&&... keyValues)
     {
         if (CheckParamValidity(eventBase, key)) {
-            eventBase.AppendParam(std::make_shared<Encoded::UnsignedVarintEncodedParam<uint64_t>>(key,
-                static_cast<uint64_t>(value)));
+            eventBase.AppendEncodedParam<Encoded::UnsignedVarintParamEncoder<uint64_t>>(key,
+                static_cast<uint64_t>(value));
         }
-        InnerWrite(eventBase, keyValues...);
+        InnerWrite(eventBase, std::forward<Types>(keyValues)...);
     }
 
     template<typename... Types>
-    static void InnerWrite(EventBase& eventBase, const std::string& key, const long long value, Types... keyValues)
+    static void InnerWrite(EventBase& eventBase, std::string_view key, const long long value, Types&&... keyValues)
     {
         if (CheckParamValidity(eventBase, key)) {
-            eventBase.AppendParam(std::make_shared<Encoded::SignedVarintEncodedParam<int64_t>>(key,
-                static_cast<int64_t>(value)));
+            eventBase.AppendEncodedParam<Encoded::SignedVarintParamEncoder<int64_t>>(key, static_cast<int64_t>(value));
         }
-        InnerWrite(eventBase, keyValues...);
+        InnerWrite(eventBase, std::forward<Types>(keyValues)...);
     }
 
     template<typename... Types>
-    static void InnerWrite(EventBase& eventBase, const std::string& key, const unsigned long long value,
-        Types... keyValues)
+    static void InnerWrite(EventBase& eventBase, std::string_view key, const unsigned long long value,
+        Types&&... keyValues)
     {
         if (CheckParamValidity(eventBase, key)) {
-            eventBase.AppendParam(std::make_shared<Encoded::UnsignedVarintEncodedParam<uint64_t>>(key,
-                static_cast<uint64_t>(value)));
+            eventBase.AppendEncodedParam<Encoded::UnsignedVarintParamEncoder<uint64_t>>(key,
+                static_cast<uint64_t>(value));
         }
-        InnerWrite(eventBase, keyValues...);
+        InnerWrite(eventBase, std::forward<Types>(keyValues)...);
     }
 
     template<typename... Types>
-    static void InnerWrite(EventBase& eventBase, const std::string& key, const float value, Types... keyValues)
+    static void InnerWrite(EventBase& eventBase, std::string_view key, const float value, Types&&... keyValues)
     {
         if (CheckParamValidity(eventBase, key)) {
-            eventBase.AppendParam(std::make_shared<Encoded::FloatingNumberEncodedParam<float>>(key, value));
+            eventBase.AppendEncodedParam<Encoded::FloatingNumberParamEncoder<float>>(key, value);
         }
-        InnerWrite(eventBase, keyValues...);
+        InnerWrite(eventBase, std::forward<Types>(keyValues)...);
     }
 
     template<typename... Types>
-    static void InnerWrite(EventBase& eventBase, const std::string& key, const double value, Types... keyValues)
+    static void InnerWrite(EventBase& eventBase, std::string_view key, const double value, Types&&... keyValues)
     {
         if (CheckParamValidity(eventBase, key)) {
-            eventBase.AppendParam(std::make_shared<Encoded::FloatingNumberEncodedParam<double>>(key, value));
+            eventBase.AppendEncodedParam<Encoded::FloatingNumberParamEncoder<double>>(key, value);
         }
-        InnerWrite(eventBase, keyValues...);
+        InnerWrite(eventBase, std::forward<Types>(keyValues)...);
     }
 
     template<typename... Types>
-    static void InnerWrite(EventBase& eventBase, const std::string& key, const std::string& value,
-        Types... keyValues)
+    static void InnerWrite(EventBase& eventBase, std::string_view key, const std::string& value,
+        Types&&... keyValues)
     {
         if (CheckParamValidity(eventBase, key)) {
             IsWarnAndUpdate(CheckValue(value), eventBase);
-            auto rawStr = StringFilter::GetInstance().EscapeToRaw(value);
-            eventBase.AppendParam(std::make_shared<Encoded::StringEncodedParam>(key, rawStr));
+            eventBase.AppendEncodedParam<Encoded::StringParamEncoder>(key, value);
         }
-        InnerWrite(eventBase, keyValues...);
+        InnerWrite(eventBase, std::forward<Types>(keyValues)...);
     }
 
     template<typename... Types>
-    static void InnerWrite(EventBase& eventBase, const std::string& key, const char* value, Types... keyValues)
+    static void InnerWrite(EventBase& eventBase, std::string_view key, const char* value, Types&&... keyValues)
     {
         if (CheckParamValidity(eventBase, key)) {
-            IsWarnAndUpdate(CheckValue(std::string(value)), eventBase);
-            auto rawStr = StringFilter::GetInstance().EscapeToRaw(std::string(value));
-            eventBase.AppendParam(std::make_shared<Encoded::StringEncodedParam>(key, std::string(rawStr)));
+            std::string_view valueView(value);
+            if (valueView.length() > MAX_STRING_LENGTH) {
+                eventBase.SetRetCode(ERR_VALUE_LENGTH_TOO_LONG);
+            }
+            eventBase.AppendEncodedParam<Encoded::StringParamEncoder>(key, valueView);
         }
-        InnerWrite(eventBase, keyValues...);
+        InnerWrite(eventBase, std::forward<Types>(keyValues)...);
     }
 
     template<typename... Types>
-    static void InnerWrite(EventBase& eventBase, const std::string& key, const std::vector<bool>& value,
-        Types... keyValues)
+    static void InnerWrite(EventBase& eventBase, std::string_view key, const std::vector<bool>& value,
+        Types&&... keyValues)
     {
         if (CheckArrayParamsValidity(eventBase, key, value)) {
-            eventBase.AppendParam(std::make_shared<Encoded::SignedVarintEncodedArrayParam<bool>>(key, value));
+            eventBase.AppendEncodedParam<Encoded::SignedVarintArrayParamEncoder<bool>>(key, value);
         }
-        InnerWrite(eventBase, keyValues...);
+        InnerWrite(eventBase, std::forward<Types>(keyValues)...);
     }
 
     template<typename... Types>
-    static void InnerWrite(EventBase& eventBase, const std::string& key, const std::vector<char>& value,
-        Types... keyValues)
+    static void InnerWrite(EventBase& eventBase, std::string_view key, const std::vector<char>& value,
+        Types&&... keyValues)
     {
         if (CheckArrayParamsValidity(eventBase, key, value)) {
-            std::vector<int8_t> translated;
-            for (auto item : value) {
-                translated.emplace_back(static_cast<int8_t>(item));
-            }
-            eventBase.AppendParam(std::make_shared<Encoded::SignedVarintEncodedArrayParam<int8_t>>(key, translated));
+            eventBase.AppendEncodedParam<Encoded::SignedVarintArrayParamEncoder<int8_t>>(key, value);
         }
-        InnerWrite(eventBase, keyValues...);
+        InnerWrite(eventBase, std::forward<Types>(keyValues)...);
     }
 
     template<typename... Types>
-    static void InnerWrite(EventBase& eventBase, const std::string& key, const std::vector<unsigned char>& value,
-        Types... keyValues)
+    static void InnerWrite(EventBase& eventBase, std::string_view key, const std::vector<unsigned char>& value,
+        Types&&... keyValues)
     {
         if (CheckArrayParamsValidity(eventBase, key, value)) {
-            std::vector<uint8_t> translated;
-            for (auto item : value) {
-                translated.emplace_back(static_cast<uint8_t>(item));
-            }
-            eventBase.AppendParam(std::make_shared<Encoded::UnsignedVarintEncodedArrayParam<uint8_t>>(key,
-                translated));
+            eventBase.AppendEncodedParam<Encoded::UnsignedVarintArrayParamEncoder<uint8_t>>(key, value);
         }
-        InnerWrite(eventBase, keyValues...);
+        InnerWrite(eventBase, std::forward<Types>(keyValues)...);
     }
 
     template<typename... Types>
-    static void InnerWrite(EventBase& eventBase, const std::string& key, const std::vector<short>& value,
-        Types... keyValues)
+    static void InnerWrite(EventBase& eventBase, std::string_view key, const std::vector<short>& value,
+        Types&&... keyValues)
     {
         if (CheckArrayParamsValidity(eventBase, key, value)) {
-            std::vector<int16_t> translated;
-            for (auto item : value) {
-                translated.emplace_back(static_cast<int16_t>(item));
-            }
-            eventBase.AppendParam(std::make_shared<Encoded::SignedVarintEncodedArrayParam<int16_t>>(key, translated));
+            eventBase.AppendEncodedParam<Encoded::SignedVarintArrayParamEncoder<int16_t>>(key, value);
         }
-        InnerWrite(eventBase, keyValues...);
+        InnerWrite(eventBase, std::forward<Types>(keyValues)...);
     }
 
     template<typename... Types>
-    static void InnerWrite(EventBase& eventBase, const std::string& key, const std::vector<unsigned short>& value,
-        Types... keyValues)
+    static void InnerWrite(EventBase& eventBase, std::string_view key, const std::vector<unsigned short>& value,
+        Types&&... keyValues)
     {
         if (CheckArrayParamsValidity(eventBase, key, value)) {
-            std::vector<uint16_t> translated;
-            for (auto item : value) {
-                translated.emplace_back(static_cast<uint16_t>(item));
-            }
-            eventBase.AppendParam(std::make_shared<Encoded::UnsignedVarintEncodedArrayParam<uint16_t>>(key,
-                translated));
+            eventBase.AppendEncodedParam<Encoded::UnsignedVarintArrayParamEncoder<uint16_t>>(key, value);
         }
-        InnerWrite(eventBase, keyValues...);
+        InnerWrite(eventBase, std::forward<Types>(keyValues)...);
     }
 
     template<typename... Types>
-    static void InnerWrite(EventBase& eventBase, const std::string& key, const std::vector<int>& value,
-        Types... keyValues)
+    static void InnerWrite(EventBase& eventBase, std::string_view key, const std::vector<int>& value,
+        Types&&... keyValues)
     {
         if (CheckArrayParamsValidity(eventBase, key, value)) {
-            eventBase.AppendParam(std::make_shared<Encoded::SignedVarintEncodedArrayParam<int32_t>>(key, value));
+            eventBase.AppendEncodedParam<Encoded::SignedVarintArrayParamEncoder<int32_t>>(key, value);
         }
-        InnerWrite(eventBase, keyValues...);
+        InnerWrite(eventBase, std::forward<Types>(keyValues)...);
     }
 
     template<typename... Types>
-    static void InnerWrite(EventBase& eventBase, const std::string& key, const std::vector<unsigned int>& value,
-        Types... keyValues)
+    static void InnerWrite(EventBase& eventBase, std::string_view key, const std::vector<unsigned int>& value,
+        Types&&... keyValues)
     {
         if (CheckArrayParamsValidity(eventBase, key, value)) {
-            eventBase.AppendParam(std::make_shared<Encoded::UnsignedVarintEncodedArrayParam<uint32_t>>(key, value));
+            eventBase.AppendEncodedParam<Encoded::UnsignedVarintArrayParamEncoder<uint32_t>>(key, value);
         }
-        InnerWrite(eventBase, keyValues...);
+        InnerWrite(eventBase, std::forward<Types>(keyValues)...);
     }
 
     template<typename... Types>
-    static void InnerWrite(EventBase& eventBase, const std::string& key, const std::vector<long>& value,
-        Types... keyValues)
+    static void InnerWrite(EventBase& eventBase, std::string_view key, const std::vector<long>& value,
+        Types&&... keyValues)
     {
         if (CheckArrayParamsValidity(eventBase, key, value)) {
-            std::vector<int64_t> translated;
-            for (auto item : value) {
-                translated.emplace_back(static_cast<int64_t>(item));
-            }
-            eventBase.AppendParam(std::make_shared<Encoded::SignedVarintEncodedArrayParam<int64_t>>(key, translated));
+            eventBase.AppendEncodedParam<Encoded::SignedVarintArrayParamEncoder<int64_t>>(key, value);
         }
-        InnerWrite(eventBase, keyValues...);
+        InnerWrite(eventBase, std::forward<Types>(keyValues)...);
     }
 
     template<typename... Types>
-    static void InnerWrite(EventBase& eventBase, const std::string& key, const std::vector<unsigned long>& value,
-        Types... keyValues)
+    static void InnerWrite(EventBase& eventBase, std::string_view key, const std::vector<unsigned long>& value,
+        Types&&... keyValues)
     {
         if (CheckArrayParamsValidity(eventBase, key, value)) {
-            std::vector<uint64_t> translated;
-            for (auto item : value) {
-                translated.emplace_back(static_cast<uint64_t>(item));
-            }
-            eventBase.AppendParam(std::make_shared<Encoded::UnsignedVarintEncodedArrayParam<uint64_t>>(key,
-                translated));
+            eventBase.AppendEncodedParam<Encoded::UnsignedVarintArrayParamEncoder<uint64_t>>(key, value);
         }
-        InnerWrite(eventBase, keyValues...);
+        InnerWrite(eventBase, std::forward<Types>(keyValues)...);
     }
 
     template<typename... Types>
-    static void InnerWrite(EventBase& eventBase, const std::string& key, const std::vector<long long>& value,
-        Types... keyValues)
+    static void InnerWrite(EventBase& eventBase, std::string_view key, const std::vector<long long>& value,
+        Types&&... keyValues)
     {
         if (CheckArrayParamsValidity(eventBase, key, value)) {
-            std::vector<int64_t> translated;
-            for (auto item : value) {
-                translated.emplace_back(static_cast<int64_t>(item));
-            }
-            eventBase.AppendParam(std::make_shared<Encoded::SignedVarintEncodedArrayParam<int64_t>>(key, translated));
+            eventBase.AppendEncodedParam<Encoded::SignedVarintArrayParamEncoder<int64_t>>(key, value);
         }
-        InnerWrite(eventBase, keyValues...);
+        InnerWrite(eventBase, std::forward<Types>(keyValues)...);
     }
 
     template<typename... Types>
-    static void InnerWrite(EventBase& eventBase, const std::string& key, const std::vector<unsigned long long>& value,
-        Types... keyValues)
+    static void InnerWrite(EventBase& eventBase, std::string_view key, const std::vector<unsigned long long>& value,
+        Types&&... keyValues)
     {
         if (CheckArrayParamsValidity(eventBase, key, value)) {
-            std::vector<uint64_t> translated;
-            for (auto item : value) {
-                translated.emplace_back(static_cast<uint64_t>(item));
-            }
-            eventBase.AppendParam(std::make_shared<Encoded::UnsignedVarintEncodedArrayParam<uint64_t>>(key,
-                translated));
+            eventBase.AppendEncodedParam<Encoded::UnsignedVarintArrayParamEncoder<uint64_t>>(key, value);
         }
-        InnerWrite(eventBase, keyValues...);
+        InnerWrite(eventBase, std::forward<Types>(keyValues)...);
     }
 
     template<typename... Types>
-    static void InnerWrite(EventBase& eventBase, const std::string& key, const std::vector<float>& value,
-        Types... keyValues)
+    static void InnerWrite(EventBase& eventBase, std::string_view key, const std::vector<float>& value,
+        Types&&... keyValues)
     {
         if (CheckArrayParamsValidity(eventBase, key, value)) {
-            eventBase.AppendParam(std::make_shared<Encoded::FloatingNumberEncodedArrayParam<float>>(key, value));
+            eventBase.AppendEncodedParam<Encoded::FloatingNumberArrayParamEncoder<float>>(key, value);
         }
-        InnerWrite(eventBase, keyValues...);
+        InnerWrite(eventBase, std::forward<Types>(keyValues)...);
     }
 
     template<typename... Types>
-    static void InnerWrite(EventBase& eventBase, const std::string& key, const std::vector<double>& value,
-        Types... keyValues)
+    static void InnerWrite(EventBase& eventBase, std::string_view key, const std::vector<double>& value,
+        Types&&... keyValues)
     {
         if (CheckArrayParamsValidity(eventBase, key, value)) {
-            eventBase.AppendParam(std::make_shared<Encoded::FloatingNumberEncodedArrayParam<double>>(key, value));
+            eventBase.AppendEncodedParam<Encoded::FloatingNumberArrayParamEncoder<double>>(key, value);
         }
-        InnerWrite(eventBase, keyValues...);
+        InnerWrite(eventBase, std::forward<Types>(keyValues)...);
     }
 
     template<typename... Types>
-    static void InnerWrite(EventBase& eventBase, const std::string& key, const std::vector<std::string>& value,
-        Types... keyValues)
+    static void InnerWrite(EventBase& eventBase, std::string_view key, const std::vector<std::string>& value,
+        Types&&... keyValues)
     {
         if (CheckArrayParamsValidity(eventBase, key, value)) {
-            std::vector<std::string> rawStrs;
             for (auto& item : value) {
                 IsWarnAndUpdate(CheckValue(item), eventBase);
-                rawStrs.emplace_back(StringFilter::GetInstance().EscapeToRaw(item));
             }
-            eventBase.AppendParam(std::make_shared<Encoded::StringEncodedArrayParam>(key, rawStrs));
+            eventBase.AppendEncodedParam<Encoded::StringArrayParamEncoder>(key, value);
+        }
+        InnerWrite(eventBase, std::forward<Types>(keyValues)...);
+    }
+
+    /*
+     * Value given as a callable is produced only after the event passes the throttle, the control and the rate
+     * limit, and its key and the count of params are checked, e.g.
+     *     HiSysEventWrite(..., "STACK", [&thread] { return thread.CollectStack(); })
+     */
+    template<typename F, typename... Types, std::enable_if_t<std::is_invocable_v<const F&>>* = nullptr>
+    static void InnerWrite(EventBase& eventBase, std::string_view key, const F& producer, Types&&... keyValues)
+    {
+        if (IsError(eventBase) || !CheckParamValidity(eventBase, key)) {
+            InnerWrite(eventBase, std::forward<Types>(keyValues)...);
+            return;
         }
-        InnerWrite(eventBase, keyValues...);
+        InnerWrite(eventBase, key, producer(), std::forward<Types>(keyValues)...);
     }
 
 private:
     static void InnerWrite(EventBase& eventBase);
     static void InnerWrite(EventBase& eventBase, const HiSysEventParam params[], size_t size);
+    static void InnerWrite(EventBase& eventBase, HiSysEventParamFiller filler, void* context);
     static void WritebaseInfo(EventBase& eventBase);
     static void AppendHexData(EventBase& eventBase, const std::string& key, uint64_t value);
+    static int CheckKey(std::string_view key);
+    // kept for the callers built with the inline templates before
     static int CheckKey(const std::string& key);
     static int CheckValue(const std::string& value);
     static int CheckArraySize(const size_t size);
@@ -784,6 +1147,14 @@ private:
     static void AppendDoubleArrayParam(EventBase& eventBase, const HiSysEventParam& param);
     static void AppendStringArrayParam(EventBase& eventBase, const HiSysEventParam& param);
     static void AppendParam(EventBase& eventBase, const HiSysEventParam& param);
+    static void AppendPreparedParam(EventBase& eventBase, const PreparedEventBase& event, size_t index,
+        const HiSysEventParam& param);
+    template<typename Encoder, typename T>
+    static void AppendPreparedValue(EventBase& eventBase, const PreparedEventBase& event, size_t index,
+        const T& value);
+    template<typename Encoder, typename T>
+    static void AppendPreparedArrayValue(EventBase& eventBase, const PreparedEventBase& event, size_t index,
+        const HiSysEventParam& param);
 };
 
 /**
@@ -794,13 +1165,18 @@ private:
  * @return 0 means success,
  *     greater than 0 also means success but with some data ignored,
  *     less than 0 means failure.
+ * @note domain and literal event name are validated in compile time.
  */
 #define HiSysEventWrite(domain, eventName, type, ...) \
 ({ \
+    static_assert(!HISYSEVENT_IS_CONST_STR(eventName) || OHOS::HiviewDFX::StringFilter::IsValidConstName( \
+        eventName, OHOS::HiviewDFX::MAX_EVENT_NAME_LENGTH), "invalid event name of hisysevent"); \
     int hiSysEventWriteRet2023___ = OHOS::HiviewDFX::ERR_DOMAIN_MASKED; \
     if constexpr (!OHOS::HiviewDFX::isMasked<domain>) { \
-        hiSysEventWriteRet2023___ = OHOS::HiviewDFX::HiSysEvent::Write<domain>(__FUNCTION__, __LINE__, \
-            eventName, type, ##__VA_ARGS__); \
+        static OHOS::HiviewDFX::WriteControlSlot hiSysEventSlot2023___; \
+        hiSysEventWriteRet2023___ = OHOS::HiviewDFX::HiSysEvent::Write<domain, \
+            HISYSEVENT_IS_CONST_STR(eventName)>(hiSysEventSlot2023___, __FUNCTION__, __LINE__, eventName, type, \
+            ##__VA_ARGS__); \
     } \
     hiSysEventWriteRet2023___; \
 })
@@ -114,6 +114,92 @@ typedef enum HiSysEventEventType HiSysEventEventType;
 int HiSysEvent_Write(const char* func, int64_t line, const char* domain, const char* name,
     HiSysEventEventType type, const HiSysEventParam params[], size_t size);
 
+/**
+ * @brief Fill params of system event, which is called only after the event passes the throttle, the control and
+ *        the rate limit.
+ * @param context the context given together with the callback.
+ * @param params  the params to fill, values of which should be valid until the writing returns.
+ * @param size    the max size of param list.
+ * @return the size of params filled.
+ */
+typedef size_t (*HiSysEventParamFiller)(void* context, HiSysEventParam params[], size_t size);
+
+/**
+ * @brief Write system event, the params of which are filled by the callback only if the event is going to be sent.
+ * @param domain  event domain.
+ * @param name    event name.
+ * @param type    event type.
+ * @param filler  callback filling the params.
+ * @param context context given to the callback.
+ * @return 0 means success, less than 0 means failure, greater than 0 means invalid params.
+ */
+#define OH_HiSysEvent_WriteLazy(domain, name, type, filler, context) \
+    HiSysEvent_WriteLazy(__FUNCTION__, __LINE__, domain, name, type, filler, context)
+
+int HiSysEvent_WriteLazy(const char* func, int64_t line, const char* domain, const char* name,
+    HiSysEventEventType type, HiSysEventParamFiller filler, void* context);
+
+/**
+ * @brief Define event of a batch.
+ */
+struct HiSysEventBatchEvent {
+    const char* domain;
+    const char* name;
+    HiSysEventEventType type;
+    const HiSysEventParam* params;
+    size_t size;
+};
+typedef struct HiSysEventBatchEvent HiSysEventBatchEvent;
+
+/**
+ * @brief Write system events in batch, which are sent by one system call for each server.
+ * @param events   the events.
+ * @param size     the size of event list.
+ * @param retCodes results of the events, which are the same as the ones of writing each event alone, could be NULL.
+ * @return 0 means success of all events, less than 0 means failure of some event, which is the first one failed.
+ */
+#define OH_HiSysEvent_WriteBatch(events, size, retCodes) \
+    HiSysEvent_WriteBatch(__FUNCTION__, __LINE__, events, size, retCodes)
+
+int HiSysEvent_WriteBatch(const char* func, int64_t line, const HiSysEventBatchEvent events[], size_t size,
+    int retCodes[]);
+
+/**
+ * @brief Define prepared event, whose domain, name, type and keys are fixed.
+ */
+typedef struct HiSysEventPreparedEvent HiSysEventPreparedEvent;
+
+/**
+ * @brief Prepare system event, the domain, name and keys of which are validated and encoded only once.
+ * @param domain event domain.
+ * @param name   event name.
+ * @param type   event type.
+ * @param params names and types of the event params, the values of them are ignored.
+ * @param size   the size of param list.
+ * @return the prepared event, which should be destroyed by HiSysEvent_DestroyPreparedEvent, NULL means failure.
+ */
+HiSysEventPreparedEvent* HiSysEvent_PrepareEvent(const char* domain, const char* name, HiSysEventEventType type,
+    const HiSysEventParam params[], size_t size);
+
+/**
+ * @brief Write prepared system event.
+ * @param event  the prepared event.
+ * @param params event params, which are in the same order and of the same types as the prepared ones.
+ * @param size   the size of param list.
+ * @return 0 means success, less than 0 means failure, greater than 0 means invalid params.
+ */
+#define OH_HiSysEvent_WritePreparedEvent(event, params, size) \
+    HiSysEvent_WritePreparedEvent(__FUNCTION__, __LINE__, event, params, size)
+
+int HiSysEvent_WritePreparedEvent(const char* func, int64_t line, const HiSysEventPreparedEvent* event,
+    const HiSysEventParam params[], size_t size);
+
+/**
+ * @brief Destroy prepared system event.
+ * @param event the prepared event.
+ */
+void HiSysEvent_DestroyPreparedEvent(HiSysEventPreparedEvent* event);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HISYSEVENT_IO_URING_SENDER_H
+#define HISYSEVENT_IO_URING_SENDER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include "event_socket_factory.h"
+#include "raw_data.h"
+
+struct io_uring_params;
+struct io_uring_sqe;
+struct io_uring_cqe;
+
+namespace OHOS {
+namespace HiviewDFX {
+using namespace Encoded;
+struct IoUringStats {
+    uint64_t submittedCnt = 0;
+    uint64_t completedCnt = 0;
+    uint64_t failedCnt = 0;
+    uint64_t busyCnt = 0;
+};
+
+/*
+ * Data is copied into one of the registered buffers and submitted to io_uring as a write to the registered socket
+ * connected to the server. The completions are reaped by the reaper thread woken by the eventfd registered, and by the
+ * following sends without any system call.
+ */
+class IoUringSender {
+public:
+    IoUringSender() = default;
+    ~IoUringSender();
+    IoUringSender& operator=(const IoUringSender&) = delete;
+    IoUringSender(const IoUringSender&) = delete;
+
+    // data of the failed writes is handed over to the handler with the lock held, so it never sends by the sender.
+    // the handler may be called by the reaper thread
+    using FailureHandler = std::function<void(const RawData& rawData)>;
+
+    bool Init();
+    void SetFailureHandler(const FailureHandler& handler);
+    int Send(const EventSocket& serverAddr, const RawData& rawData);
+    void ReapCompletions();
+    IoUringStats GetStats();
+
+private:
+    int GetFileIndex(const EventSocket& serverAddr);
+    bool MapQueues(const struct io_uring_params& params);
+    void ReapCompletionsLocked();
+    void RunReaper();
+    void Submit();
+
+private:
+    static constexpr unsigned QUEUE_DEPTH = 64;
+    static constexpr size_t SLOT_CNT = 32;
+    static constexpr size_t SLOT_SIZE = 4096;
+    static constexpr size_t MAX_SERVER_CNT = 4;
+    std::mutex mutex_;
+    int ringFd_ = -1;
+    int eventFd_ = -1; // signaled by io_uring once requests are completed
+    std::atomic<bool> isReaperStopped_ { false };
+    std::thread reaper_;
+    void* sqRing_ = nullptr;
+    size_t sqRingSize_ = 0;
+    void* cqRing_ = nullptr;
+    size_t cqRingSize_ = 0;
+    struct io_uring_sqe* sqes_ = nullptr;
+    size_t sqesSize_ = 0;
+    unsigned* sqHead_ = nullptr;
+    unsigned* sqTail_ = nullptr;
+    unsigned sqMask_ = 0;
+    unsigned* sqArray_ = nullptr;
+    unsigned* cqHead_ = nullptr;
+    unsigned* cqTail_ = nullptr;
+    unsigned cqMask_ = 0;
+    struct io_uring_cqe* cqes_ = nullptr;
+    uint8_t* buffers_ = nullptr;
+    uint64_t freeSlots_ = 0; // bit map of the buffers not in flight
+    uint32_t slotDataLens_[SLOT_CNT] {};
+    FailureHandler failureHandler_;
+    // servers are told apart by the addresses of the static objects from the socket factory
+    const EventSocket* servers_[MAX_SERVER_CNT] {};
+    int serverSockets_[MAX_SERVER_CNT] = { -1, -1, -1, -1 };
+    IoUringStats stats_;
+};
+} // namespace HiviewDFX
+} // namespace OHOS
+
+#endif // HISYSEVENT_IO_URING_SENDER_H
@@ -0,0 +1,358 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HISYSEVENT_INTERFACE_ENCODE_INCLUDE_PARAM_ENCODER_H
+#define HISYSEVENT_INTERFACE_ENCODE_INCLUDE_PARAM_ENCODER_H
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "def.h"
+#include "raw_data_base_def.h"
+#include "raw_data_encoder.h"
+#include "raw_data.h"
+
+/*
+ * Encoders below write a whole key-value param straight into the raw data of an event, which produce
+ * the same bytes as the EncodedParam family but without allocating any intermediate object.
+ */
+namespace OHOS {
+namespace HiviewDFX {
+namespace Encoded {
+// non-owning view over items of an array, the items are encoded from memory of the caller directly
+template<typename T>
+class ArrayView {
+public:
+    ArrayView(const T* data, size_t size): data_(data), size_(size) {}
+
+    const T* begin() const
+    {
+        return data_;
+    }
+
+    const T* end() const
+    {
+        return data_ + size_;
+    }
+
+    size_t size() const
+    {
+        return size_;
+    }
+
+    bool empty() const
+    {
+        return size_ == 0;
+    }
+
+    // items beyond the max size are discarded without being copied or visited
+    ArrayView Truncate(size_t maxSize) const
+    {
+        return ArrayView(data_, (size_ > maxSize) ? maxSize : size_);
+    }
+
+private:
+    const T* data_;
+    size_t size_;
+};
+
+template<typename Container>
+inline size_t GetEncodedArraySize(const Container& vals)
+{
+    return (vals.size() > MAX_ARRAY_SIZE) ? MAX_ARRAY_SIZE : vals.size();
+}
+
+/*
+ * An encoded param is made up of two parts: key with value type, and then the value. The first part could be
+ * encoded only once for params whose key and value type never change, see HiSysEvent::PreparedEvent.
+ */
+template<typename Encoder, bool isArray, ValueType valueType>
+struct ParamEncoderBase {
+    static constexpr bool IS_ARRAY = isArray;
+    static constexpr ValueType VALUE_TYPE = valueType;
+
+    static size_t GetEncodedKeySize(std::string_view key)
+    {
+        return RawDataEncoder::StringValueEncodedSize(key) + RawDataEncoder::ValueTypeEncodedSize();
+    }
+
+    static bool EncodeKey(RawData& data, std::string_view key)
+    {
+        return RawDataEncoder::StringValueEncoded(data, key) &&
+            RawDataEncoder::ValueTypeEncoded(data, IS_ARRAY, VALUE_TYPE, 0);
+    }
+
+    template<typename V>
+    static size_t GetEncodedSize(std::string_view key, const V& val)
+    {
+        return GetEncodedKeySize(key) + Encoder::GetEncodedValueSize(val);
+    }
+
+    template<typename V>
+    static bool Encode(RawData& data, std::string_view key, const V& val)
+    {
+        return EncodeKey(data, key) && Encoder::EncodeValue(data, val);
+    }
+};
+
+template<typename T>
+struct UnsignedVarintParamEncoder : ParamEncoderBase<UnsignedVarintParamEncoder<T>, false, ValueType::UINT64> {
+    static size_t GetEncodedValueSize(T val)
+    {
+        return RawDataEncoder::UnsignedVarintEncodedSize(val);
+    }
+
+    static bool EncodeValue(RawData& data, T val)
+    {
+        return RawDataEncoder::UnsignedVarintEncoded(data, EncodeType::VARINT, val);
+    }
+};
+
+template<typename T>
+struct UnsignedVarintArrayParamEncoder :
+    ParamEncoderBase<UnsignedVarintArrayParamEncoder<T>, true, ValueType::UINT64> {
+    template<typename Container>
+    static size_t GetEncodedValueSize(const Container& vals)
+    {
+        size_t size = GetEncodedArraySize(vals);
+        size_t encodedSize = RawDataEncoder::UnsignedVarintEncodedSize(size);
+        auto item = vals.begin();
+        for (size_t index = 0; index < size; ++index, ++item) {
+            encodedSize += RawDataEncoder::UnsignedVarintEncodedSize(static_cast<T>(*item));
+        }
+        return encodedSize;
+    }
+
+    template<typename Container>
+    static bool EncodeValue(RawData& data, const Container& vals)
+    {
+        size_t size = GetEncodedArraySize(vals);
+        return RawDataEncoder::UnsignedVarintEncoded(data, EncodeType::LENGTH_DELIMITED, size) &&
+            RawDataEncoder::UnsignedVarintArrayEncoded<T>(data, vals.begin(), size);
+    }
+};
+
+template<typename T>
+struct SignedVarintParamEncoder : ParamEncoderBase<SignedVarintParamEncoder<T>, false, ValueType::INT64> {
+    static size_t GetEncodedValueSize(T val)
+    {
+        return RawDataEncoder::SignedVarintEncodedSize(val);
+    }
+
+    static bool EncodeValue(RawData& data, T val)
+    {
+        return RawDataEncoder::SignedVarintEncoded(data, EncodeType::VARINT, val);
+    }
+};
+
+template<typename T>
+struct SignedVarintArrayParamEncoder : ParamEncoderBase<SignedVarintArrayParamEncoder<T>, true, ValueType::INT64> {
+    template<typename Container>
+    static size_t GetEncodedValueSize(const Container& vals)
+    {
+        size_t size = GetEncodedArraySize(vals);
+        size_t encodedSize = RawDataEncoder::UnsignedVarintEncodedSize(size);
+        auto item = vals.begin();
+        for (size_t index = 0; index < size; ++index, ++item) {
+            encodedSize += RawDataEncoder::SignedVarintEncodedSize(static_cast<T>(*item));
+        }
+        return encodedSize;
+    }
+
+    template<typename Container>
+    static bool EncodeValue(RawData& data, const Container& vals)
+    {
+        size_t size = GetEncodedArraySize(vals);
+        return RawDataEncoder::UnsignedVarintEncoded(data, EncodeType::LENGTH_DELIMITED, size) &&
+            RawDataEncoder::SignedVarintArrayEncoded<T>(data, vals.begin(), size);
+    }
+};
+
+template<typename T>
+inline constexpr ValueType FLOATING_NUMBER_VALUE_TYPE = std::is_same_v<std::decay_t<T>, float> ? ValueType::FLOAT :
+    (std::is_same_v<std::decay_t<T>, double> ? ValueType::DOUBLE : ValueType::UNKNOWN);
+
+template<typename T>
+struct FloatingNumberParamEncoder :
+    ParamEncoderBase<FloatingNumberParamEncoder<T>, false, FLOATING_NUMBER_VALUE_TYPE<T>> {
+    static size_t GetEncodedValueSize(T)
+    {
+        return RawDataEncoder::FloatingNumberEncodedSize<T>();
+    }
+
+    static bool EncodeValue(RawData& data, T val)
+    {
+        return RawDataEncoder::FloatingNumberEncoded(data, static_cast<T>(std::isfinite(val) ? val : 0.0));
+    }
+};
+
+template<typename T>
+struct FloatingNumberArrayParamEncoder :
+    ParamEncoderBase<FloatingNumberArrayParamEncoder<T>, true, FLOATING_NUMBER_VALUE_TYPE<T>> {
+    template<typename Container>
+    static size_t GetEncodedValueSize(const Container& vals)
+    {
+        size_t size = GetEncodedArraySize(vals);
+        return RawDataEncoder::UnsignedVarintEncodedSize(size) + size * RawDataEncoder::FloatingNumberEncodedSize<T>();
+    }
+
+    template<typename Container>
+    static bool EncodeValue(RawData& data, const Container& vals)
+    {
+        size_t size = GetEncodedArraySize(vals);
+        bool ret = RawDataEncoder::UnsignedVarintEncoded(data, EncodeType::LENGTH_DELIMITED, size);
+        auto item = vals.begin();
+        for (size_t index = 0; ret && index < size; ++index, ++item) {
+            T val = static_cast<T>(*item);
+            ret = RawDataEncoder::FloatingNumberEncoded(data, static_cast<T>(std::isfinite(val) ? val : 0.0));
+        }
+        return ret;
+    }
+};
+
+// the string value will be escaped while it is encoded
+struct StringParamEncoder : ParamEncoderBase<StringParamEncoder, false, ValueType::STRING> {
+    static size_t GetEncodedValueSize(std::string_view val)
+    {
+        return RawDataEncoder::EscapedStringValueEncodedSize(val);
+    }
+
+    static bool EncodeValue(RawData& data, std::string_view val)
+    {
+        return RawDataEncoder::EscapedStringValueEncoded(data, val);
+    }
+};
+
+struct StringArrayParamEncoder : ParamEncoderBase<StringArrayParamEncoder, true, ValueType::STRING> {
+    template<typename Container>
+    static size_t GetEncodedValueSize(const Container& vals)
+    {
+        size_t size = GetEncodedArraySize(vals);
+        size_t encodedSize = RawDataEncoder::UnsignedVarintEncodedSize(size);
+        auto item = vals.begin();
+        for (size_t index = 0; index < size; ++index, ++item) {
+            encodedSize += RawDataEncoder::EscapedStringValueEncodedSize(*item);
+        }
+        return encodedSize;
+    }
+
+    template<typename Container>
+    static bool EncodeValue(RawData& data, const Container& vals)
+    {
+        size_t size = GetEncodedArraySize(vals);
+        bool ret = RawDataEncoder::UnsignedVarintEncoded(data, EncodeType::LENGTH_DELIMITED, size);
+        auto item = vals.begin();
+        for (size_t index = 0; ret && index < size; ++index, ++item) {
+            ret = RawDataEncoder::EscapedStringValueEncoded(data, *item);
+        }
+        return ret;
+    }
+};
+
+// select the encoder of a param by type of its value, the type is void if no encoder matches
+template<typename T, typename = void>
+struct ParamEncoderSelector {
+    using Type = void;
+};
+
+template<typename T>
+struct ParamEncoderSelector<T, std::enable_if_t<std::is_same_v<T, bool>>> {
+    using Type = SignedVarintParamEncoder<bool>;
+};
+
+template<typename T>
+struct ParamEncoderSelector<T, std::enable_if_t<std::is_same_v<T, char>>> {
+    using Type = SignedVarintParamEncoder<int8_t>;
+};
+
+template<typename T>
+struct ParamEncoderSelector<T, std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool> &&
+    !std::is_same_v<T, char> && std::is_signed_v<T>>> {
+    using Type = SignedVarintParamEncoder<int64_t>;
+};
+
+template<typename T>
+struct ParamEncoderSelector<T, std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool> &&
+    !std::is_same_v<T, char> && std::is_unsigned_v<T>>> {
+    using Type = UnsignedVarintParamEncoder<uint64_t>;
+};
+
+template<typename T>
+struct ParamEncoderSelector<T, std::enable_if_t<std::is_floating_point_v<T>>> {
+    using Type = FloatingNumberParamEncoder<T>;
+};
+
+template<typename T>
+struct ParamEncoderSelector<T, std::enable_if_t<std::is_convertible_v<T, std::string_view>>> {
+    using Type = StringParamEncoder;
+};
+
+template<typename T>
+struct ParamEncoderSelector<std::vector<T>, std::enable_if_t<std::is_same_v<T, bool>>> {
+    using Type = SignedVarintArrayParamEncoder<bool>;
+};
+
+template<typename T>
+struct ParamEncoderSelector<std::vector<T>, std::enable_if_t<std::is_same_v<T, char>>> {
+    using Type = SignedVarintArrayParamEncoder<int8_t>;
+};
+
+template<typename T>
+struct ParamEncoderSelector<std::vector<T>, std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool> &&
+    !std::is_same_v<T, char> && std::is_signed_v<T>>> {
+    using Type = SignedVarintArrayParamEncoder<int64_t>;
+};
+
+template<typename T>
+struct ParamEncoderSelector<std::vector<T>, std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool> &&
+    !std::is_same_v<T, char> && std::is_unsigned_v<T>>> {
+    using Type = UnsignedVarintArrayParamEncoder<uint64_t>;
+};
+
+template<typename T>
+struct ParamEncoderSelector<std::vector<T>, std::enable_if_t<std::is_floating_point_v<T>>> {
+    using Type = FloatingNumberArrayParamEncoder<T>;
+};
+
+template<typename T>
+struct ParamEncoderSelector<std::vector<T>, std::enable_if_t<std::is_convertible_v<T, std::string_view>>> {
+    using Type = StringArrayParamEncoder;
+};
+
+inline size_t GetEncodedParamsSize()
+{
+    return 0;
+}
+
+// sizing pass over the key-value pairs of an event, which is same as the size after they are encoded
+template<typename K, typename V, typename... Types>
+inline size_t GetEncodedParamsSize(const K& key, const V& value, const Types&... keyValues)
+{
+    using Encoder = typename ParamEncoderSelector<std::decay_t<V>>::Type;
+    size_t size = 0;
+    if constexpr (std::is_convertible_v<const K&, std::string_view> && !std::is_void_v<Encoder>) {
+        size = Encoder::GetEncodedSize(std::string_view(key), value);
+    }
+    return size + GetEncodedParamsSize(keyValues...);
+}
+} // namespace Encoded
+} // namespace HiviewDFX
+} // namespace OHOS
+
+#endif // HISYSEVENT_INTERFACE_ENCODE_INCLUDE_PARAM_ENCODER_H
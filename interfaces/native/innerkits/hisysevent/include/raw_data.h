@@ -36,9 +36,12 @@ public:
 public:
     bool Append(uint8_t* data, size_t len);
     bool Update(uint8_t* data, size_t len, size_t pos);
+    bool Reserve(size_t capacity);
     bool IsEmpty();
+    void Reset();
     uint8_t* GetData() const;
     size_t GetDataLength() const;
+    size_t GetCapacity() const;
 
 private:
     uint8_t* data_ = nullptr;
@@ -39,6 +39,7 @@ constexpr char BASE_INFO_KEY_TRACE_ID[] = "traceid_";
 constexpr char BASE_INFO_KEY_SPAN_ID[] = "spanid_";
 constexpr char BASE_INFO_KEY_PARENT_SPAN_ID[] = "pspanid_";
 constexpr char BASE_INFO_KEY_TRACE_FLAG[] = "trace_flag_";
+constexpr char BASE_INFO_KEY_SAMPLE_RATE[] = "sample_rate_";
 
 #pragma pack(1)
 struct HiSysEventHeader {
@@ -21,6 +21,7 @@
 #include <cstdint>
 #include <limits>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "raw_data_base_def.h"
@@ -50,6 +51,9 @@ public:
     static bool ValueTypeEncoded(RawData& data, bool isArray, ValueType valueType,
         uint8_t count);
     static bool StringValueEncoded(RawData& data, const std::string& val);
+    static bool StringValueEncoded(RawData& data, std::string_view val);
+    // escape the string value by StringFilter while encoding it
+    static bool EscapedStringValueEncoded(RawData& data, std::string_view val);
 
 public:
     // uintx_t -> uint64_t
@@ -59,32 +63,16 @@ public:
         if constexpr (!isUnsignedNum<T>) {
             return false;
         }
-        uint8_t cpyVal = EncodedTag(static_cast<uint8_t>(type)) | ((val < TAG_BYTE_BOUND) ? 0 : TAG_BYTE_BOUND) |
-            static_cast<uint8_t>(val & TAG_BYTE_MASK);
-        if (!data.Append(reinterpret_cast<uint8_t*>(&cpyVal), 1)) {
-            return false;
-        }
-        val >>= TAG_BYTE_OFFSET;
-        while (val > 0) {
-            cpyVal = ((val < NON_TAG_BYTE_BOUND) ? 0 : NON_TAG_BYTE_BOUND) |
-                static_cast<uint8_t>(val & NON_TAG_BYTE_MASK);
-            if (!data.Append(reinterpret_cast<uint8_t*>(&cpyVal), 1)) {
-                return false;
-            }
-            val >>= NON_TAG_BYTE_OFFSET;
-        }
-        return true;
+        uint8_t bytes[MAX_VARINT_ENCODED_SIZE];
+        return data.Append(bytes, VarintEncoded(bytes, EncodedTag(static_cast<uint8_t>(type)),
+            static_cast<uint64_t>(val)));
     }
 
     // bool, intx_t -> int64_t
     template<typename T>
     static bool SignedVarintEncoded(RawData& data, const EncodeType type, T val)
     {
-        int64_t valInt64 = static_cast<int64_t>(val);
-        // zigzag encode
-        uint64_t signMask = (val >= 0) ? 0 : std::numeric_limits<uint64_t>::max();
-        uint64_t uValInt64 = (static_cast<uint64_t>(valInt64) << 1) ^ signMask;
-        return UnsignedVarintEncoded(data, type, uValInt64);
+        return UnsignedVarintEncoded(data, type, ZigzagEncoded(val));
     }
 
     // float, double => double
@@ -101,9 +89,129 @@ public:
         return true;
     }
 
+    // uintx_t[] -> uint64_t[], items are encoded into a block on stack which is appended to raw data at once
+    template<typename T, typename Iterator>
+    static bool UnsignedVarintArrayEncoded(RawData& data, Iterator item, size_t size)
+    {
+        return VarintArrayEncoded<T, false>(data, item, size);
+    }
+
+    // bool[], intx_t[] -> int64_t[]
+    template<typename T, typename Iterator>
+    static bool SignedVarintArrayEncoded(RawData& data, Iterator item, size_t size)
+    {
+        return VarintArrayEncoded<T, true>(data, item, size);
+    }
+
+public:
+    // sizes of the encoded data, which are used to reserve memory of raw data before encoding
+    template<typename T>
+    static constexpr size_t UnsignedVarintEncodedSize(T val)
+    {
+        uint64_t leftVal = static_cast<uint64_t>(val) >> TAG_BYTE_OFFSET;
+        return (leftVal == 0) ? 1 : (1 + NonTagByteCnt(leftVal)); // 1 byte with tag
+    }
+
+    template<typename T>
+    static constexpr size_t SignedVarintEncodedSize(T val)
+    {
+        return UnsignedVarintEncodedSize(ZigzagEncoded(val));
+    }
+
+    template<typename T>
+    static constexpr size_t FloatingNumberEncodedSize()
+    {
+        return UnsignedVarintEncodedSize(sizeof(T)) + sizeof(T);
+    }
+
+    static constexpr size_t ValueTypeEncodedSize()
+    {
+        return sizeof(struct ParamValueType);
+    }
+
+    static constexpr size_t StringValueEncodedSize(std::string_view val)
+    {
+        return UnsignedVarintEncodedSize(val.length()) + val.length();
+    }
+
+    static size_t EscapedStringValueEncodedSize(std::string_view val);
+
 private:
     static uint8_t EncodedTag(uint8_t type);
 
+    template<typename T>
+    static constexpr uint64_t ZigzagEncoded(T val)
+    {
+        int64_t valInt64 = static_cast<int64_t>(val);
+        uint64_t signMask = (val >= 0) ? 0 : std::numeric_limits<uint64_t>::max();
+        return (static_cast<uint64_t>(valInt64) << 1) ^ signMask;
+    }
+
+    template<typename T, bool isSigned, typename Iterator>
+    static bool VarintArrayEncoded(RawData& data, Iterator item, size_t size)
+    {
+        uint8_t block[VARINT_BLOCK_SIZE + MAX_VARINT_ENCODED_SIZE];
+        size_t blockLen = 0;
+        for (size_t index = 0; index < size; ++index, ++item) {
+            T val = static_cast<T>(*item);
+            if constexpr (isSigned) {
+                blockLen += VarintEncoded(block + blockLen, VARINT_TAG, ZigzagEncoded(val));
+            } else {
+                blockLen += VarintEncoded(block + blockLen, VARINT_TAG, static_cast<uint64_t>(val));
+            }
+            if (blockLen < VARINT_BLOCK_SIZE) {
+                continue;
+            }
+            if (!data.Append(block, blockLen)) {
+                return false;
+            }
+            blockLen = 0;
+        }
+        return data.Append(block, blockLen);
+    }
+
+    // encode the value without any branch for each byte, the destination must have MAX_VARINT_ENCODED_SIZE
+    // bytes at least, and the count of bytes encoded is returned
+    static size_t VarintEncoded(uint8_t* dst, uint8_t tag, uint64_t val)
+    {
+        uint64_t leftVal = val >> TAG_BYTE_OFFSET;
+        if (leftVal == 0) {
+            dst[0] = tag | static_cast<uint8_t>(val);
+            return 1;
+        }
+        dst[0] = tag | TAG_BYTE_BOUND | static_cast<uint8_t>(val & TAG_BYTE_MASK);
+        size_t cnt = NonTagByteCnt(leftVal);
+        uint64_t bytes = SpreadToBytes(leftVal);
+        if (cnt > BYTES_OF_UINT64) {
+            bytes |= CONTINUED_BYTES_MASK;
+            dst[BYTES_OF_UINT64 + 1] = static_cast<uint8_t>(leftVal >> (BYTES_OF_UINT64 * NON_TAG_BYTE_OFFSET));
+        } else {
+            bytes |= CONTINUED_BYTES_MASK & ((1ULL << ((cnt - 1) * BITS_OF_BYTE)) - 1);
+        }
+        // stores of the bytes are merged into one by compiler
+        for (size_t i = 0; i < BYTES_OF_UINT64; ++i) {
+            dst[i + 1] = static_cast<uint8_t>(bytes >> (i * BITS_OF_BYTE));
+        }
+        return 1 + cnt;
+    }
+
+    // count of bytes without tag to encode the value left after the byte with tag
+    static constexpr size_t NonTagByteCnt(uint64_t leftVal)
+    {
+        size_t bitCnt = BITS_OF_UINT64 - static_cast<size_t>(__builtin_clzll(leftVal));
+        return (bitCnt + NON_TAG_BYTE_OFFSET - 1) / NON_TAG_BYTE_OFFSET;
+    }
+
+    // spread low 56 bits of the value into low 7 bits of each byte
+    static constexpr uint64_t SpreadToBytes(uint64_t val)
+    {
+        uint64_t bytes = val & 0x00FFFFFFFFFFFFFFULL;
+        bytes = ((bytes & 0x00FFFFFFF0000000ULL) << 4) | (bytes & 0x000000000FFFFFFFULL); // 28 bits -> 32 bits
+        bytes = ((bytes & 0x0FFFC0000FFFC000ULL) << 2) | (bytes & 0x00003FFF00003FFFULL); // 14 bits -> 16 bits
+        bytes = ((bytes & 0x3F803F803F803F80ULL) << 1) | (bytes & 0x007F007F007F007FULL); // 7 bits -> 8 bits
+        return bytes;
+    }
+
 private:
     static constexpr unsigned int TAG_BYTE_OFFSET = 5;
     static constexpr unsigned int TAG_BYTE_BOUND  = (1 << TAG_BYTE_OFFSET);
@@ -112,6 +220,14 @@ private:
     static constexpr unsigned int NON_TAG_BYTE_OFFSET = 7;
     static constexpr unsigned int NON_TAG_BYTE_BOUND = (1 << NON_TAG_BYTE_OFFSET);
     static constexpr unsigned int NON_TAG_BYTE_MASK = (NON_TAG_BYTE_BOUND - 1);
+
+    static constexpr uint8_t VARINT_TAG = static_cast<uint8_t>(EncodeType::VARINT) << (TAG_BYTE_OFFSET + 1);
+    static constexpr size_t BITS_OF_BYTE = 8;
+    static constexpr size_t BITS_OF_UINT64 = 64;
+    static constexpr size_t BYTES_OF_UINT64 = 8;
+    static constexpr uint64_t CONTINUED_BYTES_MASK = 0x8080808080808080ULL;
+    static constexpr size_t MAX_VARINT_ENCODED_SIZE = 10; // 5 bits with tag, then 7 bits of each byte
+    static constexpr size_t VARINT_BLOCK_SIZE = 256;
 };
 } // namespace Encoded
 } // namespace HiviewDFX
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HISYSEVENT_SHARED_MEMORY_RING_H
+#define HISYSEVENT_SHARED_MEMORY_RING_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+#include "event_socket_factory.h"
+#include "raw_data.h"
+#include "raw_data_base_def.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+using namespace Encoded;
+static constexpr uint32_t SHARED_MEMORY_RING_MAGIC = 0x48535952; // "HSYR"
+static constexpr uint32_t SHARED_MEMORY_RING_VERSION = 1;
+
+/*
+ * Layout of the shared memory: the header is followed by the entries, each entry is a SharedMemoryRingEntry followed
+ * by the data of one event, and aligned by 8 bytes. Entries are reserved by producers of any process mapping the
+ * memory, and the region consumed is cleared by the consumer before it is released.
+ */
+struct SharedMemoryRingHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t capacity; // bytes of the entries, which is a power of 2
+    alignas(64) std::atomic<uint64_t> writePos;
+    alignas(64) std::atomic<uint64_t> readPos;
+    std::atomic<uint32_t> isConsumerWaiting;
+    std::atomic<uint32_t> isConsumerAttached; // nothing is wrote into the ring before the consumer maps it
+};
+
+struct SharedMemoryRingEntry {
+    std::atomic<uint32_t> state;
+    uint32_t len;
+};
+
+// message sent to the daemon together with the memfd and the eventfd of the ring
+struct SharedMemoryRingHandshake {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t pid;
+    uint64_t size;
+};
+
+class SharedMemoryRing {
+public:
+    SharedMemoryRing() = default;
+    ~SharedMemoryRing();
+    SharedMemoryRing& operator=(const SharedMemoryRing&) = delete;
+    SharedMemoryRing(const SharedMemoryRing&) = delete;
+
+    bool Init(size_t capacity);
+    int HandOver(const EventSocket& daemonAddr);
+    int Write(const RawData& rawData);
+    // the consumer is taken as stalled if the read position isn't advanced since the ring was found full timeout ms ago
+    bool IsConsumerStalled(uint64_t timeout);
+    int GetMemFd() const;
+    int GetEventFd() const;
+
+private:
+    void RingDoorbell();
+
+private:
+    int memFd_ = -1;
+    int eventFd_ = -1;
+    size_t size_ = 0;
+    SharedMemoryRingHeader* header_ = nullptr;
+    uint8_t* entries_ = nullptr;
+    std::atomic<uint64_t> fullReadPos_ { UINT64_MAX };
+    std::atomic<uint64_t> fullTime_ { 0 };
+};
+
+// reference consumer of the ring, which decodes the events wrote into the ring
+class SharedMemoryRingConsumer {
+public:
+    using EventHandler = std::function<void(const HiSysEventHeader& header, const uint8_t* data, size_t len)>;
+
+    SharedMemoryRingConsumer() = default;
+    ~SharedMemoryRingConsumer();
+    SharedMemoryRingConsumer& operator=(const SharedMemoryRingConsumer&) = delete;
+    SharedMemoryRingConsumer(const SharedMemoryRingConsumer&) = delete;
+
+    bool Accept(int socketId);
+    bool Attach(int memFd, int eventFd);
+    size_t Consume(const EventHandler& handler);
+    bool Wait(int timeout);
+
+private:
+    bool HasCommittedEntry() const;
+
+private:
+    int memFd_ = -1;
+    int eventFd_ = -1;
+    size_t size_ = 0;
+    SharedMemoryRingHeader* header_ = nullptr;
+    uint8_t* entries_ = nullptr;
+};
+} // namespace HiviewDFX
+} // namespace OHOS
+
+#endif // HISYSEVENT_SHARED_MEMORY_RING_H
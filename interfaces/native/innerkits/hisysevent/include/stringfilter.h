@@ -17,17 +17,45 @@
 #define HISYSEVENT_STRING_FILTER_H
 
 #include <string>
+#include <string_view>
 
 namespace OHOS {
 namespace HiviewDFX {
+namespace Encoded {
+class RawData;
+}
+
 class StringFilter {
 public:
     StringFilter();
     ~StringFilter() {}
     // Transform special char to escaped form ("lookup table" method)
     std::string EscapeToRaw(const std::string &text);
+    // Transform special char to escaped form, and append the result to raw data directly
+    bool EscapeToRaw(std::string_view text, Encoded::RawData& rawData);
+    // Length of the text after transformed into escaped form
+    size_t GetEscapedLength(std::string_view text);
+    // Check whether there is any char to be transformed or ignored in the text
+    bool IsEscapeNeeded(std::string_view text);
     // Check lexical ("finite state machine" method)
     bool IsValidName(const std::string &text, unsigned int maxSize);
+    bool IsValidName(std::string_view text, unsigned int maxSize);
+    // Check lexical in compile time, the rules are same with IsValidName
+    static constexpr bool IsValidConstName(std::string_view text, unsigned int maxSize)
+    {
+        if (text.empty() || text.length() > maxSize) {
+            return false;
+        }
+        for (size_t index = 0; index < text.length(); ++index) {
+            char c = text[index];
+            bool isAlpha = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+            bool isValid = (index == 0) ? isAlpha : (isAlpha || (c >= '0' && c <= '9') || c == '_');
+            if (!isValid) {
+                return false;
+            }
+        }
+        return true;
+    }
     static StringFilter& GetInstance();
 
 private:
@@ -16,11 +16,17 @@
 #ifndef HISYSEVENT_TRANSPORT_H
 #define HISYSEVENT_TRANSPORT_H
 
-#include <list>
-#include <mutex>
+#include <atomic>
+#include <cstdint>
 #include <string>
+#include <vector>
 
+#include "congestion_control.h"
+#include "event_socket_factory.h"
+#include "io_uring_sender.h"
 #include "raw_data.h"
+#include "shared_memory_ring.h"
+#include "transport_backend.h"
 
 namespace OHOS {
 namespace HiviewDFX {
@@ -29,27 +35,66 @@ class Transport {
 public:
     static Transport& GetInstance();
     int SendData(RawData& rawData);
+    // the server has been decided by the caller, so it's not parsed out of the data again
+    int SendData(RawData& rawData, const EventSocket& serverAddr);
+    void SendData(RawData* const rawDatas[], size_t cnt, int retCodes[]);
+    CongestionStats GetCongestionStats(const EventSocket& serverAddr);
+    int EnableSharedMemoryRing(const EventSocket& daemonAddr);
+    // the ring is disabled as well once its consumer stalls, and it may be handed over again by enabling
+    void DisableSharedMemoryRing();
+    int SetIoUringEnabled(bool isEnabled);
+    IoUringStats GetIoUringStats();
+    // data failed to be sent is appended to the journal rather than the retry queue once it's enabled
+    int EnableEventJournal(const std::string& dir, size_t capacity);
+    // events are handed over to the backend rather than the servers, nullptr restores the builtin transport.
+    // the backend is owned by the caller, which is kept until no event is being sent to it
+    void SetBackend(TransportBackend* backend);
 
 private:
     Transport() {}
-    ~Transport() {}
+    ~Transport();
     Transport& operator=(const Transport&) = delete;
     Transport(const Transport&) = delete;
     Transport& operator=(const Transport&&) = delete;
     Transport(const Transport&&) = delete;
 
 private:
-    void AddFailedData(RawData& rawData);
+    void AddFailedData(const RawData& rawData);
+    int ConnectToServer(const EventSocket& serverAddr, int& socketId);
+    CongestionControl& GetCongestionControl(const EventSocket& serverAddr);
     void InitRecvBuffer(int socketId);
     void RetrySendFailedData();
-    int SendToHiSysEventDataSource(RawData& rawData);
+    int SendToHiSysEventDataSource(const EventSocket& serverAddr, RawData& rawData);
+    void SendToHiSysEventDataSource(const EventSocket& serverAddr, RawData* const rawDatas[],
+        const std::vector<size_t>& indexes, int retCodes[]);
+    int SendByIoUring(const EventSocket& serverAddr, RawData& rawData);
+    bool WriteToSharedMemoryRing(const RawData& rawData);
 
 private:
     static Transport instance_;
     static constexpr std::size_t RETRY_QUEUE_SIZE = 10;
     static constexpr int RETRY_TIMES = 3;
-    std::mutex mutex_;
-    std::list<RawData> retryDataList_;
+    static constexpr std::size_t MAX_SERVER_CNT = 4;
+    static constexpr std::size_t MAX_MSG_CNT_OF_BATCH = 1024; // UIO_MAXIOV
+    static constexpr std::size_t SHARED_MEMORY_RING_SIZE = 1024 * 1024; // 1M
+    static constexpr uint64_t SHARED_MEMORY_RING_STALL_TIMEOUT = 1000; // 1000ms
+    static constexpr int64_t SHARED_MEMORY_RING_RELEASE_TIMEOUT = 100; // 100ms
+    // ring of owned data failed to send, the oldest one is overwritten if the ring is full
+    std::atomic<RawData*> retryDataSlots_[RETRY_QUEUE_SIZE] {};
+    std::atomic<uint32_t> retryDataTail_ { 0 };
+    std::atomic<int32_t> retryDataCnt_ { 0 };
+    std::atomic_flag isRetrying_ = ATOMIC_FLAG_INIT;
+    // congestion of each server, which is bound to the server address once it is sent to
+    std::atomic<const EventSocket*> congestedServers_[MAX_SERVER_CNT] {};
+    CongestionControl congestionControls_[MAX_SERVER_CNT];
+    CongestionControl sharedCongestionControl_;
+    // ring shared with the daemon once it is handed over, sockets are used if the ring is full
+    std::atomic<SharedMemoryRing*> sharedMemoryRing_ { nullptr };
+    std::atomic<uint32_t> ringWriterCnt_ { 0 };
+    // io_uring shared by all threads, which is never used by the child process after fork
+    std::atomic<IoUringSender*> ioUringSender_ { nullptr };
+    std::atomic<bool> isIoUringEnabled_ { false };
+    std::atomic<TransportBackend*> backend_ { nullptr };
 };
 } // namespace HiviewDFX
 } // namespace OHOS
@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HISYSEVENT_TRANSPORT_BACKEND_H
+#define HISYSEVENT_TRANSPORT_BACKEND_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+
+#include "event_socket_factory.h"
+#include "raw_data.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+using namespace Encoded;
+// backend which the transport hands the events over to instead of the servers of hiview
+class TransportBackend {
+public:
+    virtual ~TransportBackend() = default;
+    // the server is the one the event is routed to, which is ignored by backends with their own destination
+    virtual int Send(RawData& rawData, const EventSocket& serverAddr) = 0;
+};
+
+// events are sent by a unix datagram socket to the server routed, or to the socket path configured if any
+class UnixSocketBackend : public TransportBackend {
+public:
+    explicit UnixSocketBackend(const std::string& socketPath = "");
+    ~UnixSocketBackend() override;
+    UnixSocketBackend& operator=(const UnixSocketBackend&) = delete;
+    UnixSocketBackend(const UnixSocketBackend&) = delete;
+
+    int Send(RawData& rawData, const EventSocket& serverAddr) override;
+
+private:
+    int socketId_ = -1;
+    bool isPathConfigured_ = false;
+    EventSocket serverAddr_ = {};
+};
+
+struct CaptureStats {
+    uint64_t capturedCnt = 0;
+    uint64_t capturedBytes = 0;
+    uint64_t droppedCnt = 0;
+};
+
+/*
+ * Events are captured in memory without any lock or system call, so the encoding is measured without the daemon.
+ * Events are counted only if the capacity is 0, otherwise they are kept until the capacity is used up.
+ */
+class CaptureBackend : public TransportBackend {
+public:
+    explicit CaptureBackend(size_t capacity = 0);
+    ~CaptureBackend() override = default;
+    CaptureBackend& operator=(const CaptureBackend&) = delete;
+    CaptureBackend(const CaptureBackend&) = delete;
+
+    int Send(RawData& rawData, const EventSocket& serverAddr) override;
+    // events are visited in the order they are captured, neither is called while events are being sent
+    size_t ForEach(const std::function<void(const uint8_t*, size_t)>& visitor) const;
+    void Reset();
+    CaptureStats GetStats() const;
+
+private:
+    std::unique_ptr<uint8_t[]> buffer_;
+    size_t capacity_ = 0;
+    std::atomic<size_t> usedSize_ { 0 };
+    std::atomic<uint64_t> capturedCnt_ { 0 };
+    std::atomic<uint64_t> capturedBytes_ { 0 };
+    std::atomic<uint64_t> droppedCnt_ { 0 };
+};
+} // namespace HiviewDFX
+} // namespace OHOS
+
+#endif // HISYSEVENT_TRANSPORT_BACKEND_H
@@ -16,6 +16,8 @@
 #ifndef WRITE_CONTROLLER_H
 #define WRITE_CONTROLLER_H
 
+#include <atomic>
+#include <cstdint>
 #include <list>
 #include <mutex>
 #include <sys/time.h>
@@ -38,18 +40,26 @@ using CallerInfo = struct {
     uint64_t timeStamp;
 };
 
-class EventWroteLruCache;
+// events wrote at one call site in current period, which is updated without any lock
+struct WriteControlSlot {
+    std::atomic<uint64_t> state { 0 }; // start second of the period in high 40 bits, count of events in low 24 bits
+};
 
 class WriteController {
 public:
     static uint64_t GetCurrentTimeMills();
+    // call sites are looked up by event name, function and line in the registry shared by all threads
     static uint64_t CheckLimitWritingEvent(const ControlParam& param, const char* domain, const char* eventName,
         const CallerInfo& callerInfo);
     static uint64_t CheckLimitWritingEvent(const ControlParam& param, const char* domain, const char* eventName,
         const char* func, int64_t line);
+    // call site owns the slot, which is a static variable of the site whose event name is constant
+    static uint64_t CheckLimitWritingEvent(const ControlParam& param, WriteControlSlot& slot, const char* domain,
+        const char* eventName, const char* func);
 
 private:
-    static EventWroteLruCache eventWroteLruCache_;
+    static uint64_t CheckLimitWritingEvent(const ControlParam& param, WriteControlSlot& slot, const char* domain,
+        const char* eventName, const char* func, uint64_t timeStamp);
 };
 } // HiviewDFX
 } // OHOS
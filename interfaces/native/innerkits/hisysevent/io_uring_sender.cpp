@@ -0,0 +1,318 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "io_uring_sender.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <linux/io_uring.h>
+#include <pthread.h>
+#include <securec.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include "def.h"
+#include "hilog/log.h"
+
+#undef LOG_DOMAIN
+#define LOG_DOMAIN 0xD002D08
+
+#undef LOG_TAG
+#define LOG_TAG "HISYSEVENT_IO_URING_SENDER"
+
+namespace OHOS {
+namespace HiviewDFX {
+namespace {
+constexpr uint64_t SERVER_INDEX_OFFSET = 32; // user data of request: server index << 32 | slot index
+constexpr uint64_t SLOT_INDEX_MASK = 0xFFFFFFFF;
+constexpr char REAPER_NAME[] = "HiSysEventIoUrg";
+
+inline int IoUringSetup(unsigned entries, struct io_uring_params* params)
+{
+    return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+}
+
+inline int IoUringEnter(int ringFd, unsigned toSubmit)
+{
+    return static_cast<int>(syscall(__NR_io_uring_enter, ringFd, toSubmit, 0, 0, nullptr, 0));
+}
+
+inline int IoUringRegister(int ringFd, unsigned opcode, void* arg, unsigned argCnt)
+{
+    return static_cast<int>(syscall(__NR_io_uring_register, ringFd, opcode, arg, argCnt));
+}
+
+void* MapQueue(int ringFd, size_t size, off_t offset)
+{
+    void* addr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, offset);
+    return (addr == MAP_FAILED) ? nullptr : addr;
+}
+
+inline bool IsServerGone(int err)
+{
+    return err == ECONNREFUSED || err == ENOTCONN || err == ECONNRESET;
+}
+}
+
+IoUringSender::~IoUringSender()
+{
+    if (reaper_.joinable()) {
+        isReaperStopped_.store(true);
+        uint64_t cnt = 1;
+        (void)TEMP_FAILURE_RETRY(write(eventFd_, &cnt, sizeof(cnt)));
+        reaper_.join();
+    }
+    if (eventFd_ >= 0) {
+        close(eventFd_);
+    }
+    for (auto& socketId : serverSockets_) {
+        if (socketId >= 0) {
+            close(socketId);
+        }
+    }
+    if (buffers_ != nullptr) {
+        munmap(buffers_, SLOT_CNT * SLOT_SIZE);
+    }
+    if (sqes_ != nullptr) {
+        munmap(sqes_, sqesSize_);
+    }
+    if (cqRing_ != nullptr && cqRing_ != sqRing_) {
+        munmap(cqRing_, cqRingSize_);
+    }
+    if (sqRing_ != nullptr) {
+        munmap(sqRing_, sqRingSize_);
+    }
+    if (ringFd_ >= 0) {
+        close(ringFd_);
+    }
+}
+
+bool IoUringSender::Init()
+{
+    // io_uring may be unsupported by the kernel or forbidden by seccomp, which is found out at runtime
+    struct io_uring_params params = {};
+    ringFd_ = IoUringSetup(QUEUE_DEPTH, &params);
+    if (ringFd_ < 0) {
+        HILOG_DEBUG(LOG_CORE, "io_uring is unavailable, errno=%{public}d", errno);
+        return false;
+    }
+    if (!MapQueues(params)) {
+        HILOG_WARN(LOG_CORE, "failed to map queues of io_uring, errno=%{public}d", errno);
+        return false;
+    }
+    void* buffers = mmap(nullptr, SLOT_CNT * SLOT_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (buffers == MAP_FAILED) {
+        return false;
+    }
+    buffers_ = static_cast<uint8_t*>(buffers);
+    struct iovec iovs[SLOT_CNT];
+    for (size_t i = 0; i < SLOT_CNT; ++i) {
+        iovs[i].iov_base = buffers_ + i * SLOT_SIZE;
+        iovs[i].iov_len = SLOT_SIZE;
+    }
+    // sockets are registered once they are connected
+    int fds[MAX_SERVER_CNT] = { -1, -1, -1, -1 };
+    if (IoUringRegister(ringFd_, IORING_REGISTER_BUFFERS, iovs, SLOT_CNT) < 0 ||
+        IoUringRegister(ringFd_, IORING_REGISTER_FILES, fds, MAX_SERVER_CNT) < 0) {
+        HILOG_WARN(LOG_CORE, "failed to register buffers and files of io_uring, errno=%{public}d", errno);
+        return false;
+    }
+    // completions are reaped even if no more data is sent, so the failed data is retried in time
+    eventFd_ = eventfd(0, EFD_CLOEXEC);
+    if (eventFd_ < 0 || IoUringRegister(ringFd_, IORING_REGISTER_EVENTFD, &eventFd_, 1) < 0) {
+        HILOG_WARN(LOG_CORE, "failed to register eventfd of io_uring, errno=%{public}d", errno);
+        return false;
+    }
+    freeSlots_ = (SLOT_CNT == 64) ? ~0ULL : ((1ULL << SLOT_CNT) - 1); // 64: bits of the map
+    reaper_ = std::thread(&IoUringSender::RunReaper, this);
+    return true;
+}
+
+bool IoUringSender::MapQueues(const struct io_uring_params& params)
+{
+    sqRingSize_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cqRingSize_ = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    bool isSingleMmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (isSingleMmap) {
+        sqRingSize_ = std::max(sqRingSize_, cqRingSize_);
+        cqRingSize_ = sqRingSize_;
+    }
+    sqRing_ = MapQueue(ringFd_, sqRingSize_, IORING_OFF_SQ_RING);
+    if (sqRing_ == nullptr) {
+        return false;
+    }
+    cqRing_ = isSingleMmap ? sqRing_ : MapQueue(ringFd_, cqRingSize_, IORING_OFF_CQ_RING);
+    sqesSize_ = params.sq_entries * sizeof(struct io_uring_sqe);
+    sqes_ = static_cast<struct io_uring_sqe*>(MapQueue(ringFd_, sqesSize_, IORING_OFF_SQES));
+    if (cqRing_ == nullptr || sqes_ == nullptr) {
+        return false;
+    }
+    auto sqRing = static_cast<uint8_t*>(sqRing_);
+    sqHead_ = reinterpret_cast<unsigned*>(sqRing + params.sq_off.head);
+    sqTail_ = reinterpret_cast<unsigned*>(sqRing + params.sq_off.tail);
+    sqMask_ = *reinterpret_cast<unsigned*>(sqRing + params.sq_off.ring_mask);
+    sqArray_ = reinterpret_cast<unsigned*>(sqRing + params.sq_off.array);
+    auto cqRing = static_cast<uint8_t*>(cqRing_);
+    cqHead_ = reinterpret_cast<unsigned*>(cqRing + params.cq_off.head);
+    cqTail_ = reinterpret_cast<unsigned*>(cqRing + params.cq_off.tail);
+    cqMask_ = *reinterpret_cast<unsigned*>(cqRing + params.cq_off.ring_mask);
+    cqes_ = reinterpret_cast<struct io_uring_cqe*>(cqRing + params.cq_off.cqes);
+    return true;
+}
+
+int IoUringSender::Send(const EventSocket& serverAddr, const RawData& rawData)
+{
+    size_t len = rawData.GetDataLength();
+    if (len > SLOT_SIZE) {
+        return ERR_DOES_NOT_INIT; // sent by the socket of the caller
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    ReapCompletionsLocked();
+    int fileIndex = GetFileIndex(serverAddr);
+    if (fileIndex < 0) {
+        return ERR_DOES_NOT_INIT;
+    }
+    if (freeSlots_ == 0) {
+        // all buffers are in flight since the server lags, the caller never waits for it but sends by its socket
+        ++stats_.busyCnt;
+        return ERR_DOES_NOT_INIT;
+    }
+    auto slot = static_cast<unsigned>(__builtin_ctzll(freeSlots_));
+    uint8_t* buffer = buffers_ + slot * SLOT_SIZE;
+    if (memcpy_s(buffer, SLOT_SIZE, rawData.GetData(), len) != EOK) {
+        return ERR_RAW_DATA_WROTE_EXCEPTION;
+    }
+    unsigned tail = *sqTail_;
+    unsigned index = tail & sqMask_;
+    struct io_uring_sqe* sqe = &sqes_[index];
+    (void)memset_s(sqe, sizeof(*sqe), 0, sizeof(*sqe));
+    sqe->opcode = IORING_OP_WRITE_FIXED;
+    sqe->flags = IOSQE_FIXED_FILE;
+    sqe->fd = fileIndex;
+    sqe->addr = reinterpret_cast<uint64_t>(buffer);
+    sqe->len = static_cast<uint32_t>(len);
+    sqe->buf_index = static_cast<uint16_t>(slot);
+    sqe->user_data = (static_cast<uint64_t>(fileIndex) << SERVER_INDEX_OFFSET) | slot;
+    sqArray_[index] = index;
+    __atomic_store_n(sqTail_, tail + 1, __ATOMIC_RELEASE);
+    freeSlots_ &= ~(1ULL << slot);
+    slotDataLens_[slot] = static_cast<uint32_t>(len);
+    ++stats_.submittedCnt;
+    Submit();
+    return SUCCESS;
+}
+
+void IoUringSender::SetFailureHandler(const FailureHandler& handler)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    failureHandler_ = handler;
+}
+
+void IoUringSender::ReapCompletions()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    ReapCompletionsLocked();
+}
+
+void IoUringSender::RunReaper()
+{
+    pthread_setname_np(pthread_self(), REAPER_NAME);
+    uint64_t cnt = 0;
+    while (TEMP_FAILURE_RETRY(read(eventFd_, &cnt, sizeof(cnt))) == static_cast<ssize_t>(sizeof(cnt)) &&
+        !isReaperStopped_.load()) {
+        ReapCompletions();
+    }
+}
+
+IoUringStats IoUringSender::GetStats()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+int IoUringSender::GetFileIndex(const EventSocket& serverAddr)
+{
+    size_t index = 0;
+    while (index < MAX_SERVER_CNT && servers_[index] != nullptr && servers_[index] != &serverAddr) {
+        ++index;
+    }
+    if (index == MAX_SERVER_CNT) {
+        return -1;
+    }
+    if (servers_[index] != nullptr && serverSockets_[index] >= 0) {
+        return static_cast<int>(index);
+    }
+    // the socket is blocking, so the request waits in the kernel rather than fails while the server lags
+    int socketId = TEMP_FAILURE_RETRY(socket(AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC, 0));
+    if (socketId < 0) {
+        return -1;
+    }
+    int sendBuffSize = MAX_DATA_SIZE;
+    (void)setsockopt(socketId, SOL_SOCKET, SO_SNDBUF, static_cast<void*>(&sendBuffSize), sizeof(sendBuffSize));
+    struct io_uring_files_update update {};
+    update.offset = static_cast<uint32_t>(index);
+    update.fds = reinterpret_cast<uint64_t>(&socketId);
+    if (TEMP_FAILURE_RETRY(connect(socketId, reinterpret_cast<const sockaddr*>(&serverAddr),
+        sizeof(serverAddr))) < 0 || IoUringRegister(ringFd_, IORING_REGISTER_FILES_UPDATE, &update, 1) < 0) {
+        close(socketId);
+        return -1;
+    }
+    servers_[index] = &serverAddr;
+    serverSockets_[index] = socketId;
+    return static_cast<int>(index);
+}
+
+void IoUringSender::ReapCompletionsLocked()
+{
+    unsigned head = *cqHead_;
+    unsigned tail = __atomic_load_n(cqTail_, __ATOMIC_ACQUIRE);
+    for (; head != tail; ++head) {
+        const struct io_uring_cqe& cqe = cqes_[head & cqMask_];
+        auto slot = static_cast<size_t>(cqe.user_data & SLOT_INDEX_MASK);
+        freeSlots_ |= 1ULL << slot;
+        if (cqe.res >= 0) {
+            ++stats_.completedCnt;
+            continue;
+        }
+        ++stats_.failedCnt;
+        // the buffer is never reused before the lock is released, so the data failed is still there
+        RawData failedData;
+        if (failureHandler_ && failedData.Append(buffers_ + slot * SLOT_SIZE, slotDataLens_[slot])) {
+            failureHandler_(failedData);
+        }
+        // socket connected to the server restarted is replaced by a new one
+        auto serverIndex = static_cast<size_t>(cqe.user_data >> SERVER_INDEX_OFFSET);
+        if (IsServerGone(-cqe.res) && serverIndex < MAX_SERVER_CNT && serverSockets_[serverIndex] >= 0) {
+            close(serverSockets_[serverIndex]);
+            serverSockets_[serverIndex] = -1;
+        }
+    }
+    __atomic_store_n(cqHead_, head, __ATOMIC_RELEASE);
+}
+
+void IoUringSender::Submit()
+{
+    // requests left by a failed submission are submitted together with the new one
+    unsigned toSubmit = *sqTail_ - __atomic_load_n(sqHead_, __ATOMIC_ACQUIRE);
+    if (IoUringEnter(ringFd_, toSubmit) < 0) {
+        HILOG_DEBUG(LOG_CORE, "failed to submit to io_uring, errno=%{public}d", errno);
+    }
+}
+} // namespace HiviewDFX
+} // namespace OHOS
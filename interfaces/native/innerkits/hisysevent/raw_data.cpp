@@ -119,6 +119,12 @@ bool RawData::IsEmpty()
     return len_ == 0 || data_ == nullptr;
 }
 
+void RawData::Reset()
+{
+    // keep the allocated memory to be reused
+    len_ = 0;
+}
+
 bool RawData::Update(uint8_t* data, size_t len, size_t pos)
 {
     if (data == nullptr || pos > len_) {
@@ -130,26 +136,18 @@ bool RawData::Update(uint8_t* data, size_t len, size_t pos)
         HILOG_ERROR(LOG_CORE, "Try to update an invalid raw data");
         return false;
     }
-    auto ret = EOK;
     if ((pos + len) > capacity_) {
-        size_t expandedSize = (len > EXPAND_BUF_SIZE) ? len : EXPAND_BUF_SIZE;
-        size_t expandedCapacity = capacity_ + expandedSize;
-        uint8_t* resizedData = new(std::nothrow) uint8_t[expandedCapacity];
-        if (resizedData == nullptr) {
-            return false;
+        // grow geometrically, so the total copies of data are linear with the final length
+        size_t expandedCapacity = capacity_ * 2; // 2 times of the current capacity
+        if (expandedCapacity < (pos + len)) {
+            expandedCapacity = pos + len;
         }
-        ret = memcpy_s(resizedData, expandedCapacity, data_, len_);
-        if (ret != EOK) {
-            HILOG_ERROR(LOG_CORE, "Failed to expand capacity of raw data, ret is %{public}d.", ret);
-            delete[] resizedData;
+        if (!Reserve(expandedCapacity)) {
             return false;
         }
-        capacity_ += expandedSize;
-        delete[] data_;
-        data_ = resizedData;
     }
     // append new data
-    ret = memcpy_s(data_ + pos, capacity_ - pos, data, len);
+    auto ret = memcpy_s(data_ + pos, capacity_ - pos, data, len);
     if (ret != EOK) {
         HILOG_ERROR(LOG_CORE, "Failed to append new data, ret is %{public}d.", ret);
         return false;
@@ -160,6 +158,29 @@ bool RawData::Update(uint8_t* data, size_t len, size_t pos)
     return true;
 }
 
+bool RawData::Reserve(size_t capacity)
+{
+    if (capacity <= capacity_) {
+        return true;
+    }
+    uint8_t* resizedData = new(std::nothrow) uint8_t[capacity];
+    if (resizedData == nullptr) {
+        return false;
+    }
+    if (data_ != nullptr && len_ > 0) {
+        auto ret = memcpy_s(resizedData, capacity, data_, len_);
+        if (ret != EOK) {
+            HILOG_ERROR(LOG_CORE, "Failed to expand capacity of raw data, ret is %{public}d.", ret);
+            delete[] resizedData;
+            return false;
+        }
+    }
+    delete[] data_;
+    data_ = resizedData;
+    capacity_ = capacity;
+    return true;
+}
+
 uint8_t* RawData::GetData() const
 {
     return data_;
@@ -169,6 +190,11 @@ size_t RawData::GetDataLength() const
 {
     return len_;
 }
+
+size_t RawData::GetCapacity() const
+{
+    return capacity_;
+}
 } // namespace Encoded
 } // namespace HiviewDFX
 } // namespace OHOS
@@ -18,6 +18,7 @@
 #include "hilog/log.h"
 
 #include "securec.h"
+#include "stringfilter.h"
 
 #undef LOG_DOMAIN
 #define LOG_DOMAIN 0xD002D08
@@ -34,11 +35,16 @@ uint8_t RawDataEncoder::EncodedTag(uint8_t type)
 }
 
 bool RawDataEncoder::StringValueEncoded(RawData& data, const std::string& val)
+{
+    return StringValueEncoded(data, std::string_view(val));
+}
+
+bool RawDataEncoder::StringValueEncoded(RawData& data, std::string_view val)
 {
     if (!UnsignedVarintEncoded(data, EncodeType::LENGTH_DELIMITED, val.length())) {
         return false;
     }
-    if (!data.Append(reinterpret_cast<uint8_t*>(const_cast<char*>(val.c_str())),
+    if (!data.Append(reinterpret_cast<uint8_t*>(const_cast<char*>(val.data())),
         val.length())) {
         HILOG_ERROR(LOG_CORE, "string value copy failed.");
         return false;
@@ -46,6 +52,29 @@ bool RawDataEncoder::StringValueEncoded(RawData& data, const std::string& val)
     return true;
 }
 
+bool RawDataEncoder::EscapedStringValueEncoded(RawData& data, std::string_view val)
+{
+    auto& filter = StringFilter::GetInstance();
+    if (!filter.IsEscapeNeeded(val)) {
+        // most of the string values are copied as whole without any transformation
+        return StringValueEncoded(data, val);
+    }
+    if (!UnsignedVarintEncoded(data, EncodeType::LENGTH_DELIMITED, filter.GetEscapedLength(val))) {
+        return false;
+    }
+    if (!filter.EscapeToRaw(val, data)) {
+        HILOG_ERROR(LOG_CORE, "escaped string value copy failed.");
+        return false;
+    }
+    return true;
+}
+
+size_t RawDataEncoder::EscapedStringValueEncodedSize(std::string_view val)
+{
+    size_t escapedLen = StringFilter::GetInstance().GetEscapedLength(val);
+    return UnsignedVarintEncodedSize(escapedLen) + escapedLen;
+}
+
 bool RawDataEncoder::ValueTypeEncoded(RawData& data, bool isArray, ValueType type, uint8_t count)
 {
     struct ParamValueType kvType {
@@ -0,0 +1,366 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "shared_memory_ring.h"
+
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <fcntl.h>
+#include <new>
+#include <poll.h>
+#include <securec.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "base_info_cache.h"
+#include "def.h"
+#include "hilog/log.h"
+
+#undef LOG_DOMAIN
+#define LOG_DOMAIN 0xD002D08
+
+#undef LOG_TAG
+#define LOG_TAG "HISYSEVENT_SHARED_MEMORY_RING"
+
+namespace OHOS {
+namespace HiviewDFX {
+namespace {
+constexpr char MEM_FD_NAME[] = "hisysevent_ring";
+constexpr uint32_t ENTRY_FREE = 0;
+constexpr uint32_t ENTRY_COMMITTED = 1;
+constexpr uint32_t ENTRY_PADDING = 2;
+constexpr size_t ENTRY_ALIGNMENT = 8;
+constexpr size_t FD_CNT = 2; // memfd and eventfd
+
+inline size_t GetEntrySize(size_t dataLen)
+{
+    return (sizeof(SharedMemoryRingEntry) + dataLen + ENTRY_ALIGNMENT - 1) & ~(ENTRY_ALIGNMENT - 1);
+}
+
+inline bool IsPowerOfTwo(size_t value)
+{
+    return value != 0 && (value & (value - 1)) == 0;
+}
+
+inline void CloseFd(int& fd)
+{
+    if (fd >= 0) {
+        close(fd);
+        fd = -1;
+    }
+}
+
+void* MapRing(int memFd, size_t size)
+{
+    void* addr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, memFd, 0);
+    return (addr == MAP_FAILED) ? nullptr : addr;
+}
+}
+
+SharedMemoryRing::~SharedMemoryRing()
+{
+    if (header_ != nullptr) {
+        munmap(header_, size_);
+    }
+    CloseFd(memFd_);
+    CloseFd(eventFd_);
+}
+
+bool SharedMemoryRing::Init(size_t capacity)
+{
+    if (header_ != nullptr || !IsPowerOfTwo(capacity)) {
+        return false;
+    }
+    memFd_ = memfd_create(MEM_FD_NAME, MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    if (memFd_ < 0) {
+        HILOG_WARN(LOG_CORE, "failed to create memfd of ring, errno=%{public}d", errno);
+        return false;
+    }
+    size_ = sizeof(SharedMemoryRingHeader) + capacity;
+    // the size is sealed so that the daemon is safe to map it
+    if (ftruncate(memFd_, static_cast<off_t>(size_)) != 0 ||
+        fcntl(memFd_, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_SEAL) != 0) {
+        HILOG_WARN(LOG_CORE, "failed to resize memfd of ring, errno=%{public}d", errno);
+        CloseFd(memFd_);
+        return false;
+    }
+    eventFd_ = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    void* addr = MapRing(memFd_, size_);
+    if (eventFd_ < 0 || addr == nullptr) {
+        HILOG_WARN(LOG_CORE, "failed to map ring, errno=%{public}d", errno);
+        CloseFd(memFd_);
+        CloseFd(eventFd_);
+        return false;
+    }
+    // the memory of memfd is zero filled, so all entries are free
+    header_ = new (addr) SharedMemoryRingHeader();
+    header_->magic = SHARED_MEMORY_RING_MAGIC;
+    header_->version = SHARED_MEMORY_RING_VERSION;
+    header_->capacity = capacity;
+    entries_ = reinterpret_cast<uint8_t*>(header_) + sizeof(SharedMemoryRingHeader);
+    return true;
+}
+
+int SharedMemoryRing::HandOver(const EventSocket& daemonAddr)
+{
+    if (header_ == nullptr) {
+        return ERR_DOES_NOT_INIT;
+    }
+    int socketId = TEMP_FAILURE_RETRY(socket(AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC, 0));
+    if (socketId < 0) {
+        return ERR_DOES_NOT_INIT;
+    }
+    SharedMemoryRingHandshake handshake = {
+        .magic = SHARED_MEMORY_RING_MAGIC,
+        .version = SHARED_MEMORY_RING_VERSION,
+        .pid = BaseInfoCache::GetPid(),
+        .size = size_,
+    };
+    struct iovec iov = { .iov_base = &handshake, .iov_len = sizeof(handshake) };
+    alignas(struct cmsghdr) char control[CMSG_SPACE(sizeof(int) * FD_CNT)] = { 0 };
+    struct msghdr msg {};
+    msg.msg_name = const_cast<EventSocket*>(&daemonAddr);
+    msg.msg_namelen = sizeof(daemonAddr);
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+    struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_RIGHTS;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(int) * FD_CNT);
+    int fds[FD_CNT] = { memFd_, eventFd_ };
+    if (memcpy_s(CMSG_DATA(cmsg), sizeof(fds), fds, sizeof(fds)) != EOK) {
+        close(socketId);
+        return ERR_SEND_FAIL;
+    }
+    auto ret = TEMP_FAILURE_RETRY(sendmsg(socketId, &msg, MSG_NOSIGNAL));
+    close(socketId);
+    if (ret < 0) {
+        HILOG_DEBUG(LOG_CORE, "failed to hand over ring to %{public}s, errno=%{public}d", daemonAddr.sun_path, errno);
+        return ERR_SEND_FAIL;
+    }
+    return SUCCESS;
+}
+
+int SharedMemoryRing::Write(const RawData& rawData)
+{
+    if (header_ == nullptr || header_->isConsumerAttached.load(std::memory_order_acquire) == 0) {
+        return ERR_DOES_NOT_INIT;
+    }
+    size_t len = rawData.GetDataLength();
+    size_t entrySize = GetEntrySize(len);
+    size_t capacity = header_->capacity;
+    if (entrySize > capacity / 2) { // 2 entries at most are reserved while the ring wraps around
+        return ERR_OVER_SIZE;
+    }
+    uint64_t pos = header_->writePos.load(std::memory_order_relaxed);
+    size_t offset = 0;
+    size_t reservedSize = 0;
+    do {
+        offset = pos & (capacity - 1);
+        // entry is never split, the room left at the end of the ring is filled with a padding entry
+        reservedSize = (capacity - offset >= entrySize) ? entrySize : (capacity - offset + entrySize);
+        if (pos + reservedSize - header_->readPos.load(std::memory_order_acquire) > capacity) {
+            return ERR_SEND_FAIL; // the ring is full
+        }
+    } while (!header_->writePos.compare_exchange_weak(pos, pos + reservedSize, std::memory_order_relaxed));
+    if (reservedSize != entrySize) {
+        auto padding = reinterpret_cast<SharedMemoryRingEntry*>(entries_ + offset);
+        padding->len = static_cast<uint32_t>(capacity - offset - sizeof(SharedMemoryRingEntry));
+        padding->state.store(ENTRY_PADDING, std::memory_order_release);
+        offset = 0;
+    }
+    auto entry = reinterpret_cast<SharedMemoryRingEntry*>(entries_ + offset);
+    entry->len = static_cast<uint32_t>(len);
+    if (memcpy_s(entry + 1, capacity - offset - sizeof(SharedMemoryRingEntry), rawData.GetData(), len) != EOK) {
+        // the entry reserved has to be released, which is skipped by the consumer as a padding one
+        entry->state.store(ENTRY_PADDING, std::memory_order_release);
+        return ERR_RAW_DATA_WROTE_EXCEPTION;
+    }
+    entry->state.store(ENTRY_COMMITTED, std::memory_order_release);
+    RingDoorbell();
+    return SUCCESS;
+}
+
+bool SharedMemoryRing::IsConsumerStalled(uint64_t timeout)
+{
+    if (header_ == nullptr) {
+        return false;
+    }
+    uint64_t now = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+    uint64_t readPos = header_->readPos.load(std::memory_order_acquire);
+    // the time is published before the position, so it's never older than the position compared with
+    if (fullReadPos_.load(std::memory_order_acquire) != readPos) {
+        fullTime_.store(now, std::memory_order_relaxed);
+        fullReadPos_.store(readPos, std::memory_order_release);
+        return false;
+    }
+    uint64_t fullTime = fullTime_.load(std::memory_order_relaxed);
+    return now >= fullTime && now - fullTime >= timeout;
+}
+
+int SharedMemoryRing::GetMemFd() const
+{
+    return memFd_;
+}
+
+int SharedMemoryRing::GetEventFd() const
+{
+    return eventFd_;
+}
+
+void SharedMemoryRing::RingDoorbell()
+{
+    // pairs with the waiting flag set by the consumer before it checks the ring again, so the doorbell is rung only
+    // if the consumer is going to sleep
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (header_->isConsumerWaiting.load(std::memory_order_relaxed) == 0 ||
+        header_->isConsumerWaiting.exchange(0) == 0) {
+        return;
+    }
+    uint64_t val = 1;
+    (void)TEMP_FAILURE_RETRY(write(eventFd_, &val, sizeof(val)));
+}
+
+SharedMemoryRingConsumer::~SharedMemoryRingConsumer()
+{
+    if (header_ != nullptr) {
+        munmap(header_, size_);
+    }
+    CloseFd(memFd_);
+    CloseFd(eventFd_);
+}
+
+bool SharedMemoryRingConsumer::Accept(int socketId)
+{
+    SharedMemoryRingHandshake handshake = {};
+    struct iovec iov = { .iov_base = &handshake, .iov_len = sizeof(handshake) };
+    alignas(struct cmsghdr) char control[CMSG_SPACE(sizeof(int) * FD_CNT)] = { 0 };
+    struct msghdr msg {};
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+    auto len = TEMP_FAILURE_RETRY(recvmsg(socketId, &msg, MSG_CMSG_CLOEXEC));
+    struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+    if (len != static_cast<ssize_t>(sizeof(handshake)) || cmsg == nullptr || cmsg->cmsg_type != SCM_RIGHTS ||
+        cmsg->cmsg_len != CMSG_LEN(sizeof(int) * FD_CNT)) {
+        return false;
+    }
+    int fds[FD_CNT] = { -1, -1 };
+    if (memcpy_s(fds, sizeof(fds), CMSG_DATA(cmsg), sizeof(fds)) != EOK ||
+        handshake.magic != SHARED_MEMORY_RING_MAGIC || handshake.version != SHARED_MEMORY_RING_VERSION) {
+        CloseFd(fds[0]);
+        CloseFd(fds[1]);
+        return false;
+    }
+    return Attach(fds[0], fds[1]);
+}
+
+bool SharedMemoryRingConsumer::Attach(int memFd, int eventFd)
+{
+    struct stat st = {};
+    void* addr = nullptr;
+    if (header_ == nullptr && fstat(memFd, &st) == 0 &&
+        static_cast<size_t>(st.st_size) > sizeof(SharedMemoryRingHeader)) {
+        addr = MapRing(memFd, static_cast<size_t>(st.st_size));
+    }
+    auto header = reinterpret_cast<SharedMemoryRingHeader*>(addr);
+    if (header == nullptr || header->magic != SHARED_MEMORY_RING_MAGIC || !IsPowerOfTwo(header->capacity) ||
+        header->capacity + sizeof(SharedMemoryRingHeader) != static_cast<size_t>(st.st_size)) {
+        if (addr != nullptr) {
+            munmap(addr, static_cast<size_t>(st.st_size));
+        }
+        CloseFd(memFd);
+        CloseFd(eventFd);
+        return false;
+    }
+    memFd_ = memFd;
+    eventFd_ = eventFd;
+    size_ = static_cast<size_t>(st.st_size);
+    header_ = header;
+    entries_ = reinterpret_cast<uint8_t*>(header_) + sizeof(SharedMemoryRingHeader);
+    header_->isConsumerAttached.store(1, std::memory_order_release);
+    return true;
+}
+
+size_t SharedMemoryRingConsumer::Consume(const EventHandler& handler)
+{
+    if (header_ == nullptr) {
+        return 0;
+    }
+    size_t capacity = header_->capacity;
+    uint64_t pos = header_->readPos.load(std::memory_order_relaxed);
+    size_t eventCnt = 0;
+    while (true) {
+        size_t offset = pos & (capacity - 1);
+        auto entry = reinterpret_cast<SharedMemoryRingEntry*>(entries_ + offset);
+        uint32_t state = entry->state.load(std::memory_order_acquire);
+        if (state == ENTRY_FREE) {
+            break;
+        }
+        size_t entrySize = GetEntrySize(entry->len);
+        if (entrySize > capacity - offset) {
+            HILOG_ERROR(LOG_CORE, "entry of ring is corrupted, len=%{public}u", entry->len);
+            break;
+        }
+        auto data = reinterpret_cast<uint8_t*>(entry + 1);
+        if (state == ENTRY_COMMITTED && entry->len >= sizeof(int32_t) + sizeof(HiSysEventHeader)) {
+            auto header = reinterpret_cast<HiSysEventHeader*>(data + sizeof(int32_t));
+            handler(*header, data, entry->len);
+            ++eventCnt;
+        }
+        // stale bytes would be taken as entries of following laps if the region is not cleared
+        (void)memset_s(entry, entrySize, 0, entrySize);
+        pos += entrySize;
+        header_->readPos.store(pos, std::memory_order_release);
+    }
+    return eventCnt;
+}
+
+bool SharedMemoryRingConsumer::Wait(int timeout)
+{
+    if (header_ == nullptr) {
+        return false;
+    }
+    header_->isConsumerWaiting.store(1);
+    if (HasCommittedEntry()) {
+        header_->isConsumerWaiting.store(0);
+        return true;
+    }
+    struct pollfd pfd = { .fd = eventFd_, .events = POLLIN, .revents = 0 };
+    int ret = TEMP_FAILURE_RETRY(poll(&pfd, 1, timeout));
+    header_->isConsumerWaiting.store(0);
+    if (ret > 0) {
+        uint64_t val = 0;
+        (void)TEMP_FAILURE_RETRY(read(eventFd_, &val, sizeof(val)));
+    }
+    return HasCommittedEntry();
+}
+
+bool SharedMemoryRingConsumer::HasCommittedEntry() const
+{
+    uint64_t pos = header_->readPos.load(std::memory_order_relaxed);
+    auto entry = reinterpret_cast<SharedMemoryRingEntry*>(entries_ + (pos & (header_->capacity - 1)));
+    return entry->state.load() != ENTRY_FREE;
+}
+} // namespace HiviewDFX
+} // namespace OHOS
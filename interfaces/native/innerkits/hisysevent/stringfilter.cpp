@@ -15,6 +15,7 @@
 
 #include "stringfilter.h"
 
+#include <cstring>
 #include <iosfwd>
 #include <istream>
 #include <ostream>
@@ -24,8 +25,76 @@
 #include <utility>
 #include <vector>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+#include "raw_data.h"
+
 namespace OHOS {
 namespace HiviewDFX {
+namespace {
+constexpr unsigned char CONTROL_CHAR_BOUND = 0x20; // [0x00, 0x1F] == [END, Unit Separator]
+constexpr unsigned char DEL_CHAR = 0x7F;
+#if defined(__SSE2__) || (defined(__aarch64__) && defined(__ARM_NEON))
+constexpr size_t SIMD_BLOCK_SIZE = 16;
+#endif
+
+inline bool IsCharToEscape(char c)
+{
+    auto uc = static_cast<unsigned char>(c);
+    return (uc < CONTROL_CHAR_BOUND) || (uc == DEL_CHAR) || (c == '\\') || (c == '\"');
+}
+
+// position of the first char which needs to be escaped or ignored from the pos, 16 chars are checked at once
+size_t FindCharToEscape(std::string_view text, size_t pos)
+{
+    const char* data = text.data();
+    size_t len = text.length();
+#if defined(__SSE2__)
+    const __m128i controlCharMax = _mm_set1_epi8(static_cast<char>(CONTROL_CHAR_BOUND - 1));
+    const __m128i delChar = _mm_set1_epi8(static_cast<char>(DEL_CHAR));
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i quote = _mm_set1_epi8('\"');
+    for (; pos + SIMD_BLOCK_SIZE <= len; pos += SIMD_BLOCK_SIZE) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos));
+        // max(c, 0x1F) == 0x1F means c <= 0x1F as unsigned char
+        __m128i isControlChar = _mm_cmpeq_epi8(_mm_max_epu8(block, controlCharMax), controlCharMax);
+        __m128i isMatched = _mm_or_si128(_mm_or_si128(isControlChar, _mm_cmpeq_epi8(block, delChar)),
+            _mm_or_si128(_mm_cmpeq_epi8(block, backslash), _mm_cmpeq_epi8(block, quote)));
+        unsigned int mask = static_cast<unsigned int>(_mm_movemask_epi8(isMatched));
+        if (mask != 0) {
+            return pos + static_cast<size_t>(__builtin_ctz(mask));
+        }
+    }
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+    const uint8x16_t controlCharBound = vdupq_n_u8(CONTROL_CHAR_BOUND);
+    const uint8x16_t delChar = vdupq_n_u8(DEL_CHAR);
+    const uint8x16_t backslash = vdupq_n_u8('\\');
+    const uint8x16_t quote = vdupq_n_u8('\"');
+    constexpr unsigned int bitsPerChar = 4; // each char is narrowed into 4 bits of the mask
+    for (; pos + SIMD_BLOCK_SIZE <= len; pos += SIMD_BLOCK_SIZE) {
+        uint8x16_t block = vld1q_u8(reinterpret_cast<const uint8_t*>(data + pos));
+        uint8x16_t isMatched = vorrq_u8(vorrq_u8(vcltq_u8(block, controlCharBound), vceqq_u8(block, delChar)),
+            vorrq_u8(vceqq_u8(block, backslash), vceqq_u8(block, quote)));
+        uint64_t mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(isMatched),
+            bitsPerChar)), 0);
+        if (mask != 0) {
+            return pos + static_cast<size_t>(__builtin_ctzll(mask)) / bitsPerChar;
+        }
+    }
+#endif
+    for (; pos < len; ++pos) {
+        if (IsCharToEscape(data[pos])) {
+            return pos;
+        }
+    }
+    return len;
+}
+}
+
 char StringFilter::charTab_[StringFilter::CHAR_RANGE][StringFilter::MAP_STR_LEN];
 int StringFilter::statTab_[StringFilter::STATE_NUM][StringFilter::CHAR_RANGE];
 StringFilter StringFilter::filter_;
@@ -78,24 +147,64 @@ StringFilter::StringFilter()
 
 std::string StringFilter::EscapeToRaw(const std::string &text)
 {
-    std::string rawText = "";
-    for (auto c : text) {
-        int ic = static_cast<int>(c);
-        if (ic >= 0 && ic < CHAR_RANGE && charTab_[ic][1]) {
+    std::string rawText;
+    rawText.reserve(text.length());
+    // chars need no transformation are appended by runs rather than one by one
+    size_t runBegin = 0;
+    for (size_t pos = FindCharToEscape(text, 0); pos < text.length(); pos = FindCharToEscape(text, runBegin)) {
+        rawText.append(text, runBegin, pos - runBegin);
+        runBegin = pos + 1;
+        // control character which is not supported with JSON is ignored
+        if (int ic = static_cast<int>(text[pos]); charTab_[ic][1]) {
             rawText.append(charTab_[ic]);
-            continue;
-        }
-        if ((ic == 0x7F) || (ic >= 0x00 && ic <= 0x1F)) {
-            // ignore control character which is not supported with JSON
-            // 0x7F == DEL, [0x00, 0x1F] == [END, Unit Separator]
-            continue;
         }
-        rawText.push_back(c);
     }
+    rawText.append(text, runBegin, text.length() - runBegin);
     return rawText;
 }
 
+bool StringFilter::EscapeToRaw(std::string_view text, Encoded::RawData& rawData)
+{
+    // chars need no transformation are appended by runs rather than one by one
+    size_t runBegin = 0;
+    for (size_t pos = FindCharToEscape(text, 0); pos < text.length(); pos = FindCharToEscape(text, runBegin)) {
+        if ((pos > runBegin) && !rawData.Append(reinterpret_cast<uint8_t*>(const_cast<char*>(text.data() + runBegin)),
+            pos - runBegin)) {
+            return false;
+        }
+        runBegin = pos + 1;
+        // control character which is not supported with JSON is ignored
+        if (int ic = static_cast<int>(text[pos]);
+            charTab_[ic][1] && !rawData.Append(reinterpret_cast<uint8_t*>(charTab_[ic]), strlen(charTab_[ic]))) {
+            return false;
+        }
+    }
+    return rawData.Append(reinterpret_cast<uint8_t*>(const_cast<char*>(text.data() + runBegin)),
+        text.length() - runBegin);
+}
+
+size_t StringFilter::GetEscapedLength(std::string_view text)
+{
+    size_t len = text.length();
+    for (size_t pos = FindCharToEscape(text, 0); pos < text.length(); pos = FindCharToEscape(text, pos + 1)) {
+        int ic = static_cast<int>(text[pos]);
+        // the char is replaced by its escaped form, or ignored
+        len = charTab_[ic][1] ? (len + strlen(charTab_[ic]) - 1) : (len - 1);
+    }
+    return len;
+}
+
+bool StringFilter::IsEscapeNeeded(std::string_view text)
+{
+    return FindCharToEscape(text, 0) < text.length();
+}
+
 bool StringFilter::IsValidName(const std::string &text, unsigned int maxSize)
+{
+    return IsValidName(std::string_view(text), maxSize);
+}
+
+bool StringFilter::IsValidName(std::string_view text, unsigned int maxSize)
 {
     if (text.empty()) {
         return false;
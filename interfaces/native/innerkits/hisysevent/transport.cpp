@@ -15,20 +15,31 @@
 
 #include "transport.h"
 
+#include <algorithm>
 #include <cerrno>
+#include <chrono>
 #include <cstddef>
+#include <cstring>
 #include <iosfwd>
-#include <list>
-#include <mutex>
+#include <memory>
+#include <new>
+#include <pthread.h>
 #include <securec.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <sys/un.h>
 #include <string>
+#include <thread>
 #include <unistd.h>
+#include <vector>
 
+#include "base_info_cache.h"
 #include "def.h"
+#include "event_journal.h"
 #include "event_socket_factory.h"
 #include "hilog/log.h"
+#include "hisysevent.h"
+#include "raw_data_base_def.h"
 
 #undef LOG_DOMAIN
 #define LOG_DOMAIN 0xD002D08
@@ -50,15 +61,245 @@ void LogErrorInfo(const std::string& logFormatStr, bool isDebugLevel)
     }
     HILOG_ERROR(LOG_CORE, "%{public}s, errno=%{public}d, msg=%{public}s", logFormatStr.c_str(), errno, errMsg);
 }
+
+// the socket is connected to a server which has been restarted or stopped
+inline bool IsDisconnected(int err)
+{
+    return err == ECONNREFUSED || err == ENOENT || err == ENOTCONN;
+}
+
+// sockets connected to the servers, which are owned by each thread so that no lock is needed to send data
+class ConnectedSockets {
+public:
+    ~ConnectedSockets()
+    {
+        CloseAll();
+    }
+
+    int Find(const EventSocket& serverAddr)
+    {
+        if (pid_ != BaseInfoCache::GetPid()) {
+            // sockets inherited through fork are shared with the parent process, so they are not reused,
+            // sockets of other threads in the parent process are closed on exec
+            CloseAll();
+            pid_ = BaseInfoCache::GetPid();
+        }
+        for (const auto& socket : sockets_) {
+            if (strncmp(socket.path, serverAddr.sun_path, sizeof(socket.path)) == 0) {
+                return socket.socketId;
+            }
+        }
+        return -1;
+    }
+
+    void Add(const EventSocket& serverAddr, int socketId)
+    {
+        ConnectedSocket socket = { {0}, socketId };
+        if (strncpy_s(socket.path, sizeof(socket.path), serverAddr.sun_path, sizeof(socket.path) - 1) != EOK) {
+            close(socketId);
+            return;
+        }
+        sockets_.emplace_back(socket);
+    }
+
+    void Remove(const EventSocket& serverAddr)
+    {
+        for (auto iter = sockets_.begin(); iter != sockets_.end(); ++iter) {
+            if (strncmp(iter->path, serverAddr.sun_path, sizeof(iter->path)) == 0) {
+                close(iter->socketId);
+                sockets_.erase(iter);
+                return;
+            }
+        }
+    }
+
+private:
+    void CloseAll()
+    {
+        for (const auto& socket : sockets_) {
+            close(socket.socketId);
+        }
+        sockets_.clear();
+    }
+
+private:
+    struct ConnectedSocket {
+        char path[sizeof(EventSocket::sun_path)];
+        int socketId;
+    };
+    std::vector<ConnectedSocket> sockets_;
+    uint32_t pid_ = 0;
+};
+
+thread_local ConnectedSockets g_connectedSockets;
+
+inline bool IsCongested(int err)
+{
+    return err == EAGAIN || err == EWOULDBLOCK;
+}
+
+// fault and security events are still sent while the circuit to the server is broken
+bool IsHigherPriorityData(RawData& rawData)
+{
+    if (rawData.GetDataLength() < sizeof(int32_t) + sizeof(HiSysEventHeader)) {
+        return false;
+    }
+    auto header = reinterpret_cast<HiSysEventHeader*>(rawData.GetData() + sizeof(int32_t));
+    int type = static_cast<int>(header->type) + 1; // transform type to HiSysEvent::EventType
+    return type == HiSysEvent::EventType::FAULT || type == HiSysEvent::EventType::SECURITY;
+}
 }
 
-Transport Transport::instance_;
+// never destroyed, the async worker left running on exit may still be sending through it
+__attribute__((no_destroy)) Transport Transport::instance_;
+
+Transport::~Transport()
+{
+    for (auto& slot : retryDataSlots_) {
+        delete slot.exchange(nullptr);
+    }
+    DisableSharedMemoryRing();
+    isIoUringEnabled_.store(false, std::memory_order_relaxed);
+    delete ioUringSender_.exchange(nullptr);
+}
 
 Transport& Transport::GetInstance()
 {
     return instance_;
 }
 
+CongestionControl& Transport::GetCongestionControl(const EventSocket& serverAddr)
+{
+    // server addresses are static objects of the socket factory, so they are told apart by their addresses
+    for (std::size_t i = 0; i < MAX_SERVER_CNT; ++i) {
+        const EventSocket* server = congestedServers_[i].load(std::memory_order_acquire);
+        if (server == nullptr && congestedServers_[i].compare_exchange_strong(server, &serverAddr,
+            std::memory_order_acq_rel)) {
+            return congestionControls_[i];
+        }
+        if (server == &serverAddr) {
+            return congestionControls_[i];
+        }
+    }
+    return sharedCongestionControl_;
+}
+
+CongestionStats Transport::GetCongestionStats(const EventSocket& serverAddr)
+{
+    return GetCongestionControl(serverAddr).GetStats();
+}
+
+int Transport::EnableSharedMemoryRing(const EventSocket& daemonAddr)
+{
+    if (sharedMemoryRing_.load(std::memory_order_acquire) != nullptr) {
+        return SUCCESS;
+    }
+    std::unique_ptr<SharedMemoryRing> ring(new(std::nothrow) SharedMemoryRing());
+    if (ring == nullptr || !ring->Init(SHARED_MEMORY_RING_SIZE)) {
+        return ERR_DOES_NOT_INIT;
+    }
+    if (int ret = ring->HandOver(daemonAddr); ret != SUCCESS) {
+        return ret;
+    }
+    SharedMemoryRing* expected = nullptr;
+    if (sharedMemoryRing_.compare_exchange_strong(expected, ring.get(), std::memory_order_acq_rel)) {
+        (void)ring.release();
+    }
+    return SUCCESS;
+}
+
+void Transport::DisableSharedMemoryRing()
+{
+    auto ring = sharedMemoryRing_.exchange(nullptr);
+    if (ring == nullptr) {
+        return;
+    }
+    // the ring is released after the writers which may have loaded it before are done, and it's leaked rather than
+    // released if they aren't done in time
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(SHARED_MEMORY_RING_RELEASE_TIMEOUT);
+    while (ringWriterCnt_.load() != 0) {
+        if (std::chrono::steady_clock::now() >= deadline) {
+            HILOG_WARN(LOG_CORE, "ring is still being wrote, it's not released");
+            return;
+        }
+        std::this_thread::yield();
+    }
+    delete ring;
+}
+
+bool Transport::WriteToSharedMemoryRing(const RawData& rawData)
+{
+    // pairs with the exchange of the ring in disabling, so the ring loaded is never released while it's wrote
+    ringWriterCnt_.fetch_add(1);
+    auto ring = sharedMemoryRing_.load();
+    int ret = (ring == nullptr) ? ERR_DOES_NOT_INIT : ring->Write(rawData);
+    bool isStalled = (ret == ERR_SEND_FAIL) && ring->IsConsumerStalled(SHARED_MEMORY_RING_STALL_TIMEOUT);
+    ringWriterCnt_.fetch_sub(1, std::memory_order_release);
+    if (isStalled) {
+        HILOG_WARN(LOG_CORE, "consumer of ring is stalled, sockets are used instead");
+        DisableSharedMemoryRing();
+    }
+    return ret == SUCCESS;
+}
+
+int Transport::SetIoUringEnabled(bool isEnabled)
+{
+    if (!isEnabled) {
+        isIoUringEnabled_.store(false, std::memory_order_relaxed);
+        return SUCCESS;
+    }
+    if (ioUringSender_.load(std::memory_order_acquire) == nullptr) {
+        std::unique_ptr<IoUringSender> sender(new(std::nothrow) IoUringSender());
+        if (sender == nullptr || !sender->Init()) {
+            return ERR_DOES_NOT_INIT;
+        }
+        // the failed data is kept as the data failed through sockets, and retried by the following sends
+        sender->SetFailureHandler([] (const RawData& rawData) {
+            instance_.AddFailedData(rawData);
+        });
+        IoUringSender* expected = nullptr;
+        if (ioUringSender_.compare_exchange_strong(expected, sender.get(), std::memory_order_acq_rel)) {
+            (void)sender.release();
+            // queues of io_uring are shared with the parent process, so the child falls back to the sockets
+            (void)pthread_atfork(nullptr, nullptr, [] {
+                instance_.isIoUringEnabled_.store(false, std::memory_order_relaxed);
+            });
+        }
+    }
+    isIoUringEnabled_.store(true, std::memory_order_relaxed);
+    return SUCCESS;
+}
+
+IoUringStats Transport::GetIoUringStats()
+{
+    auto sender = ioUringSender_.load(std::memory_order_acquire);
+    return (sender == nullptr) ? IoUringStats() : sender->GetStats();
+}
+
+int Transport::EnableEventJournal(const std::string& dir, size_t capacity)
+{
+    return EventJournal::GetInstance().Enable(dir, capacity, [] (RawData& rawData) {
+        return instance_.SendToHiSysEventDataSource(EventSocketFactory::GetEventSocket(rawData), rawData) == SUCCESS;
+    });
+}
+
+void Transport::SetBackend(TransportBackend* backend)
+{
+    backend_.store(backend, std::memory_order_release);
+}
+
+int Transport::SendByIoUring(const EventSocket& serverAddr, RawData& rawData)
+{
+    if (!isIoUringEnabled_.load(std::memory_order_relaxed)) {
+        return ERR_DOES_NOT_INIT;
+    }
+    auto sender = ioUringSender_.load(std::memory_order_acquire);
+    if (sender == nullptr) {
+        return ERR_DOES_NOT_INIT;
+    }
+    return sender->Send(serverAddr, rawData);
+}
+
 void Transport::InitRecvBuffer(int socketId)
 {
     int oldN = 0;
@@ -79,59 +320,208 @@ void Transport::InitRecvBuffer(int socketId)
     }
 }
 
-int Transport::SendToHiSysEventDataSource(RawData& rawData)
+int Transport::ConnectToServer(const EventSocket& serverAddr, int& socketId)
 {
-    // reopen the socket with an new id each time is neccessary here, which is more efficient than that
-    // reuse id of the opened socket and then use a mutex to avoid multi-threading race.
-    auto socketId = TEMP_FAILURE_RETRY(socket(AF_UNIX, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0));
+    socketId = g_connectedSockets.Find(serverAddr);
+    if (socketId >= 0) {
+        return SUCCESS;
+    }
+    socketId = TEMP_FAILURE_RETRY(socket(AF_UNIX, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0));
     if (socketId < 0) {
         LogErrorInfo("create hisysevent client socket failed", true);
         return ERR_DOES_NOT_INIT;
     }
     InitRecvBuffer(socketId);
+    if (TEMP_FAILURE_RETRY(connect(socketId, reinterpret_cast<const sockaddr*>(&serverAddr),
+        sizeof(serverAddr))) < 0) {
+        LogErrorInfo(std::string(serverAddr.sun_path) + " connect failed", errno == EACCES);
+        close(socketId);
+        socketId = -1;
+        return ERR_SEND_FAIL;
+    }
+    // the socket is kept open for following data until the thread exits or the server restarts
+    g_connectedSockets.Add(serverAddr, socketId);
+    return SUCCESS;
+}
+
+int Transport::SendToHiSysEventDataSource(const EventSocket& serverAddr, RawData& rawData)
+{
+    auto& congestionControl = GetCongestionControl(serverAddr);
+    if (!congestionControl.IsSendAllowed(IsHigherPriorityData(rawData))) {
+        HILOG_DEBUG(LOG_CORE, "%{public}s is congested, skip to send data", serverAddr.sun_path);
+        return ERR_SEND_FAIL;
+    }
     auto sendRet = 0;
-    auto retryTimes = RETRY_TIMES;
-    std::string errDes;
-    do {
-        auto serverAddr = EventSocketFactory::GetEventSocket(rawData);
-        errDes = serverAddr.sun_path;
-        sendRet = sendto(socketId, rawData.GetData(), rawData.GetDataLength(), 0,
-            reinterpret_cast<sockaddr*>(&serverAddr), sizeof(serverAddr));
-        retryTimes--;
-    } while (sendRet < 0 && retryTimes > 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR));
+    auto sendErr = 0;
+    for (int retriedTimes = 0; retriedTimes < RETRY_TIMES; ++retriedTimes) {
+        int socketId = -1;
+        if (auto ret = ConnectToServer(serverAddr, socketId); ret != SUCCESS) {
+            return ret;
+        }
+        sendRet = send(socketId, rawData.GetData(), rawData.GetDataLength(), 0);
+        sendErr = errno;
+        if (sendRet >= 0) {
+            break;
+        }
+        if (IsDisconnected(sendErr)) {
+            // the server has been restarted, connect to it again in next try
+            g_connectedSockets.Remove(serverAddr);
+            continue;
+        }
+        if (IsCongested(sendErr)) {
+            // the caller never waits for the server to drain its buffer, the data is retried with the following data
+            congestionControl.OnSendBlocked();
+            break;
+        }
+        if (sendErr != EINTR) {
+            break;
+        }
+    }
     if (sendRet < 0) {
-        errDes.append(" write failed");
-        LogErrorInfo(errDes, errno == EACCES);
-        close(socketId);
+        if (IsCongested(sendErr)) {
+            congestionControl.OnSendFailed();
+        }
+        errno = sendErr;
+        LogErrorInfo(std::string(serverAddr.sun_path) + " write failed", sendErr == EACCES);
         return ERR_SEND_FAIL;
     }
-    close(socketId);
+    congestionControl.OnSendSucceeded();
     HILOG_DEBUG(LOG_CORE, "hisysevent send data successful");
     return SUCCESS;
 }
 
-void Transport::AddFailedData(RawData& rawData)
+void Transport::SendToHiSysEventDataSource(const EventSocket& serverAddr, RawData* const rawDatas[],
+    const std::vector<size_t>& indexes, int retCodes[])
+{
+    auto& congestionControl = GetCongestionControl(serverAddr);
+    std::vector<size_t> sentIndexes;
+    sentIndexes.reserve(indexes.size());
+    for (auto index : indexes) {
+        if (congestionControl.IsSendAllowed(IsHigherPriorityData(*rawDatas[index]))) {
+            sentIndexes.emplace_back(index);
+        } else {
+            retCodes[index] = ERR_SEND_FAIL;
+        }
+    }
+    std::vector<iovec> iovs(sentIndexes.size());
+    std::vector<mmsghdr> msgs(sentIndexes.size());
+    for (size_t i = 0; i < sentIndexes.size(); ++i) {
+        iovs[i].iov_base = rawDatas[sentIndexes[i]]->GetData();
+        iovs[i].iov_len = rawDatas[sentIndexes[i]]->GetDataLength();
+        msgs[i].msg_hdr.msg_iov = &iovs[i];
+        msgs[i].msg_hdr.msg_iovlen = 1;
+    }
+    size_t sentCnt = 0;
+    int retCode = SUCCESS;
+    auto sendErr = 0;
+    for (int retriedTimes = 0; sentCnt < sentIndexes.size() && retriedTimes < RETRY_TIMES;) {
+        int socketId = -1;
+        if (retCode = ConnectToServer(serverAddr, socketId); retCode != SUCCESS) {
+            break;
+        }
+        auto msgCnt = std::min(sentIndexes.size() - sentCnt, MAX_MSG_CNT_OF_BATCH);
+        auto sendRet = sendmmsg(socketId, msgs.data() + sentCnt, static_cast<unsigned int>(msgCnt), 0);
+        sendErr = errno;
+        if (sendRet > 0) {
+            // data is sent partly if the buffer of the server gets full, the rest is sent in next try
+            for (size_t i = sentCnt; i < sentCnt + static_cast<size_t>(sendRet); ++i) {
+                retCodes[sentIndexes[i]] = SUCCESS;
+            }
+            sentCnt += static_cast<size_t>(sendRet);
+            congestionControl.OnSendSucceeded();
+            continue;
+        }
+        retCode = ERR_SEND_FAIL;
+        if (IsDisconnected(sendErr)) {
+            g_connectedSockets.Remove(serverAddr);
+        } else if (IsCongested(sendErr)) {
+            congestionControl.OnSendBlocked();
+            break;
+        } else if (sendErr != EINTR) {
+            break;
+        }
+        ++retriedTimes;
+    }
+    if (sentCnt == sentIndexes.size()) {
+        return;
+    }
+    for (size_t i = sentCnt; i < sentIndexes.size(); ++i) {
+        retCodes[sentIndexes[i]] = retCode;
+    }
+    if (retCode == ERR_SEND_FAIL) {
+        if (IsCongested(sendErr)) {
+            congestionControl.OnSendFailed();
+        }
+        errno = sendErr;
+        LogErrorInfo(std::string(serverAddr.sun_path) + " write " + std::to_string(sentIndexes.size() - sentCnt) +
+            " data failed", sendErr == EACCES);
+    }
+}
+
+void Transport::AddFailedData(const RawData& rawData)
 {
-    std::lock_guard<std::mutex> lock(mutex_);
-    if (retryDataList_.size() >= RETRY_QUEUE_SIZE) {
-        retryDataList_.pop_front();
+    // data in the journal is replayed by its drainer, so the following writers needn't retry it inline
+    if (EventJournal::GetInstance().IsEnabled() && EventJournal::GetInstance().Append(rawData) == SUCCESS) {
+        return;
+    }
+    auto failedData = new(std::nothrow) RawData(rawData);
+    if (failedData == nullptr) {
+        return;
+    }
+    // the slot is counted in advance so that a drainer never sees the count less than the data queued
+    retryDataCnt_.fetch_add(1, std::memory_order_release);
+    auto pos = retryDataTail_.fetch_add(1, std::memory_order_relaxed) % RETRY_QUEUE_SIZE;
+    if (auto oldestData = retryDataSlots_[pos].exchange(failedData, std::memory_order_acq_rel);
+        oldestData != nullptr) {
+        retryDataCnt_.fetch_sub(1, std::memory_order_relaxed);
+        delete oldestData;
     }
-    retryDataList_.push_back(rawData);
 }
 
 void Transport::RetrySendFailedData()
 {
-    std::lock_guard<std::mutex> lock(mutex_);
-    while (!retryDataList_.empty()) {
-        auto rawData = retryDataList_.front();
-        if (SendToHiSysEventDataSource(rawData) != SUCCESS) {
-            return;
+    if (retryDataCnt_.load(std::memory_order_acquire) <= 0) {
+        return;
+    }
+    // only one thread drains the ring, other threads go on sending their own data rather than wait for it
+    if (isRetrying_.test_and_set(std::memory_order_acquire)) {
+        return;
+    }
+    // slots are drained from the next one to be overwritten, which keeps the oldest data
+    auto beginPos = retryDataTail_.load(std::memory_order_relaxed);
+    for (std::size_t i = 0; i < RETRY_QUEUE_SIZE; ++i) {
+        auto& slot = retryDataSlots_[(beginPos + i) % RETRY_QUEUE_SIZE];
+        std::unique_ptr<RawData> failedData(slot.exchange(nullptr, std::memory_order_acq_rel));
+        if (failedData == nullptr) {
+            continue;
+        }
+        retryDataCnt_.fetch_sub(1, std::memory_order_relaxed);
+        if (SendToHiSysEventDataSource(EventSocketFactory::GetEventSocket(*failedData), *failedData) == SUCCESS) {
+            continue;
         }
-        retryDataList_.pop_front();
+        // put the data back unless the slot has been taken by newer data meanwhile
+        RawData* emptySlot = nullptr;
+        retryDataCnt_.fetch_add(1, std::memory_order_release);
+        if (slot.compare_exchange_strong(emptySlot, failedData.get(), std::memory_order_acq_rel)) {
+            (void)failedData.release();
+        } else {
+            retryDataCnt_.fetch_sub(1, std::memory_order_relaxed);
+        }
+        break;
     }
+    isRetrying_.clear(std::memory_order_release);
 }
 
 int Transport::SendData(RawData& rawData)
+{
+    if (rawData.IsEmpty()) {
+        HILOG_WARN(LOG_CORE, "try to send a empty data.");
+        return ERR_EMPTY_EVENT;
+    }
+    return SendData(rawData, EventSocketFactory::GetEventSocket(rawData));
+}
+
+int Transport::SendData(RawData& rawData, const EventSocket& serverAddr)
 {
     if (rawData.IsEmpty()) {
         HILOG_WARN(LOG_CORE, "try to send a empty data.");
@@ -141,21 +531,82 @@ int Transport::SendData(RawData& rawData)
     if (rawDataLength > MAX_DATA_SIZE) {
         return ERR_OVER_SIZE;
     }
+    if (auto backend = backend_.load(std::memory_order_acquire); backend != nullptr) {
+        return backend->Send(rawData, serverAddr);
+    }
 
+    // data wrote into the ring shared with the daemon needs neither system call nor copy of kernel
+    if (WriteToSharedMemoryRing(rawData)) {
+        return SUCCESS;
+    }
     RetrySendFailedData();
-    int tryTimes = RETRY_TIMES;
-    int retCode = SUCCESS;
-    while (tryTimes > 0) {
-        tryTimes--;
-        retCode = SendToHiSysEventDataSource(rawData);
-        if (retCode == SUCCESS) {
-            return retCode;
-        }
+    // data submitted to io_uring is sent asynchronously, sockets are used only if io_uring is unavailable or busy
+    if (int retCode = SendByIoUring(serverAddr, rawData); retCode != ERR_DOES_NOT_INIT) {
+        return retCode;
+    }
+    // data failed, e.g. since the server is congested, is kept to be sent with following data rather than waited for
+    int retCode = SendToHiSysEventDataSource(serverAddr, rawData);
+    if (retCode != SUCCESS) {
+        AddFailedData(rawData);
     }
-
-    AddFailedData(rawData);
     return retCode;
 }
+
+void Transport::SendData(RawData* const rawDatas[], size_t cnt, int retCodes[])
+{
+    if (rawDatas == nullptr || retCodes == nullptr) {
+        return;
+    }
+    auto backend = backend_.load(std::memory_order_acquire);
+    if (backend == nullptr) {
+        RetrySendFailedData();
+    }
+    // data is grouped by the servers, each group is sent by one system call in the order of the data
+    const EventSocket* servers[MAX_SERVER_CNT] = { nullptr };
+    std::vector<size_t> indexesOfServers[MAX_SERVER_CNT];
+    for (size_t i = 0; i < cnt; ++i) {
+        if (rawDatas[i] == nullptr || rawDatas[i]->IsEmpty()) {
+            retCodes[i] = ERR_EMPTY_EVENT;
+            continue;
+        }
+        if (rawDatas[i]->GetDataLength() > MAX_DATA_SIZE) {
+            retCodes[i] = ERR_OVER_SIZE;
+            continue;
+        }
+        if (backend != nullptr) {
+            retCodes[i] = backend->Send(*rawDatas[i], EventSocketFactory::GetEventSocket(*rawDatas[i]));
+            continue;
+        }
+        if (WriteToSharedMemoryRing(*rawDatas[i])) {
+            retCodes[i] = SUCCESS;
+            continue;
+        }
+        const EventSocket* server = &EventSocketFactory::GetEventSocket(*rawDatas[i]);
+        if (int retCode = SendByIoUring(*server, *rawDatas[i]); retCode != ERR_DOES_NOT_INIT) {
+            retCodes[i] = retCode;
+            continue;
+        }
+        size_t serverIndex = 0;
+        while (serverIndex < MAX_SERVER_CNT - 1 && servers[serverIndex] != nullptr && servers[serverIndex] != server) {
+            ++serverIndex;
+        }
+        if (servers[serverIndex] != nullptr && servers[serverIndex] != server) {
+            // too many servers, which never happens since there are two servers only
+            retCodes[i] = SendData(*rawDatas[i], *server);
+            continue;
+        }
+        servers[serverIndex] = server;
+        indexesOfServers[serverIndex].emplace_back(i);
+    }
+    for (size_t i = 0; i < MAX_SERVER_CNT && servers[i] != nullptr; ++i) {
+        SendToHiSysEventDataSource(*servers[i], rawDatas, indexesOfServers[i], retCodes);
+        for (auto index : indexesOfServers[i]) {
+            if (retCodes[index] != SUCCESS) {
+                AddFailedData(*rawDatas[index]);
+            }
+        }
+    }
+}
 } // namespace HiviewDFX
 } // namespace OHOS
 
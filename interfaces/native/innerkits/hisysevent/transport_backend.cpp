@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "transport_backend.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <new>
+#include <securec.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "def.h"
+#include "hilog/log.h"
+
+#undef LOG_DOMAIN
+#define LOG_DOMAIN 0xD002D08
+
+#undef LOG_TAG
+#define LOG_TAG "HISYSEVENT_TRANSPORT_BACKEND"
+
+namespace OHOS {
+namespace HiviewDFX {
+namespace {
+constexpr size_t CAPTURE_ALIGNMENT = 8;
+
+// length of the event is set after its data, so entries being captured are told apart by 0
+struct CaptureEntry {
+    std::atomic<uint32_t> len;
+    uint32_t reserved;
+};
+
+inline size_t GetEntrySize(size_t dataLen)
+{
+    return (sizeof(CaptureEntry) + dataLen + CAPTURE_ALIGNMENT - 1) & ~(CAPTURE_ALIGNMENT - 1);
+}
+}
+
+UnixSocketBackend::UnixSocketBackend(const std::string& socketPath)
+{
+    if (!socketPath.empty()) {
+        serverAddr_.sun_family = AF_UNIX;
+        if (strcpy_s(serverAddr_.sun_path, sizeof(serverAddr_.sun_path), socketPath.c_str()) != EOK) {
+            HILOG_WARN(LOG_CORE, "socket path is too long");
+            return;
+        }
+        isPathConfigured_ = true;
+    }
+    // socket is shared by all threads, since each datagram is sent by one system call
+    socketId_ = TEMP_FAILURE_RETRY(socket(AF_UNIX, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0));
+    if (socketId_ < 0) {
+        HILOG_WARN(LOG_CORE, "failed to create socket, errno=%{public}d", errno);
+        return;
+    }
+    int sendBuffSize = MAX_DATA_SIZE;
+    (void)setsockopt(socketId_, SOL_SOCKET, SO_SNDBUF, static_cast<void *>(&sendBuffSize), sizeof(int));
+}
+
+UnixSocketBackend::~UnixSocketBackend()
+{
+    if (socketId_ >= 0) {
+        close(socketId_);
+    }
+}
+
+int UnixSocketBackend::Send(RawData& rawData, const EventSocket& serverAddr)
+{
+    if (socketId_ < 0) {
+        return ERR_DOES_NOT_INIT;
+    }
+    const auto& destAddr = isPathConfigured_ ? serverAddr_ : serverAddr;
+    auto sendRet = TEMP_FAILURE_RETRY(sendto(socketId_, rawData.GetData(), rawData.GetDataLength(), 0,
+        reinterpret_cast<const sockaddr*>(&destAddr), sizeof(destAddr)));
+    return (sendRet < 0) ? ERR_SEND_FAIL : SUCCESS;
+}
+
+CaptureBackend::CaptureBackend(size_t capacity)
+{
+    if (capacity == 0) {
+        return;
+    }
+    buffer_.reset(new(std::nothrow) uint8_t[capacity]());
+    capacity_ = (buffer_ == nullptr) ? 0 : capacity;
+}
+
+int CaptureBackend::Send(RawData& rawData, const EventSocket&)
+{
+    size_t len = rawData.GetDataLength();
+    if (capacity_ == 0) {
+        capturedCnt_.fetch_add(1, std::memory_order_relaxed);
+        capturedBytes_.fetch_add(len, std::memory_order_relaxed);
+        return SUCCESS;
+    }
+    // entries are reserved by bumping the size used, which only grows until the capture is reset
+    size_t entrySize = GetEntrySize(len);
+    size_t pos = usedSize_.fetch_add(entrySize, std::memory_order_relaxed);
+    if (pos > capacity_ || entrySize > capacity_ - pos) {
+        droppedCnt_.fetch_add(1, std::memory_order_relaxed);
+        return ERR_SEND_FAIL;
+    }
+    auto entry = reinterpret_cast<CaptureEntry*>(buffer_.get() + pos);
+    if (memcpy_s(entry + 1, capacity_ - pos - sizeof(CaptureEntry), rawData.GetData(), len) != EOK) {
+        droppedCnt_.fetch_add(1, std::memory_order_relaxed);
+        return ERR_RAW_DATA_WROTE_EXCEPTION;
+    }
+    entry->len.store(static_cast<uint32_t>(len), std::memory_order_release);
+    capturedCnt_.fetch_add(1, std::memory_order_relaxed);
+    capturedBytes_.fetch_add(len, std::memory_order_relaxed);
+    return SUCCESS;
+}
+
+size_t CaptureBackend::ForEach(const std::function<void(const uint8_t*, size_t)>& visitor) const
+{
+    size_t visitedCnt = 0;
+    size_t usedSize = std::min(usedSize_.load(std::memory_order_acquire), capacity_);
+    for (size_t pos = 0; pos + sizeof(CaptureEntry) <= usedSize;) {
+        auto entry = reinterpret_cast<const CaptureEntry*>(buffer_.get() + pos);
+        size_t len = entry->len.load(std::memory_order_acquire);
+        if (len == 0) {
+            break;
+        }
+        visitor(reinterpret_cast<const uint8_t*>(entry + 1), len);
+        ++visitedCnt;
+        pos += GetEntrySize(len);
+    }
+    return visitedCnt;
+}
+
+void CaptureBackend::Reset()
+{
+    size_t usedSize = std::min(usedSize_.load(std::memory_order_relaxed), capacity_);
+    if (usedSize > 0) {
+        (void)memset_s(buffer_.get(), capacity_, 0, usedSize);
+    }
+    usedSize_.store(0, std::memory_order_release);
+    capturedCnt_.store(0, std::memory_order_relaxed);
+    capturedBytes_.store(0, std::memory_order_relaxed);
+    droppedCnt_.store(0, std::memory_order_relaxed);
+}
+
+CaptureStats CaptureBackend::GetStats() const
+{
+    CaptureStats stats;
+    stats.capturedCnt = capturedCnt_.load(std::memory_order_relaxed);
+    stats.capturedBytes = capturedBytes_.load(std::memory_order_relaxed);
+    stats.droppedCnt = droppedCnt_.load(std::memory_order_relaxed);
+    return stats;
+}
+} // namespace HiviewDFX
+} // namespace OHOS
@@ -18,12 +18,7 @@
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
-#include <iosfwd>
-#include <mutex>
-#include <ostream>
 #include <sys/time.h>
-#include <sstream>
-#include <string>
 
 #include "hilog/log.h"
 
@@ -35,100 +30,93 @@
 
 namespace OHOS {
 namespace HiviewDFX {
-constexpr size_t LRU_CACHE_DEFAULT_SIZE = 30;
 namespace {
-uint64_t GenerateHash(const std::string& info)
+constexpr unsigned int COUNT_BITS = 24;
+constexpr uint64_t COUNT_MASK = (1ULL << COUNT_BITS) - 1;
+constexpr uint64_t SEC_TO_MILLIS = 1000; // second to millisecond
+constexpr size_t SHARD_CNT = 16;
+constexpr size_t ENTRY_CNT_OF_SHARD = 64;
+constexpr size_t MAX_PROBE_CNT = 8;
+constexpr unsigned int SHARD_SHIFT = 56;
+constexpr size_t MAX_HASHED_LEN = 256;
+constexpr uint64_t HASH_BASIS = 0xCBF29CE484222325ULL;
+constexpr uint64_t HASH_PRIME = 0x100000001B3ULL;
+constexpr uint64_t MIX_MULTIPLIER = 0xFF51AFD7ED558CCDULL;
+constexpr unsigned int MIX_SHIFT = 33;
+constexpr char KEY_SEPARATOR = '_';
+constexpr uint64_t EMPTY_KEY = 0;
+
+inline uint64_t HashChar(uint64_t hash, uint8_t ch)
 {
-    const char* p = info.c_str();
-    size_t infoLen = info.size();
-    size_t infoLenLimit = 256;
-    size_t hashLen = (infoLen < infoLenLimit) ? infoLen : infoLenLimit;
-    size_t i = 0;
-    uint64_t ret { 0xCBF29CE484222325ULL }; // hash basis value
-    while (i < hashLen) {
-        ret ^= *(p + i);
-        ret *= 0x100000001B3ULL; // hash prime value
-        i++;
+    return (hash ^ ch) * HASH_PRIME;
+}
+
+uint64_t HashStr(uint64_t hash, const char* str)
+{
+    for (size_t i = 0; str != nullptr && str[i] != '\0' && i < MAX_HASHED_LEN; ++i) {
+        hash = HashChar(hash, static_cast<uint8_t>(str[i]));
     }
-    return ret;
+    return hash;
 }
 
-uint64_t ConcatenateInfoAsKey(const char* eventName, const char* func, int64_t line)
+// key of "eventName_func_line", which is hashed without being concatenated
+uint64_t GenerateCallSiteKey(const char* eventName, const char* func, int64_t line)
 {
-    std::string key;
-    key.append(eventName).append("_").append(func).append("_").append(std::to_string(line));
-    return GenerateHash(key);
+    uint64_t hash = HashStr(HASH_BASIS, eventName);
+    hash = HashStr(HashChar(hash, KEY_SEPARATOR), func);
+    hash = (HashChar(hash, KEY_SEPARATOR) ^ static_cast<uint64_t>(line)) * HASH_PRIME;
+    // high bits select the shard, which are mixed with the low bits changed by the line
+    hash = (hash ^ (hash >> MIX_SHIFT)) * MIX_MULTIPLIER;
+    hash ^= hash >> MIX_SHIFT;
+    return (hash == EMPTY_KEY) ? 1 : hash;
 }
 
-struct EventWroteRecord {
-    size_t count = 0;
-    uint64_t timestamp = INVALID_TIME_STAMP;
+struct CallSiteEntry {
+    std::atomic<uint64_t> key { EMPTY_KEY };
+    WriteControlSlot slot;
 };
 
-struct EventWroteCacheNode {
-    std::list<uint64_t>::const_iterator iter;
-    struct EventWroteRecord record;
+struct alignas(64) CallSiteShard {
+    CallSiteEntry entries[ENTRY_CNT_OF_SHARD];
 };
-}
-
-class EventWroteLruCache {
-public:
-    explicit EventWroteLruCache(size_t capacity): capacity_(capacity) {}
-
-    ~EventWroteLruCache()
-    {
-        key2Index_.clear();
-    }
 
+/*
+ * Slots of the call sites without static slots, e.g. those of NAPI, ANI and C api. Entries are claimed by CAS, and
+ * the one whose period started earliest is taken over once all entries probed are claimed. Events of the call site
+ * taken over may be counted into the new one meanwhile, which is tolerated by the limit.
+ */
+class CallSiteRegistry {
 public:
-    struct EventWroteRecord Get(uint64_t key)
-    {
-        std::lock_guard<std::mutex> lock(mutex_);
-        EventWroteRecord record;
-        if (key2Index_.count(key) == 0) {
-            return record;
-        }
-        Modify(key);
-        return key2Index_[key].record;
-    }
-
-    void Put(uint64_t key, struct EventWroteRecord record)
+    WriteControlSlot& GetSlot(uint64_t key)
     {
-        std::lock_guard<std::mutex> lock(mutex_);
-        if (capacity_ == 0) {
-            return;
+        auto& shard = shards_[(key >> SHARD_SHIFT) % SHARD_CNT];
+        CallSiteEntry* oldestEntry = nullptr;
+        for (size_t i = 0; i < MAX_PROBE_CNT; ++i) {
+            auto& entry = shard.entries[(key + i) % ENTRY_CNT_OF_SHARD];
+            uint64_t entryKey = entry.key.load(std::memory_order_acquire);
+            if (entryKey == EMPTY_KEY &&
+                (entry.key.compare_exchange_strong(entryKey, key, std::memory_order_acq_rel) || entryKey == key)) {
+                return entry.slot;
+            }
+            if (entryKey == key) {
+                return entry.slot;
+            }
+            if (oldestEntry == nullptr || entry.slot.state.load(std::memory_order_relaxed) <
+                oldestEntry->slot.state.load(std::memory_order_relaxed)) {
+                oldestEntry = &entry;
+            }
         }
-        if (key2Index_.count(key) > 0) {
-            key2Index_[key].record = record;
-            Modify(key);
-            return;
-        }
-        if (keyCache_.size() == capacity_) {
-            key2Index_.erase(keyCache_.back());
-            keyCache_.pop_back();
-        }
-        keyCache_.push_front(key);
-        key2Index_[key] = {
-            .iter = keyCache_.cbegin(),
-            .record = record
-        };
-    }
-
-private:
-    void Modify(uint64_t key)
-    {
-        keyCache_.splice(keyCache_.begin(), keyCache_, key2Index_[key].iter);
-        key2Index_[key].iter = keyCache_.cbegin();
+        oldestEntry->slot.state.store(0, std::memory_order_relaxed);
+        oldestEntry->key.store(key, std::memory_order_release);
+        return oldestEntry->slot;
     }
 
 private:
-    std::mutex mutex_;
-    std::unordered_map<uint64_t, EventWroteCacheNode> key2Index_;
-    std::list<uint64_t> keyCache_;
-    size_t capacity_ = 0;
+    CallSiteShard shards_[SHARD_CNT];
 };
 
-__attribute__((no_destroy)) EventWroteLruCache WriteController::eventWroteLruCache_(LRU_CACHE_DEFAULT_SIZE);
+__attribute__((no_destroy)) CallSiteRegistry g_callSiteRegistry;
+}
 
 uint64_t WriteController::GetCurrentTimeMills()
 {
@@ -140,29 +128,44 @@ uint64_t WriteController::GetCurrentTimeMills()
 uint64_t WriteController::CheckLimitWritingEvent(const ControlParam& param, const char* domain, const char* eventName,
     const CallerInfo& callerInfo)
 {
-    uint64_t key = ConcatenateInfoAsKey(eventName, callerInfo.func, callerInfo.line);
-    auto record = eventWroteLruCache_.Get(key);
-    uint64_t cur = callerInfo.timeStamp;
-    const uint64_t secToMillis = 1000; // second to millisecond
-    if ((record.count == 0) || ((record.timestamp / secToMillis) + param.period < (cur / secToMillis)) ||
-        ((record.timestamp / secToMillis) > (cur / secToMillis))) {
-        record.count = 1; // record the first event writing during one cycle
-        record.timestamp = cur;
-        eventWroteLruCache_.Put(key, record);
-        return cur;
-    }
-    record.count++;
-    if (record.count <= param.threshold) {
-        eventWroteLruCache_.Put(key, record);
-        return cur;
+    auto& slot = g_callSiteRegistry.GetSlot(GenerateCallSiteKey(eventName, callerInfo.func, callerInfo.line));
+    return CheckLimitWritingEvent(param, slot, domain, eventName, callerInfo.func, callerInfo.timeStamp);
+}
+
+uint64_t WriteController::CheckLimitWritingEvent(const ControlParam& param, WriteControlSlot& slot,
+    const char* domain, const char* eventName, const char* func)
+{
+    return CheckLimitWritingEvent(param, slot, domain, eventName, func, GetCurrentTimeMills());
+}
+
+uint64_t WriteController::CheckLimitWritingEvent(const ControlParam& param, WriteControlSlot& slot,
+    const char* domain, const char* eventName, const char* func, uint64_t timeStamp)
+{
+    uint64_t cur = timeStamp / SEC_TO_MILLIS;
+    uint64_t state = slot.state.load(std::memory_order_relaxed);
+    uint64_t newState = state;
+    do {
+        uint64_t begin = state >> COUNT_BITS;
+        uint64_t count = state & COUNT_MASK;
+        if ((count == 0) || (begin + param.period < cur) || (begin > cur)) {
+            newState = (cur << COUNT_BITS) | 1; // record the first event writing during one cycle
+        } else if (count < COUNT_MASK) {
+            newState = state + 1;
+        } else {
+            newState = state; // count is saturated, events are discarded until the next cycle
+            break;
+        }
+    } while (!slot.state.compare_exchange_weak(state, newState, std::memory_order_relaxed));
+    uint64_t count = newState & COUNT_MASK;
+    if (count <= param.threshold) {
+        return timeStamp;
     }
-    eventWroteLruCache_.Put(key, record);
     HILOG_DEBUG(LOG_CORE, "{.period = %{public}zu, .threshold = %{public}zu} "
         "[%{public}lld, %{public}lld] discard %{public}zu event(s) "
         "with domain %{public}s and name %{public}s which wrote in function %{public}s.",
-        param.period, param.threshold, static_cast<long long>(record.timestamp / secToMillis),
-        static_cast<long long>(cur / secToMillis), record.count - param.threshold,
-        domain, eventName, callerInfo.func);
+        param.period, param.threshold, static_cast<long long>(newState >> COUNT_BITS),
+        static_cast<long long>(cur), static_cast<size_t>(count - param.threshold),
+        domain, eventName, func);
     return INVALID_TIME_STAMP;
 }
 
@@ -136,6 +136,13 @@ std::string HiSysEventRecord::GetTag() const
     return GetStringValueByKey("tag_");
 }
 
+double HiSysEventRecord::GetSampleRate() const
+{
+    double sampleRate = 1.0; // events never sampled are kept at full rate
+    (void)GetParamValue("sample_rate_", sampleRate);
+    return sampleRate;
+}
+
 void HiSysEventRecord::GetParamNames(std::vector<std::string>& params) const
 {
     jsonVal_->GetParamNames(params);
@@ -54,6 +54,7 @@ public:
     uint64_t GetSpanId() const;
     uint64_t GetTime() const;
     uint64_t GetTraceId() const;
+    double GetSampleRate() const;
     void GetParamNames(std::vector<std::string>& params) const;
 
 public:
@@ -684,3 +684,145 @@ HWTEST_F(HiSysEventCTest, HiSysEventCTest013, TestSize.Level3)
         }
     }
 }
+
+/**
+ * @tc.name: HiSysEventCTest014
+ * @tc.desc: Test writing of prepared events.
+ * @tc.type: FUNC
+ * @tc.require: user-006
+ */
+HWTEST_F(HiSysEventCTest, HiSysEventCTest014, TestSize.Level3)
+{
+    /**
+     * @tc.steps: step1. prepare event.
+     * @tc.steps: step2. write event with params in the same order and of the same types as the prepared ones.
+     * @tc.steps: step3. check the result of writing.
+     */
+    int32_t int32s[] = { 1, 2, 3 };
+    HiSysEventParam params[] = {
+        { .name = "KEY_INT32", .t = HISYSEVENT_INT32, .v = { .i32 = 1 }, .arraySize = 0 },
+        { .name = "KEY_STRING", .t = HISYSEVENT_STRING, .v = { .s = const_cast<char*>("abc") }, .arraySize = 0 },
+        { .name = "KEY_INT32_ARR", .t = HISYSEVENT_INT32_ARRAY, .v = { .array = int32s }, .arraySize = 3 },
+    };
+    size_t len = sizeof(params) / sizeof(params[0]);
+    ASSERT_EQ(HiSysEvent_PrepareEvent("_INVALID_DOMAIN", TEST_NAME, HISYSEVENT_BEHAVIOR, params, len), nullptr);
+    ASSERT_EQ(OH_HiSysEvent_WritePreparedEvent(nullptr, params, len), ERR_EMPTY_EVENT);
+    HiSysEventPreparedEvent* event = HiSysEvent_PrepareEvent(TEST_DOMAIN, TEST_NAME, HISYSEVENT_BEHAVIOR,
+        params, len);
+    ASSERT_NE(event, nullptr);
+    for (int32_t i = 0; i < 3; ++i) { // write 3 times
+        params[0].v.i32 = i;
+        ASSERT_EQ(OH_HiSysEvent_WritePreparedEvent(event, params, len), 0);
+    }
+    params[0].t = HISYSEVENT_UINT32; // type is different from the prepared one
+    ASSERT_EQ(OH_HiSysEvent_WritePreparedEvent(event, params, len), ERR_VALUE_INVALID);
+    HiSysEvent_DestroyPreparedEvent(event);
+}
+
+/**
+ * @tc.name: HiSysEventCTest015
+ * @tc.desc: Test writing of long string array params whose items beyond max size are discarded, prepared or not.
+ * @tc.type: FUNC
+ * @tc.require: user-008
+ */
+HWTEST_F(HiSysEventCTest, HiSysEventCTest015, TestSize.Level3)
+{
+    /**
+     * @tc.steps: step1. create event with a string array whose items beyond max size are null.
+     * @tc.steps: step2. write event.
+     * @tc.steps: step3. check the result of writing.
+     */
+    char* strs[MAX_ARRAY_SIZE + 1] = { nullptr };
+    for (size_t i = 0; i < MAX_ARRAY_SIZE; ++i) {
+        strs[i] = const_cast<char*>("abc");
+    }
+    HiSysEventParam params[] = {
+        {
+            .name = "KEY_STR_ARR", .t = HISYSEVENT_STRING_ARRAY, .v = { .array = strs },
+            .arraySize = MAX_ARRAY_SIZE + 1
+        },
+    };
+    size_t len = sizeof(params) / sizeof(params[0]);
+    int res = OH_HiSysEvent_Write(TEST_DOMAIN, TEST_NAME, HISYSEVENT_BEHAVIOR, params, len);
+    ASSERT_EQ(res, ERR_ARRAY_TOO_MUCH);
+    HiSysEventPreparedEvent* event = HiSysEvent_PrepareEvent(TEST_DOMAIN, TEST_NAME, HISYSEVENT_BEHAVIOR,
+        params, len);
+    ASSERT_NE(event, nullptr);
+    ASSERT_EQ(OH_HiSysEvent_WritePreparedEvent(event, params, len), ERR_ARRAY_TOO_MUCH);
+    strs[0] = nullptr;
+    ASSERT_EQ(OH_HiSysEvent_WritePreparedEvent(event, params, len), ERR_VALUE_INVALID);
+    HiSysEvent_DestroyPreparedEvent(event);
+    res = OH_HiSysEvent_Write(TEST_DOMAIN, TEST_NAME, HISYSEVENT_BEHAVIOR, params, len);
+    ASSERT_EQ(res, ERR_VALUE_INVALID);
+}
+
+/**
+ * @tc.name: HiSysEventCTest016
+ * @tc.desc: Test writing events in batch.
+ * @tc.type: FUNC
+ * @tc.require: user-014
+ */
+HWTEST_F(HiSysEventCTest, HiSysEventCTest016, TestSize.Level3)
+{
+    /**
+     * @tc.steps: step1. create events, one of which has no name.
+     * @tc.steps: step2. write events in batch.
+     * @tc.steps: step3. check the results of writing.
+     */
+    HiSysEventParam params[] = {
+        { .name = "KEY_INT32", .t = HISYSEVENT_INT32, .v = { .i32 = 1 }, .arraySize = 0 },
+        { .name = "KEY_STRING", .t = HISYSEVENT_STRING, .v = { .s = const_cast<char*>("abc") }, .arraySize = 0 },
+    };
+    HiSysEventBatchEvent events[] = {
+        { .domain = TEST_DOMAIN, .name = TEST_NAME, .type = HISYSEVENT_STATISTIC, .params = params,
+            .size = sizeof(params) / sizeof(params[0]) },
+        { .domain = TEST_DOMAIN, .name = nullptr, .type = HISYSEVENT_STATISTIC, .params = params,
+            .size = sizeof(params) / sizeof(params[0]) },
+        { .domain = TEST_DOMAIN, .name = TEST_NAME, .type = HISYSEVENT_BEHAVIOR, .params = nullptr, .size = 0 },
+    };
+    size_t len = sizeof(events) / sizeof(events[0]);
+    int retCodes[sizeof(events) / sizeof(events[0])] = { 0 };
+    int res = OH_HiSysEvent_WriteBatch(events, len, retCodes);
+    ASSERT_EQ(res, ERR_EVENT_NAME_INVALID);
+    ASSERT_EQ(retCodes[0], SUCCESS);
+    ASSERT_EQ(retCodes[1], ERR_EVENT_NAME_INVALID);
+    ASSERT_EQ(retCodes[2], SUCCESS); // 2: the last event
+    res = OH_HiSysEvent_WriteBatch(events, 1, nullptr);
+    ASSERT_EQ(res, SUCCESS);
+    res = OH_HiSysEvent_WriteBatch(nullptr, len, retCodes);
+    ASSERT_EQ(res, ERR_EMPTY_EVENT);
+}
+
+/**
+ * @tc.name: HiSysEventCTest017
+ * @tc.desc: Test writing event whose params are filled after the event passes the checks.
+ * @tc.type: FUNC
+ * @tc.require: user-024
+ */
+HWTEST_F(HiSysEventCTest, HiSysEventCTest017, TestSize.Level3)
+{
+    /**
+     * @tc.steps: step1. write event with a filler of params.
+     * @tc.steps: step2. write invalid event with the filler.
+     * @tc.steps: step3. check the results of writing and the times the filler is called.
+     */
+    auto filler = [](void* context, HiSysEventParam params[], size_t size) -> size_t {
+        ++(*static_cast<int*>(context));
+        if (size < 2) { // 2: params filled
+            return 0;
+        }
+        params[0] = { .name = "KEY_INT32", .t = HISYSEVENT_INT32, .v = { .i32 = 1 }, .arraySize = 0 };
+        params[1] = { .name = "KEY_STRING", .t = HISYSEVENT_STRING, .v = { .s = const_cast<char*>("abc") },
+            .arraySize = 0 };
+        return 2; // 2: params filled
+    };
+    int filledCnt = 0;
+    int res = OH_HiSysEvent_WriteLazy(TEST_DOMAIN, TEST_NAME, HISYSEVENT_BEHAVIOR, filler, &filledCnt);
+    ASSERT_EQ(res, SUCCESS);
+    ASSERT_EQ(filledCnt, 1);
+    res = OH_HiSysEvent_WriteLazy(TEST_DOMAIN, "", HISYSEVENT_BEHAVIOR, filler, &filledCnt);
+    ASSERT_EQ(res, ERR_EVENT_NAME_INVALID);
+    ASSERT_EQ(filledCnt, 1);
+    res = OH_HiSysEvent_WriteLazy(TEST_DOMAIN, TEST_NAME, HISYSEVENT_BEHAVIOR, nullptr, nullptr);
+    ASSERT_EQ(res, SUCCESS);
+}
@@ -15,25 +15,97 @@
 
 #include <gtest/gtest.h>
 
+#include <chrono>
+#include <cstring>
+#include <fstream>
 #include <limits>
 #include <memory>
+#include <string>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
 
 #include "gtest/gtest-message.h"
 #include "gtest/gtest-test-part.h"
 #include "gtest/hwext/gtest-ext.h"
 #include "gtest/hwext/gtest-tag.h"
 
+#include "congestion_control.h"
 #include "encoded_param.h"
+#include "event_control.h"
+#include "event_journal.h"
+#include "event_rate_limiter.h"
+#include "event_route_table.h"
 #include "hisysevent.h"
+#include "io_uring_sender.h"
 #include "raw_data_base_def.h"
 #include "raw_data_encoder.h"
 #include "raw_data.h"
+#include "securec.h"
+#include "shared_memory_ring.h"
 #include "transport.h"
+#include "transport_backend.h"
 
 using namespace testing::ext;
 using namespace OHOS::HiviewDFX;
 using namespace OHOS::HiviewDFX::Encoded;
 
+namespace {
+constexpr unsigned int TAG_BYTE_OFFSET = 5;
+constexpr uint8_t TAG_BYTE_BOUND = (1 << TAG_BYTE_OFFSET);
+constexpr uint8_t TAG_BYTE_MASK = (TAG_BYTE_BOUND - 1);
+constexpr unsigned int NON_TAG_BYTE_OFFSET = 7;
+constexpr uint8_t NON_TAG_BYTE_BOUND = (1 << NON_TAG_BYTE_OFFSET);
+constexpr uint8_t NON_TAG_BYTE_MASK = (NON_TAG_BYTE_BOUND - 1);
+
+uint64_t DecodeUnsignedVarint(const uint8_t* data, size_t len, size_t& pos)
+{
+    uint8_t curByte = data[pos++];
+    uint64_t val = curByte & TAG_BYTE_MASK;
+    unsigned int offset = TAG_BYTE_OFFSET;
+    bool isContinued = (curByte & TAG_BYTE_BOUND) != 0;
+    while (isContinued && pos < len) {
+        curByte = data[pos++];
+        val |= static_cast<uint64_t>(curByte & NON_TAG_BYTE_MASK) << offset;
+        offset += NON_TAG_BYTE_OFFSET;
+        isContinued = (curByte & NON_TAG_BYTE_BOUND) != 0;
+    }
+    return val;
+}
+
+void BuildRawEvent(RawData& rawData, const char* name, size_t extraSize)
+{
+    HiSysEventHeader header = { "DEMO", "", 0, 0, 0, 0, 0, 0, HiSysEvent::EventType::BEHAVIOR - 1, 0 };
+    (void)strcpy_s(header.name, sizeof(header.name), name);
+    int32_t paramCnt = 0;
+    int32_t blockSize = static_cast<int32_t>(sizeof(blockSize) + sizeof(header) + sizeof(paramCnt) + extraSize);
+    std::vector<uint8_t> extraData(extraSize, 0);
+    (void)rawData.Append(reinterpret_cast<uint8_t*>(&blockSize), sizeof(blockSize));
+    (void)rawData.Append(reinterpret_cast<uint8_t*>(&header), sizeof(header));
+    (void)rawData.Append(reinterpret_cast<uint8_t*>(&paramCnt), sizeof(paramCnt));
+    (void)rawData.Append(extraData.data(), extraData.size());
+}
+
+std::string GetEventName(const RawData& rawData)
+{
+    return reinterpret_cast<HiSysEventHeader*>(rawData.GetData() + sizeof(int32_t))->name;
+}
+
+std::vector<uint64_t> GetBoundaryValuesOfVarint()
+{
+    std::vector<uint64_t> vals = { 0, std::numeric_limits<uint64_t>::max() };
+    for (unsigned int bitCnt = TAG_BYTE_OFFSET; bitCnt < 64; bitCnt += NON_TAG_BYTE_OFFSET) { // 64 bits of uint64
+        uint64_t bound = 1ULL << bitCnt;
+        vals.emplace_back(bound - 1);
+        vals.emplace_back(bound);
+    }
+    return vals;
+}
+}
+
 class HiSysEventEncodedTest : public testing::Test {
 public:
     static void SetUpTestCase(void);
@@ -135,3 +207,688 @@ HWTEST_F(HiSysEventEncodedTest, TransportTest001, TestSize.Level1)
     ASSERT_TRUE(!rawData2->IsEmpty());
     ASSERT_EQ(Transport::GetInstance().SendData(*rawData2), SUCCESS);
 }
+
+/**
+ * @tc.name: CongestionControlTest001
+ * @tc.desc: States of congestion control entered by results of sending
+ * @tc.type: FUNC
+ * @tc.require: user-013
+ */
+HWTEST_F(HiSysEventEncodedTest, CongestionControlTest001, TestSize.Level1)
+{
+    CongestionControl control;
+    ASSERT_TRUE(control.IsSendAllowed(false));
+    control.OnSendBlocked();
+    control.OnSendBlocked();
+    ASSERT_EQ(control.GetStats().congestedCnt, 1);
+    control.OnSendFailed();
+    control.OnSendFailed();
+    ASSERT_TRUE(control.IsSendAllowed(false));
+    control.OnSendFailed();
+    ASSERT_EQ(control.GetStats().brokenCnt, 1);
+    ASSERT_TRUE(control.IsSendAllowed(true));
+    ASSERT_FALSE(control.IsSendAllowed(false));
+    ASSERT_EQ(control.GetStats().skippedCnt, 1);
+
+    // one send is allowed to probe after the circuit has been broken for a while
+    std::this_thread::sleep_for(std::chrono::milliseconds(150)); // 150ms: longer than the time of breaking
+    ASSERT_TRUE(control.IsSendAllowed(false));
+    ASSERT_FALSE(control.IsSendAllowed(false));
+    control.OnSendSucceeded();
+    ASSERT_TRUE(control.IsSendAllowed(false));
+    auto stats = control.GetStats();
+    ASSERT_EQ(stats.congestedCnt, 1);
+    ASSERT_EQ(stats.brokenCnt, 1);
+    ASSERT_EQ(stats.recoveredCnt, 1);
+    ASSERT_EQ(stats.skippedCnt, 2); // 2: sends skipped before and after the probe
+}
+
+/**
+ * @tc.name: RawDataEncoderTest001
+ * @tc.desc: Encode integer arrays as varints in batch
+ * @tc.type: FUNC
+ * @tc.require: user-009
+ */
+HWTEST_F(HiSysEventEncodedTest, RawDataEncoderTest001, TestSize.Level1)
+{
+    auto vals = GetBoundaryValuesOfVarint();
+    Encoded::RawData batchData;
+    ASSERT_TRUE(RawDataEncoder::UnsignedVarintArrayEncoded<uint64_t>(batchData, vals.begin(), vals.size()));
+    Encoded::RawData data;
+    size_t encodedSize = 0;
+    for (auto val : vals) {
+        ASSERT_TRUE(RawDataEncoder::UnsignedVarintEncoded(data, EncodeType::VARINT, val));
+        encodedSize += RawDataEncoder::UnsignedVarintEncodedSize(val);
+    }
+    ASSERT_EQ(batchData.GetDataLength(), encodedSize);
+    ASSERT_EQ(data.GetDataLength(), encodedSize);
+    ASSERT_EQ(memcmp(batchData.GetData(), data.GetData(), encodedSize), 0);
+    size_t pos = 0;
+    for (auto val : vals) {
+        ASSERT_EQ(DecodeUnsignedVarint(batchData.GetData(), batchData.GetDataLength(), pos), val);
+    }
+    ASSERT_EQ(pos, encodedSize);
+
+    std::vector<int64_t> signedVals = { 0, -1, 1, std::numeric_limits<int64_t>::min(),
+        std::numeric_limits<int64_t>::max() };
+    Encoded::RawData signedBatchData;
+    ASSERT_TRUE(RawDataEncoder::SignedVarintArrayEncoded<int64_t>(signedBatchData, signedVals.begin(),
+        signedVals.size()));
+    pos = 0;
+    for (auto val : signedVals) {
+        uint64_t zigzagVal = DecodeUnsignedVarint(signedBatchData.GetData(), signedBatchData.GetDataLength(), pos);
+        ASSERT_EQ(static_cast<int64_t>((zigzagVal >> 1) ^ (~(zigzagVal & 1) + 1)), val);
+    }
+    ASSERT_EQ(pos, signedBatchData.GetDataLength());
+}
+
+/**
+ * @tc.name: SharedMemoryRingTest001
+ * @tc.desc: Events wrote into the shared memory ring are decoded by the consumer in order while the ring wraps around
+ * @tc.type: FUNC
+ * @tc.require: user-016
+ */
+HWTEST_F(HiSysEventEncodedTest, SharedMemoryRingTest001, TestSize.Level1)
+{
+    constexpr size_t ringCapacity = 4096;
+    SharedMemoryRing ring;
+    ASSERT_FALSE(ring.Init(ringCapacity + 1)); // capacity must be a power of 2
+    ASSERT_TRUE(ring.Init(ringCapacity));
+    RawData unconsumedData;
+    BuildRawEvent(unconsumedData, "UNCONSUMED_EVENT", 0);
+    ASSERT_EQ(ring.Write(unconsumedData), ERR_DOES_NOT_INIT); // nothing is wrote before the consumer maps the ring
+    SharedMemoryRingConsumer consumer;
+    ASSERT_TRUE(consumer.Attach(dup(ring.GetMemFd()), dup(ring.GetEventFd())));
+    RawData oversizedData;
+    BuildRawEvent(oversizedData, "OVERSIZED_EVENT", ringCapacity / 2); // 2: entries over half of the ring
+    ASSERT_EQ(ring.Write(oversizedData), ERR_OVER_SIZE);
+
+    constexpr size_t extraSize = 300; // entries are not aligned with the end of the ring
+    constexpr int roundCnt = 5;
+    for (int round = 0; round < roundCnt; ++round) {
+        std::vector<std::string> wroteNames;
+        while (true) {
+            std::string name = "EVENT_" + std::to_string(wroteNames.size());
+            RawData rawData;
+            BuildRawEvent(rawData, name.c_str(), extraSize);
+            if (ring.Write(rawData) != SUCCESS) {
+                break;
+            }
+            wroteNames.emplace_back(name);
+        }
+        ASSERT_GT(wroteNames.size(), 1);
+        std::vector<std::string> consumedNames;
+        auto consumedCnt = consumer.Consume([&consumedNames] (const HiSysEventHeader& header, const uint8_t*,
+            size_t len) {
+            ASSERT_EQ(len, sizeof(int32_t) + sizeof(HiSysEventHeader) + sizeof(int32_t) + extraSize);
+            consumedNames.emplace_back(header.name);
+        });
+        ASSERT_EQ(consumedCnt, wroteNames.size());
+        ASSERT_EQ(consumedNames, wroteNames);
+    }
+}
+
+/**
+ * @tc.name: SharedMemoryRingTest002
+ * @tc.desc: The ring handed over through the socket wakes up the consumer waiting for events
+ * @tc.type: FUNC
+ * @tc.require: user-016
+ */
+HWTEST_F(HiSysEventEncodedTest, SharedMemoryRingTest002, TestSize.Level1)
+{
+    EventSocket daemonAddr = { .sun_family = AF_UNIX, .sun_path = "\0hisysevent_ring_test" }; // abstract address
+    int socketId = socket(AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+    ASSERT_GE(socketId, 0);
+    ASSERT_EQ(bind(socketId, reinterpret_cast<const sockaddr*>(&daemonAddr), sizeof(daemonAddr)), 0);
+    constexpr size_t ringCapacity = 4096;
+    SharedMemoryRing ring;
+    ASSERT_EQ(ring.HandOver(daemonAddr), ERR_DOES_NOT_INIT);
+    ASSERT_TRUE(ring.Init(ringCapacity));
+    ASSERT_EQ(ring.HandOver(daemonAddr), SUCCESS);
+    SharedMemoryRingConsumer consumer;
+    ASSERT_TRUE(consumer.Accept(socketId));
+    close(socketId);
+
+    ASSERT_FALSE(consumer.Wait(0));
+    RawData rawData;
+    BuildRawEvent(rawData, "DEMO_EVENT", 0);
+    std::thread writer([&ring, &rawData] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50)); // 50ms: wait for the consumer to sleep
+        (void)ring.Write(rawData);
+    });
+    constexpr int waitTimeout = 5000; // 5s
+    ASSERT_TRUE(consumer.Wait(waitTimeout));
+    writer.join();
+    ASSERT_EQ(consumer.Consume([] (const HiSysEventHeader& header, const uint8_t*, size_t) {
+        ASSERT_STREQ(header.name, "DEMO_EVENT");
+    }), 1);
+}
+
+/**
+ * @tc.name: SharedMemoryRingTest003
+ * @tc.desc: The consumer is taken as stalled only if the ring is kept full without being consumed
+ * @tc.type: FUNC
+ * @tc.require: user-016
+ */
+HWTEST_F(HiSysEventEncodedTest, SharedMemoryRingTest003, TestSize.Level1)
+{
+    constexpr size_t ringCapacity = 4096;
+    SharedMemoryRing ring;
+    ASSERT_FALSE(ring.IsConsumerStalled(0));
+    ASSERT_TRUE(ring.Init(ringCapacity));
+    SharedMemoryRingConsumer consumer;
+    ASSERT_TRUE(consumer.Attach(dup(ring.GetMemFd()), dup(ring.GetEventFd())));
+    RawData rawData;
+    BuildRawEvent(rawData, "DEMO_EVENT", 0);
+    while (ring.Write(rawData) == SUCCESS) {}
+    constexpr uint64_t stallTimeout = 1000; // 1s
+    ASSERT_FALSE(ring.IsConsumerStalled(0)); // the read position is recorded once the ring is found full
+    ASSERT_FALSE(ring.IsConsumerStalled(stallTimeout));
+    ASSERT_TRUE(ring.IsConsumerStalled(0));
+
+    ASSERT_GT(consumer.Consume([] (const HiSysEventHeader&, const uint8_t*, size_t) {}), 0);
+    ASSERT_FALSE(ring.IsConsumerStalled(0));
+}
+
+/**
+ * @tc.name: IoUringSenderTest001
+ * @tc.desc: Events submitted to io_uring are received by the server in order
+ * @tc.type: FUNC
+ * @tc.require: user-017
+ */
+HWTEST_F(HiSysEventEncodedTest, IoUringSenderTest001, TestSize.Level1)
+{
+    IoUringSender sender;
+    if (!sender.Init()) {
+        return; // io_uring is unavailable, events are sent by sockets
+    }
+    EventSocket serverAddr = { .sun_family = AF_UNIX, .sun_path = "\0hisysevent_io_uring_test" }; // abstract address
+    int socketId = socket(AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+    ASSERT_GE(socketId, 0);
+    ASSERT_EQ(bind(socketId, reinterpret_cast<const sockaddr*>(&serverAddr), sizeof(serverAddr)), 0);
+    RawData overSizeData;
+    BuildRawEvent(overSizeData, "DEMO_EVENT", 8192); // 8192: larger than the registered buffer
+    ASSERT_EQ(sender.Send(serverAddr, overSizeData), ERR_DOES_NOT_INIT);
+
+    constexpr size_t eventCnt = 16; // less than the registered buffers, so none of the events is dropped
+    for (size_t i = 0; i < eventCnt; ++i) {
+        RawData rawData;
+        BuildRawEvent(rawData, ("DEMO_EVENT_" + std::to_string(i)).c_str(), i);
+        ASSERT_EQ(sender.Send(serverAddr, rawData), SUCCESS);
+    }
+    struct timeval timeout = { .tv_sec = 5, .tv_usec = 0 }; // 5s
+    ASSERT_EQ(setsockopt(socketId, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout)), 0);
+    uint8_t buffer[1024] = { 0 }; // 1024: larger than the events
+    for (size_t i = 0; i < eventCnt; ++i) {
+        ssize_t len = recv(socketId, buffer, sizeof(buffer), 0);
+        ASSERT_EQ(len, static_cast<ssize_t>(sizeof(int32_t) + sizeof(HiSysEventHeader) + sizeof(int32_t) + i));
+        auto header = reinterpret_cast<HiSysEventHeader*>(buffer + sizeof(int32_t));
+        ASSERT_EQ(std::string(header->name), "DEMO_EVENT_" + std::to_string(i));
+    }
+    close(socketId);
+    constexpr int maxWaitCnt = 500;
+    for (int i = 0; i < maxWaitCnt && sender.GetStats().completedCnt < eventCnt; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10)); // 10ms: wait for the reaper
+    }
+    auto stats = sender.GetStats();
+    ASSERT_EQ(stats.submittedCnt, eventCnt);
+    ASSERT_EQ(stats.completedCnt, eventCnt);
+    ASSERT_EQ(stats.failedCnt, 0);
+}
+
+/**
+ * @tc.name: IoUringSenderTest002
+ * @tc.desc: Data of the writes failed since the server is gone is handed over to the failure handler by the reaper
+ * @tc.type: FUNC
+ * @tc.require: user-017
+ */
+HWTEST_F(HiSysEventEncodedTest, IoUringSenderTest002, TestSize.Level1)
+{
+    IoUringSender sender;
+    if (!sender.Init()) {
+        return; // io_uring is unavailable, events are sent by sockets
+    }
+    std::vector<std::string> failedNames;
+    sender.SetFailureHandler([&failedNames] (const RawData& rawData) {
+        auto header = reinterpret_cast<const HiSysEventHeader*>(rawData.GetData() + sizeof(int32_t));
+        failedNames.emplace_back(header->name);
+    });
+    EventSocket serverAddr = { .sun_family = AF_UNIX, .sun_path = "\0hisysevent_io_uring_fail_test" };
+    int socketId = socket(AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+    ASSERT_GE(socketId, 0);
+    ASSERT_EQ(bind(socketId, reinterpret_cast<const sockaddr*>(&serverAddr), sizeof(serverAddr)), 0);
+    RawData rawData;
+    BuildRawEvent(rawData, "DEMO_EVENT", 0);
+    ASSERT_EQ(sender.Send(serverAddr, rawData), SUCCESS); // the socket is connected to the server
+    uint8_t buffer[1024] = { 0 }; // 1024: larger than the event
+    ASSERT_GT(recv(socketId, buffer, sizeof(buffer), 0), 0);
+    close(socketId);
+
+    RawData failedData;
+    BuildRawEvent(failedData, "FAILED_EVENT", 0);
+    ASSERT_EQ(sender.Send(serverAddr, failedData), SUCCESS);
+    // the completion is reaped without any more send, and the handler is called before the stats are visible
+    constexpr int maxWaitCnt = 500;
+    for (int i = 0; i < maxWaitCnt && sender.GetStats().failedCnt == 0; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10)); // 10ms: wait for the reaper
+    }
+    ASSERT_EQ(sender.GetStats().failedCnt, 1);
+    ASSERT_EQ(failedNames, std::vector<std::string>({ "FAILED_EVENT" }));
+}
+
+/**
+ * @tc.name: EventRouteTableTest001
+ * @tc.desc: Events are routed by the builtin rules and by the rules loaded from the config file
+ * @tc.type: FUNC
+ * @tc.require: user-018
+ */
+HWTEST_F(HiSysEventEncodedTest, EventRouteTableTest001, TestSize.Level1)
+{
+    auto builtinTable = EventRouteTable::Load("/data/test/not_exist_route.conf");
+    ASSERT_GT(builtinTable.GetRuleCnt(), 0);
+    ASSERT_TRUE(builtinTable.IsHigherPriority("AAFWK", "THREAD_BLOCK_6S", HiSysEvent::EventType::BEHAVIOR));
+    ASSERT_FALSE(builtinTable.IsHigherPriority("AAFWK", "THREAD_BLOCK_9S", HiSysEvent::EventType::BEHAVIOR));
+    ASSERT_TRUE(builtinTable.IsHigherPriority("RELIABILITY", "ANY_EVENT", HiSysEvent::EventType::FAULT));
+    ASSERT_FALSE(builtinTable.IsHigherPriority("RELIABILITY", "ANY_EVENT", HiSysEvent::EventType::STATISTIC));
+
+    std::string configPath = "/data/test/hisysevent_route_test.conf";
+    std::ofstream(configPath) << "# domain name [type ...]\n\nDEMO DEMO_EVENT\nDEMO * FAULT SECURITY\n";
+    auto table = EventRouteTable::Load(configPath);
+    ASSERT_EQ(table.GetRuleCnt(), 2); // 2: rules in the config file
+    ASSERT_TRUE(table.IsHigherPriority("DEMO", "DEMO_EVENT", HiSysEvent::EventType::STATISTIC));
+    ASSERT_TRUE(table.IsHigherPriority("DEMO", "OTHER_EVENT", HiSysEvent::EventType::SECURITY));
+    ASSERT_FALSE(table.IsHigherPriority("DEMO", "OTHER_EVENT", HiSysEvent::EventType::BEHAVIOR));
+    ASSERT_FALSE(table.IsHigherPriority("AAFWK", "THREAD_BLOCK_6S", HiSysEvent::EventType::BEHAVIOR));
+
+    // rules of an invalid config file are dropped in favor of the builtin ones
+    std::ofstream(configPath) << "DEMO DEMO_EVENT UNKNOWN_TYPE\n";
+    ASSERT_EQ(EventRouteTable::Load(configPath).GetRuleCnt(), builtinTable.GetRuleCnt());
+    (void)unlink(configPath.c_str());
+}
+
+/**
+ * @tc.name: EventJournalTest001
+ * @tc.desc: Events appended to the journal are replayed in order while the journal wraps around
+ * @tc.type: FUNC
+ * @tc.require: user-019
+ */
+HWTEST_F(HiSysEventEncodedTest, EventJournalTest001, TestSize.Level1)
+{
+    constexpr size_t journalCapacity = 4096;
+    std::string journalPath = "/data/test/hisysevent_journal_test001.journal";
+    (void)unlink(journalPath.c_str());
+    EventJournalFile journal;
+    ASSERT_FALSE(journal.Create(journalPath, journalCapacity + 1)); // capacity must be a power of 2
+    ASSERT_TRUE(journal.Create(journalPath, journalCapacity));
+    ASSERT_TRUE(journal.IsEmpty());
+    RawData oversizedData;
+    BuildRawEvent(oversizedData, "OVERSIZED_EVENT", journalCapacity / 2); // 2: records over half of the journal
+    ASSERT_EQ(journal.Append(oversizedData), ERR_OVER_SIZE);
+
+    constexpr size_t extraSize = 300; // records are not aligned with the end of the journal
+    constexpr int roundCnt = 5;
+    for (int round = 0; round < roundCnt; ++round) {
+        std::vector<std::string> appendedNames;
+        while (true) {
+            std::string name = "EVENT_" + std::to_string(appendedNames.size());
+            RawData rawData;
+            BuildRawEvent(rawData, name.c_str(), extraSize);
+            if (journal.Append(rawData) != SUCCESS) {
+                break;
+            }
+            appendedNames.emplace_back(name);
+        }
+        ASSERT_GT(appendedNames.size(), 1);
+        // records failed to be handled are kept to be replayed again
+        uint64_t corruptedCnt = 0;
+        ASSERT_FALSE(journal.Replay([] (RawData&) { return false; }, corruptedCnt, false));
+        std::vector<std::string> replayedNames;
+        ASSERT_TRUE(journal.Replay([&replayedNames] (RawData& rawData) {
+            replayedNames.emplace_back(GetEventName(rawData));
+            return true;
+        }, corruptedCnt, false));
+        ASSERT_EQ(replayedNames, appendedNames);
+        ASSERT_EQ(corruptedCnt, 0);
+        ASSERT_TRUE(journal.IsEmpty());
+    }
+    (void)unlink(journalPath.c_str());
+}
+
+/**
+ * @tc.name: EventJournalTest002
+ * @tc.desc: Journal left by an exited process is replayed by others, and the corrupted records are skipped
+ * @tc.type: FUNC
+ * @tc.require: user-019
+ */
+HWTEST_F(HiSysEventEncodedTest, EventJournalTest002, TestSize.Level1)
+{
+    constexpr size_t journalCapacity = 4096;
+    constexpr size_t eventCnt = 3;
+    std::string journalPath = "/data/test/hisysevent_journal_test002.journal";
+    (void)unlink(journalPath.c_str());
+    auto journal = std::make_unique<EventJournalFile>();
+    ASSERT_TRUE(journal->Create(journalPath, journalCapacity));
+    for (size_t i = 0; i < eventCnt; ++i) {
+        RawData rawData;
+        BuildRawEvent(rawData, ("EVENT_" + std::to_string(i)).c_str(), 0);
+        ASSERT_EQ(journal->Append(rawData), SUCCESS);
+    }
+    // journal is locked until its owner exits
+    EventJournalFile orphan;
+    ASSERT_FALSE(orphan.Open(journalPath));
+    journal.reset();
+
+    // data of the first record is broken, as if its writer crashed while appending it
+    std::fstream file(journalPath, std::ios::in | std::ios::out | std::ios::binary);
+    file.seekp(sizeof(EventJournalHeader) + sizeof(EventJournalRecord));
+    file.put('\xFF');
+    file.close();
+    ASSERT_TRUE(orphan.Open(journalPath));
+    uint64_t corruptedCnt = 0;
+    std::vector<std::string> replayedNames;
+    ASSERT_TRUE(orphan.Replay([&replayedNames] (RawData& rawData) {
+        replayedNames.emplace_back(GetEventName(rawData));
+        return true;
+    }, corruptedCnt, true));
+    ASSERT_EQ(corruptedCnt, 1);
+    ASSERT_EQ(replayedNames, std::vector<std::string>({ "EVENT_1", "EVENT_2" }));
+    ASSERT_TRUE(orphan.IsEmpty());
+    (void)unlink(journalPath.c_str());
+}
+
+/**
+ * @tc.name: TransportBackendTest001
+ * @tc.desc: Events are captured in memory or sent to the socket path configured once the backend is set
+ * @tc.type: FUNC
+ * @tc.require: user-020
+ */
+HWTEST_F(HiSysEventEncodedTest, TransportBackendTest001, TestSize.Level1)
+{
+    constexpr size_t extraSize = 100;
+    constexpr size_t eventCnt = 3;
+    RawData rawData;
+    BuildRawEvent(rawData, "EVENT_0", extraSize);
+    constexpr size_t entryAlignment = 8; // each event is captured after 8 bytes reserved, and aligned by 8 bytes
+    size_t entrySize = entryAlignment + ((rawData.GetDataLength() + entryAlignment - 1) & ~(entryAlignment - 1));
+    CaptureBackend captureBackend(entrySize * eventCnt);
+    Transport::GetInstance().SetBackend(&captureBackend);
+    std::vector<std::string> sentNames;
+    for (size_t i = 0; i <= eventCnt; ++i) {
+        RawData data;
+        std::string name = "EVENT_" + std::to_string(i);
+        BuildRawEvent(data, name.c_str(), extraSize);
+        int ret = Transport::GetInstance().SendData(data);
+        // events over the capacity are dropped
+        ASSERT_EQ(ret, (i < eventCnt) ? SUCCESS : ERR_SEND_FAIL);
+        if (ret == SUCCESS) {
+            sentNames.emplace_back(name);
+        }
+    }
+    std::vector<std::string> capturedNames;
+    ASSERT_EQ(captureBackend.ForEach([&capturedNames, &rawData] (const uint8_t* data, size_t len) {
+        ASSERT_EQ(len, rawData.GetDataLength());
+        capturedNames.emplace_back(reinterpret_cast<const HiSysEventHeader*>(data + sizeof(int32_t))->name);
+    }), eventCnt);
+    ASSERT_EQ(capturedNames, sentNames);
+    auto stats = captureBackend.GetStats();
+    ASSERT_EQ(stats.capturedCnt, eventCnt);
+    ASSERT_EQ(stats.capturedBytes, eventCnt * rawData.GetDataLength());
+    ASSERT_EQ(stats.droppedCnt, 1);
+
+    std::string socketPath = "/data/test/hisysevent_backend_test.sock";
+    (void)unlink(socketPath.c_str());
+    int serverId = socket(AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+    ASSERT_GE(serverId, 0);
+    struct sockaddr_un serverAddr = { .sun_family = AF_UNIX };
+    (void)strcpy_s(serverAddr.sun_path, sizeof(serverAddr.sun_path), socketPath.c_str());
+    ASSERT_EQ(bind(serverId, reinterpret_cast<sockaddr*>(&serverAddr), sizeof(serverAddr)), 0);
+    UnixSocketBackend socketBackend(socketPath);
+    Transport::GetInstance().SetBackend(&socketBackend);
+    ASSERT_EQ(Transport::GetInstance().SendData(rawData), SUCCESS);
+    std::vector<uint8_t> buffer(rawData.GetDataLength() + 1);
+    ASSERT_EQ(recv(serverId, buffer.data(), buffer.size(), MSG_DONTWAIT), rawData.GetDataLength());
+    ASSERT_EQ(memcmp(buffer.data(), rawData.GetData(), rawData.GetDataLength()), 0);
+    Transport::GetInstance().SetBackend(nullptr);
+    close(serverId);
+    (void)unlink(socketPath.c_str());
+}
+
+/**
+ * @tc.name: EventRateLimiterTest001
+ * @tc.desc: Policies are found by domain and name, or by the wildcard name of the domain
+ * @tc.type: FUNC
+ * @tc.require: user-022
+ */
+HWTEST_F(HiSysEventEncodedTest, EventRateLimiterTest001, TestSize.Level1)
+{
+    RateLimitTable table;
+    ASSERT_FALSE(table.AddPolicy("", "DEMO_EVENT", 1, 1, 0));
+    ASSERT_FALSE(table.AddPolicy("DEMO", "DEMO_EVENT", -1, 1, 0));
+    ASSERT_FALSE(table.AddPolicy("DEMO", "DEMO_EVENT", 1, 0, 0)); // burst must be given if any event is allowed
+    ASSERT_TRUE(table.AddPolicy("DEMO", "DEMO_EVENT", 10, 5, 0));
+    ASSERT_TRUE(table.AddPolicy("DEMO", ANY_EVENT_NAME, 1, 1, 0));
+    ASSERT_TRUE(table.AddPolicy("DEMO", "DEMO_EVENT", 100, 5, 0)); // policy added again replaces the old one
+    ASSERT_EQ(table.GetPolicyCnt(), 2); // 2: policies added
+    auto policy = table.Find("DEMO", "DEMO_EVENT");
+    ASSERT_NE(policy, nullptr);
+    ASSERT_EQ(policy->name, "DEMO_EVENT");
+    ASSERT_EQ(policy->interval, 10000000); // 10000000: nanoseconds per event at the rate of 100
+    policy = table.Find("DEMO", "OTHER_EVENT");
+    ASSERT_NE(policy, nullptr);
+    ASSERT_EQ(policy->name, ANY_EVENT_NAME);
+    ASSERT_EQ(table.Find("OTHER", "DEMO_EVENT"), nullptr);
+
+    std::string configPath = "/data/test/hisysevent_rate_limit_test001.conf";
+    std::ofstream(configPath) << "# domain name rate burst [exempt_type ...]\n\nDEMO * 0.5 2 FAULT\nTEST T 0 0\n";
+    RateLimitTable loadedTable;
+    ASSERT_TRUE(loadedTable.LoadConfig(configPath));
+    ASSERT_EQ(loadedTable.GetPolicyCnt(), 2); // 2: policies in the config file
+    policy = loadedTable.Find("DEMO", "DEMO_EVENT");
+    ASSERT_NE(policy, nullptr);
+    ASSERT_EQ(policy->interval, 2000000000); // 2000000000: nanoseconds per event at the rate of 0.5
+    ASSERT_EQ(policy->exemptTypeMask, GetEventTypeMask(HiSysEvent::EventType::FAULT));
+    std::ofstream(configPath) << "DEMO * 1 1 UNKNOWN_TYPE\n";
+    ASSERT_FALSE(RateLimitTable().LoadConfig(configPath));
+    std::ofstream(configPath) << "DEMO * 1\n";
+    ASSERT_FALSE(RateLimitTable().LoadConfig(configPath));
+    (void)unlink(configPath.c_str());
+}
+
+/**
+ * @tc.name: EventRateLimiterTest002
+ * @tc.desc: Events are limited by the config reloaded except the exempt types, and tokens taken are kept on reloading
+ * @tc.type: FUNC
+ * @tc.require: user-022
+ */
+HWTEST_F(HiSysEventEncodedTest, EventRateLimiterTest002, TestSize.Level1)
+{
+    constexpr int burst = 3;
+    std::string configPath = "/data/test/hisysevent_rate_limit_test002.conf";
+    (void)unlink(configPath.c_str());
+    EventRateLimiter limiter(configPath);
+    ASSERT_FALSE(limiter.Reload());
+    ASSERT_TRUE(limiter.IsAllowed("DEMO", "DEMO_EVENT", HiSysEvent::EventType::BEHAVIOR));
+
+    std::ofstream(configPath) << "DEMO * 1 3 FAULT\nDEMO FAST_EVENT 20 1\nDEMO NO_EVENT 0 0\n";
+    ASSERT_TRUE(limiter.Reload());
+    ASSERT_FALSE(limiter.Reload()); // config is loaded only if it's changed
+    ASSERT_EQ(limiter.GetPolicyCnt(), 3); // 3: policies in the config file
+    for (int i = 0; i < burst; ++i) {
+        ASSERT_TRUE(limiter.IsAllowed("DEMO", "DEMO_EVENT", HiSysEvent::EventType::BEHAVIOR));
+    }
+    ASSERT_FALSE(limiter.IsAllowed("DEMO", "DEMO_EVENT", HiSysEvent::EventType::BEHAVIOR));
+    ASSERT_FALSE(limiter.IsAllowed("DEMO", "OTHER_EVENT", HiSysEvent::EventType::STATISTIC));
+    ASSERT_TRUE(limiter.IsAllowed("DEMO", "DEMO_EVENT", HiSysEvent::EventType::FAULT));
+    ASSERT_TRUE(limiter.IsAllowed("OTHER", "DEMO_EVENT", HiSysEvent::EventType::BEHAVIOR));
+    ASSERT_FALSE(limiter.IsAllowed("DEMO", "NO_EVENT", HiSysEvent::EventType::BEHAVIOR));
+
+    // token of the fast event is refilled in 50ms
+    ASSERT_TRUE(limiter.IsAllowed("DEMO", "FAST_EVENT", HiSysEvent::EventType::BEHAVIOR));
+    ASSERT_FALSE(limiter.IsAllowed("DEMO", "FAST_EVENT", HiSysEvent::EventType::BEHAVIOR));
+    std::this_thread::sleep_for(std::chrono::milliseconds(60)); // 60: longer than the interval of the fast event
+    ASSERT_TRUE(limiter.IsAllowed("DEMO", "FAST_EVENT", HiSysEvent::EventType::BEHAVIOR));
+
+    // buckets of the policies unchanged are carried over, and those of the policies changed are full
+    std::ofstream(configPath) << "DEMO * 1 3 FAULT\nDEMO FAST_EVENT 10 1\n";
+    ASSERT_TRUE(limiter.Reload());
+    ASSERT_FALSE(limiter.IsAllowed("DEMO", "DEMO_EVENT", HiSysEvent::EventType::BEHAVIOR));
+    ASSERT_TRUE(limiter.IsAllowed("DEMO", "FAST_EVENT", HiSysEvent::EventType::BEHAVIOR));
+
+    // policies are kept if the config changed is invalid, and dropped once the config is removed
+    std::ofstream(configPath) << "DEMO *\n";
+    ASSERT_FALSE(limiter.Reload());
+    ASSERT_EQ(limiter.GetPolicyCnt(), 2); // 2: policies loaded before
+    std::ofstream(configPath) << "OTHER * 1 1\n";
+    ASSERT_TRUE(limiter.Reload());
+    ASSERT_EQ(limiter.GetPolicyCnt(), 1);
+    ASSERT_TRUE(limiter.IsAllowed("DEMO", "DEMO_EVENT", HiSysEvent::EventType::BEHAVIOR));
+    (void)unlink(configPath.c_str());
+    ASSERT_TRUE(limiter.Reload());
+    ASSERT_EQ(limiter.GetPolicyCnt(), 0);
+}
+
+/**
+ * @tc.name: EventControlTest001
+ * @tc.desc: Events disabled or sampled out by the control block published are dropped
+ * @tc.type: FUNC
+ * @tc.require: user-023
+ */
+HWTEST_F(HiSysEventEncodedTest, EventControlTest001, TestSize.Level1)
+{
+    std::string controlPath = "/data/test/hisysevent_control_test001";
+    (void)unlink(controlPath.c_str());
+    EventControl control(controlPath);
+    ASSERT_FALSE(control.IsDropped("DEMO", "DEMO_EVENT", HiSysEvent::EventType::BEHAVIOR)); // not published yet
+
+    EventControlPublisher publisher;
+    ASSERT_TRUE(publisher.Init(controlPath));
+    EventControlPublisher otherPublisher;
+    ASSERT_FALSE(otherPublisher.Init(controlPath)); // only one publisher is allowed at a time
+    ASSERT_TRUE(publisher.Disable("DEMO"));
+    ASSERT_TRUE(publisher.Disable("TEST", "TEST_EVENT"));
+    ASSERT_FALSE(publisher.Disable("TEST", std::string(MAX_EVENT_NAME_LENGTH + 1, 'A')));
+    EventControl mappedControl(controlPath);
+    ASSERT_TRUE(mappedControl.IsDropped("DEMO", "DEMO_EVENT", HiSysEvent::EventType::FAULT));
+    ASSERT_TRUE(mappedControl.IsDropped("TEST", "TEST_EVENT", HiSysEvent::EventType::FAULT));
+    ASSERT_FALSE(mappedControl.IsDropped("TEST", "OTHER_EVENT", HiSysEvent::EventType::FAULT));
+    ASSERT_FALSE(mappedControl.IsDropped("OTHER", "DEMO_EVENT", HiSysEvent::EventType::FAULT));
+
+    // the block is updated in place, so updates are seen by the control mapped before
+    ASSERT_TRUE(publisher.Enable("DEMO"));
+    ASSERT_FALSE(publisher.Enable("DEMO"));
+    ASSERT_FALSE(mappedControl.IsDropped("DEMO", "DEMO_EVENT", HiSysEvent::EventType::FAULT));
+    ASSERT_TRUE(mappedControl.IsDropped("TEST", "TEST_EVENT", HiSysEvent::EventType::FAULT));
+
+    constexpr uint32_t samplingLevel = 4; // 1 of 16 events is kept
+    constexpr int eventCnt = 1600;
+    ASSERT_FALSE(publisher.SetSamplingLevel(MAX_SAMPLING_LEVEL + 1));
+    ASSERT_TRUE(publisher.SetSamplingLevel(samplingLevel));
+    int keptCnt = 0;
+    for (int i = 0; i < eventCnt; ++i) {
+        ASSERT_FALSE(mappedControl.IsDropped("DEMO", "DEMO_EVENT", HiSysEvent::EventType::FAULT));
+        keptCnt += mappedControl.IsDropped("DEMO", "DEMO_EVENT", HiSysEvent::EventType::STATISTIC) ? 0 : 1;
+    }
+    ASSERT_GT(keptCnt, 0);
+    ASSERT_LT(keptCnt, eventCnt / 4); // 4: far more than the rate of sampling
+
+    publisher.Reset();
+    ASSERT_FALSE(mappedControl.IsDropped("TEST", "TEST_EVENT", HiSysEvent::EventType::STATISTIC));
+    (void)unlink(controlPath.c_str());
+}
+
+/**
+ * @tc.name: EventControlTest002
+ * @tc.desc: Events are kept at the lowest rate of their domain, name and the sampling level
+ * @tc.type: FUNC
+ * @tc.require: user-025
+ */
+HWTEST_F(HiSysEventEncodedTest, EventControlTest002, TestSize.Level1)
+{
+    std::string controlPath = "/data/test/hisysevent_control_test002";
+    (void)unlink(controlPath.c_str());
+    EventControlPublisher publisher;
+    ASSERT_TRUE(publisher.Init(controlPath));
+    ASSERT_FALSE(publisher.SetSamplingRate("DEMO", "DEMO_EVENT", 1.5)); // 1.5: rate over 1
+    ASSERT_FALSE(publisher.SetSamplingRate("DEMO", "DEMO_EVENT", -1));
+    ASSERT_FALSE(publisher.SetSamplingRate("DEMO", "DEMO_EVENT", std::numeric_limits<double>::quiet_NaN()));
+    constexpr double domainRate = 0.5;
+    constexpr double eventRate = 0.25;
+    ASSERT_TRUE(publisher.SetSamplingRate("DEMO", "", domainRate));
+    ASSERT_TRUE(publisher.SetSamplingRate("DEMO", "DEMO_EVENT", eventRate));
+    EventControl control(controlPath);
+    constexpr int eventCnt = 4000;
+    int keptCnt = 0;
+    for (int i = 0; i < eventCnt; ++i) {
+        double sampleRate = 0;
+        if (!control.IsDropped("DEMO", "DEMO_EVENT", HiSysEvent::EventType::FAULT, sampleRate)) {
+            ASSERT_EQ(sampleRate, eventRate);
+            ++keptCnt;
+        }
+        if (!control.IsDropped("DEMO", "OTHER_EVENT", HiSysEvent::EventType::FAULT, sampleRate)) {
+            ASSERT_EQ(sampleRate, domainRate);
+        }
+    }
+    ASSERT_GT(keptCnt, eventCnt * eventRate / 2); // 2: far from the rate of sampling
+    ASSERT_LT(keptCnt, eventCnt * eventRate * 2); // 2: far from the rate of sampling
+
+    // events of the same uid are all kept or all dropped
+    ASSERT_TRUE(publisher.SetSamplingRate("TEST", "UID_EVENT", domainRate, SAMPLING_BY_UID));
+    double sampleRate = 0;
+    bool isDropped = control.IsDropped("TEST", "UID_EVENT", HiSysEvent::EventType::BEHAVIOR, sampleRate);
+    for (int i = 0; i < eventCnt; ++i) {
+        ASSERT_EQ(control.IsDropped("TEST", "UID_EVENT", HiSysEvent::EventType::BEHAVIOR, sampleRate), isDropped);
+    }
+
+    // lower rate of the sampling level applies to STATISTIC and BEHAVIOR only
+    constexpr uint32_t samplingLevel = 3; // 1 of 8 events is kept
+    ASSERT_TRUE(publisher.SetSamplingLevel(samplingLevel));
+    for (int i = 0; i < eventCnt; ++i) {
+        if (!control.IsDropped("DEMO", "DEMO_EVENT", HiSysEvent::EventType::STATISTIC, sampleRate)) {
+            ASSERT_EQ(sampleRate, 1.0 / (1 << samplingLevel));
+        }
+        if (!control.IsDropped("DEMO", "DEMO_EVENT", HiSysEvent::EventType::FAULT, sampleRate)) {
+            ASSERT_EQ(sampleRate, eventRate);
+        }
+    }
+    ASSERT_FALSE(control.IsDropped("OTHER", "OTHER_EVENT", HiSysEvent::EventType::FAULT, sampleRate));
+    ASSERT_EQ(sampleRate, 1.0);
+
+    // events are disabled by rate 0, and enabled by rate 1
+    ASSERT_TRUE(publisher.SetSamplingLevel(0));
+    ASSERT_TRUE(publisher.SetSamplingRate("DEMO", "DEMO_EVENT", 0));
+    ASSERT_TRUE(control.IsDropped("DEMO", "DEMO_EVENT", HiSysEvent::EventType::FAULT));
+    ASSERT_TRUE(publisher.SetSamplingRate("DEMO", "DEMO_EVENT", 1));
+    ASSERT_TRUE(publisher.Enable("DEMO"));
+    ASSERT_FALSE(control.IsDropped("DEMO", "DEMO_EVENT", HiSysEvent::EventType::FAULT, sampleRate));
+    ASSERT_EQ(sampleRate, 1.0);
+    (void)unlink(controlPath.c_str());
+}
+
+/**
+ * @tc.name: EventControlTest003
+ * @tc.desc: Block published in a file writable by others is never mapped by the writers
+ * @tc.type: FUNC
+ * @tc.require: user-023
+ */
+HWTEST_F(HiSysEventEncodedTest, EventControlTest003, TestSize.Level1)
+{
+    if (getuid() != 0) {
+        return; // the block is trusted only if it's owned by root or hiview
+    }
+    std::string controlPath = "/data/test/hisysevent_control_test003";
+    (void)unlink(controlPath.c_str());
+    {
+        EventControlPublisher publisher;
+        ASSERT_TRUE(publisher.Init(controlPath));
+        ASSERT_TRUE(publisher.Disable("DEMO"));
+    }
+    ASSERT_EQ(chmod(controlPath.c_str(), 0666), 0); // 0666: writable by others
+    EventControl control(controlPath);
+    ASSERT_FALSE(control.IsDropped("DEMO", "DEMO_EVENT", HiSysEvent::EventType::FAULT));
+
+    EventControlPublisher publisher;
+    ASSERT_TRUE(publisher.Init(controlPath)); // the mode is restored by the publisher
+    EventControl trustedControl(controlPath);
+    ASSERT_TRUE(trustedControl.IsDropped("DEMO", "DEMO_EVENT", HiSysEvent::EventType::FAULT));
+    (void)unlink(controlPath.c_str());
+}
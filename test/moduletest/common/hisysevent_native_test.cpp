@@ -18,6 +18,7 @@
 #include <functional>
 #include <iosfwd>
 #include <string>
+#include <sys/wait.h>
 #include <thread>
 #include <unistd.h>
 #include <vector>
@@ -28,7 +29,10 @@
 #include "gtest/hwext/gtest-tag.h"
 #include "hilog/log.h"
 
+#include "async_writer.h"
+#include "base_info_cache.h"
 #include "def.h"
+#include "event_control.h"
 #include "event_socket_factory.h"
 #include "hisysevent.h"
 #include "hisysevent_base_manager.h"
@@ -36,9 +40,14 @@
 #include "hisysevent_record.h"
 #include "hisysevent_query_callback.h"
 #include "hisysevent_listener.h"
+#include "raw_data.h"
 #include "ret_code.h"
 #include "rule_type.h"
 #include "securec.h"
+#include "stringfilter.h"
+#include "transport.h"
+#include "transport_backend.h"
+#include "write_controller.h"
 
 #ifndef SYS_EVENT_PARAMS
 #define SYS_EVENT_PARAMS(A) "key"#A, 0 + (A), "keyA"#A, 1 + (A), "keyB"#A, 2 + (A), "keyC"#A, 3 + (A), \
@@ -57,6 +66,53 @@ using namespace OHOS::HiviewDFX;
 namespace {
 constexpr char TEST_DOMAIN[] = "DEMO";
 constexpr char TEST_DOMAIN2[] = "KERNEL_VENDOR";
+// escape the text char by char, which is the reference of StringFilter::EscapeToRaw
+std::string EscapeCharByChar(const std::string& text)
+{
+    const char* escapedChars[] = { "\\b", "\\t", "\\n", nullptr, "\\f", "\\r" }; // from '\b' to '\r'
+    std::string rawText;
+    for (auto c : text) {
+        auto uc = static_cast<unsigned char>(c);
+        if (c == '\\' || c == '\"') {
+            rawText.push_back('\\');
+            rawText.push_back(c);
+        } else if (uc >= '\b' && uc <= '\r' && escapedChars[uc - '\b'] != nullptr) {
+            rawText.append(escapedChars[uc - '\b']);
+        } else if (uc >= 0x20 && uc != 0x7F) { // control chars in [0x00, 0x1F] and DEL(0x7F) are ignored
+            rawText.push_back(c);
+        }
+    }
+    return rawText;
+}
+
+// the block is published by the child process only if it's not published by the daemon, 0 means the case is skipped
+int WriteLazyParamsOfDisabledEvent(int& producedCnt)
+{
+    const std::string controlPath = "/dev/shm/hisysevent_control";
+    EventControlPublisher publisher;
+    if (!publisher.Init(controlPath) || !publisher.Disable(TEST_DOMAIN)) {
+        return 0;
+    }
+    auto produceStack = [&producedCnt] {
+        ++producedCnt;
+        return std::string("#00 pc 0000000000001234 /system/lib64/libdemo.so");
+    };
+    // the block published is mapped by the prober of this process
+    constexpr int maxWaitCnt = 100;
+    int ret = SUCCESS;
+    for (int i = 0; i < maxWaitCnt && ret != ERR_DOMAIN_MASKED; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10)); // 10ms: wait for the prober
+        ret = HiSysEvent::Write(__FUNCTION__, __LINE__, TEST_DOMAIN, "DEMO_EVENTNAME", HiSysEvent::EventType::FAULT);
+    }
+    if (ret == ERR_DOMAIN_MASKED) {
+        ret = HiSysEvent::Write(__FUNCTION__, __LINE__, TEST_DOMAIN, "DEMO_EVENTNAME", HiSysEvent::EventType::FAULT,
+            "STACK", produceStack);
+    }
+    publisher.Reset();
+    (void)unlink(controlPath.c_str());
+    return ret;
+}
+
 int32_t WriteSysEventByMarcoInterface()
 {
     return HiSysEventWrite(TEST_DOMAIN, "DEMO_EVENTNAME", HiSysEvent::EventType::FAULT,
@@ -129,6 +185,42 @@ void BuildRawData(RawData& data, const std::string& domain, const std::string& n
     (void)data.Update(reinterpret_cast<uint8_t*>(&header), sizeof(struct Encoded::HiSysEventHeader),
         sizeof(int32_t));
 }
+
+size_t g_copiedCnt = 0;
+
+class CopyCountedString : public std::string {
+public:
+    using std::string::string;
+
+    CopyCountedString(const CopyCountedString& other) : std::string(other)
+    {
+        g_copiedCnt++;
+    }
+
+    CopyCountedString& operator=(const CopyCountedString& other)
+    {
+        std::string::operator=(other);
+        g_copiedCnt++;
+        return *this;
+    }
+};
+
+class CopyCountedStrVector : public std::vector<std::string> {
+public:
+    using std::vector<std::string>::vector;
+
+    CopyCountedStrVector(const CopyCountedStrVector& other) : std::vector<std::string>(other)
+    {
+        g_copiedCnt++;
+    }
+
+    CopyCountedStrVector& operator=(const CopyCountedStrVector& other)
+    {
+        std::vector<std::string>::operator=(other);
+        g_copiedCnt++;
+        return *this;
+    }
+};
 }
 
 static bool WrapSysEventWriteAssertion(int32_t ret, bool cond)
@@ -349,9 +441,10 @@ HWTEST_F(HiSysEventNativeTest, TestHiSysEventDomainSpecialChar002, TestSize.Leve
      * @tc.steps: step1.make sure write sys event.
      */
     static constexpr char domain[] = "_demo";
+    static_assert(!isValidDomain<domain>);
     std::string eventName = "DOMAIN_SPECIAL_CHAR";
     HILOG_INFO(LOG_CORE, "test hisysevent domain has special char");
-    int result = HiSysEventWrite(domain, eventName, HiSysEvent::EventType::FAULT);
+    int result = HiSysEvent::Write(__FUNCTION__, __LINE__, domain, eventName, HiSysEvent::EventType::FAULT);
     HILOG_INFO(LOG_CORE, "domain has special char, retCode=%{public}d", result);
     ASSERT_LT(result, 0);
 }
@@ -368,9 +461,10 @@ HWTEST_F(HiSysEventNativeTest, TestHiSysEventDomainEmpty003, TestSize.Level1)
      * @tc.steps: step1.make sure write sys event.
      */
     static constexpr char domain[] = "";
+    static_assert(!isValidDomain<domain>);
     std::string eventName = "DOMAIN_EMPTY";
     HILOG_INFO(LOG_CORE, "test hisysevent domain is empty");
-    int result = HiSysEventWrite(domain, eventName, HiSysEvent::EventType::FAULT);
+    int result = HiSysEvent::Write(__FUNCTION__, __LINE__, domain, eventName, HiSysEvent::EventType::FAULT);
     HILOG_INFO(LOG_CORE, "domain is empty, retCode=%{public}d", result);
     ASSERT_LT(result, 0);
 }
@@ -396,8 +490,9 @@ HWTEST_F(HiSysEventNativeTest, TestHiSysEventDomainTooLong004, TestSize.Level1)
 
     HILOG_INFO(LOG_CORE, "test hisysevent domain is too long");
     static constexpr char domain17[] = "AAAAAAAAAAAAAAAAL";
+    static_assert(!isValidDomain<domain17>);
     eventName = "DOMAIN_TOO_LONG_17";
-    result = HiSysEventWrite(domain17, eventName, HiSysEvent::EventType::FAULT);
+    result = HiSysEvent::Write(__FUNCTION__, __LINE__, domain17, eventName, HiSysEvent::EventType::FAULT);
     HILOG_INFO(LOG_CORE, "domain is too long, more than 16 retCode=%{public}d", result);
     ASSERT_LT(result, 0);
 }
@@ -1690,3 +1785,333 @@ HWTEST_F(HiSysEventNativeTest, TestEventSocketFactory5, TestSize.Level1)
     ASSERT_EQ(std::string(socketAddr.sun_path), "/dev/unix/socket/hisysevent");
 }
 
+
+/**
+ * @tc.name: TestWriteWithoutCopyingParams
+ * @tc.desc: Test params of the variadic write api won't be copied before they are encoded
+ * @tc.type: FUNC
+ * @tc.require: user-004
+ */
+HWTEST_F(HiSysEventNativeTest, TestWriteWithoutCopyingParams, TestSize.Level1)
+{
+    g_copiedCnt = 0;
+    CopyCountedString strVal("STR_VAL");
+    CopyCountedStrVector strArrayVal = { "STR_VAL1", "STR_VAL2", "STR_VAL3" };
+    int ret = HiSysEventWrite(TEST_DOMAIN, "DEMO_EVENTNAME", HiSysEvent::EventType::BEHAVIOR,
+        "PARAM_STR1", strVal, "PARAM_STR_ARRAY1", strArrayVal, "PARAM_INT", 1,
+        "PARAM_STR2", strVal, "PARAM_STR_ARRAY2", strArrayVal,
+        "PARAM_STR3", CopyCountedString("STR_VAL"), "PARAM_STR_ARRAY3", CopyCountedStrVector { "STR_VAL" });
+    ASSERT_TRUE(WrapSysEventWriteAssertion(ret, ret == SUCCESS));
+    ASSERT_EQ(g_copiedCnt, 0);
+}
+
+/**
+ * @tc.name: TestConstNameValidation
+ * @tc.desc: Test names validated in compile time are same with the ones validated in runtime
+ * @tc.type: FUNC
+ * @tc.require: user-005
+ */
+HWTEST_F(HiSysEventNativeTest, TestConstNameValidation, TestSize.Level1)
+{
+    static_assert(StringFilter::IsValidConstName("DEMO_EVENTNAME", MAX_EVENT_NAME_LENGTH));
+    static_assert(!StringFilter::IsValidConstName("_DEMO_EVENTNAME", MAX_EVENT_NAME_LENGTH));
+    static_assert(!StringFilter::IsValidConstName("", MAX_EVENT_NAME_LENGTH));
+    static_assert(isValidDomain<TEST_DOMAIN>);
+    std::vector<std::string> names = {
+        "DEMO", "demo_1", "D", "1DEMO", "_DEMO", "DEMO-1", "DEMO 1", "", "AAAAAAAAAAAAAAAA", "AAAAAAAAAAAAAAAAL",
+        "DEMO\x80",
+    };
+    for (auto& name : names) {
+        ASSERT_EQ(StringFilter::IsValidConstName(name, MAX_DOMAIN_LENGTH),
+            StringFilter::GetInstance().IsValidName(name, MAX_DOMAIN_LENGTH));
+    }
+    int ret = HiSysEventWrite(TEST_DOMAIN, "DEMO_EVENTNAME", HiSysEvent::EventType::BEHAVIOR,
+        "PARAM_KEY_WITH_LONG_NAME", "PARAM_VAL", "_INVALID_KEY", "PARAM_VAL");
+    ASSERT_TRUE(WrapSysEventWriteAssertion(ret, ret == ERR_KEY_NAME_INVALID));
+}
+
+/**
+ * @tc.name: TestWritePreparedEvent
+ * @tc.desc: Test writing events whose domain, name, type and keys are prepared once
+ * @tc.type: FUNC
+ * @tc.require: user-006
+ */
+HWTEST_F(HiSysEventNativeTest, TestWritePreparedEvent, TestSize.Level1)
+{
+    static HiSysEvent::PreparedEvent<int32_t, std::string, std::vector<int>, const char*> event(TEST_DOMAIN,
+        "DEMO_EVENTNAME", HiSysEvent::EventType::BEHAVIOR, {"PARAM_INT", "PARAM_STR", "PARAM_INT_ARR", "PARAM_CSTR"});
+    ASSERT_EQ(event.GetRetCode(), SUCCESS);
+    ASSERT_EQ(event.GetKeyCnt(), 4); // 4 keys prepared
+    for (int i = 0; i < 3; ++i) { // write 3 times
+        int ret = event.Write(__FUNCTION__, __LINE__, i, "param_val", {i, i + 1}, "param_cstr_val");
+        ASSERT_TRUE(WrapSysEventWriteAssertion(ret, ret == SUCCESS));
+    }
+    int ret = event.Write(__FUNCTION__, __LINE__, 0, "param_val", std::vector<int>(MAX_ARRAY_SIZE + 1, 0), "");
+    ASSERT_TRUE(WrapSysEventWriteAssertion(ret, ret == ERR_ARRAY_TOO_MUCH));
+
+    HiSysEvent::PreparedEvent<int32_t, int32_t> eventWithInvalidKey(TEST_DOMAIN, "DEMO_EVENTNAME",
+        HiSysEvent::EventType::BEHAVIOR, {"_INVALID_KEY", "PARAM_INT"});
+    ASSERT_EQ(eventWithInvalidKey.GetRetCode(), ERR_KEY_NAME_INVALID);
+    ret = eventWithInvalidKey.Write(__FUNCTION__, __LINE__, 0, 1);
+    ASSERT_TRUE(WrapSysEventWriteAssertion(ret, ret == ERR_KEY_NAME_INVALID));
+
+    HiSysEvent::PreparedEvent<int32_t> eventWithInvalidDomain("_INVALID_DOMAIN", "DEMO_EVENTNAME",
+        HiSysEvent::EventType::BEHAVIOR, {"PARAM_INT"});
+    ASSERT_EQ(eventWithInvalidDomain.Write(__FUNCTION__, __LINE__, 0), ERR_DOMAIN_NAME_INVALID);
+    HiSysEvent::PreparedEvent<int32_t> eventWithInvalidName(TEST_DOMAIN, "_INVALID_EVENTNAME",
+        HiSysEvent::EventType::BEHAVIOR, {"PARAM_INT"});
+    ASSERT_EQ(eventWithInvalidName.Write(__FUNCTION__, __LINE__, 0), ERR_EVENT_NAME_INVALID);
+}
+
+/**
+ * @tc.name: TestBaseInfoCacheAfterFork
+ * @tc.desc: Test cached pid and tid are updated in the forked process
+ * @tc.type: FUNC
+ * @tc.require: user-007
+ */
+HWTEST_F(HiSysEventNativeTest, TestBaseInfoCacheAfterFork, TestSize.Level1)
+{
+    ASSERT_EQ(BaseInfoCache::GetPid(), static_cast<uint32_t>(getprocpid()));
+    ASSERT_EQ(BaseInfoCache::GetTid(), static_cast<uint32_t>(getproctid()));
+    ASSERT_EQ(BaseInfoCache::GetUid(), static_cast<uint32_t>(getuid()));
+    pid_t pid = fork();
+    ASSERT_GE(pid, 0);
+    if (pid == 0) {
+        bool isSame = (BaseInfoCache::GetPid() == static_cast<uint32_t>(getprocpid())) &&
+            (BaseInfoCache::GetTid() == static_cast<uint32_t>(getproctid()));
+        _exit(isSame ? 0 : 1);
+    }
+    int status = 0;
+    ASSERT_EQ(waitpid(pid, &status, 0), pid);
+    ASSERT_TRUE(WIFEXITED(status));
+    ASSERT_EQ(WEXITSTATUS(status), 0);
+}
+
+/**
+ * @tc.name: TestEscapeToRaw
+ * @tc.desc: Test escaping of texts whose special chars are at different positions of the blocks scanned
+ * @tc.type: FUNC
+ * @tc.require: user-010
+ */
+HWTEST_F(HiSysEventNativeTest, TestEscapeToRaw, TestSize.Level1)
+{
+    auto& filter = StringFilter::GetInstance();
+    constexpr size_t textLen = 40; // longer than 2 blocks of 16 chars
+    for (int c = 0; c <= UINT8_MAX; ++c) {
+        for (size_t pos = 0; pos < textLen; ++pos) {
+            std::string text(textLen, 'a');
+            text[pos] = static_cast<char>(c);
+            std::string expectedText = EscapeCharByChar(text);
+            ASSERT_EQ(filter.EscapeToRaw(text), expectedText);
+            ASSERT_EQ(filter.GetEscapedLength(text), expectedText.length());
+            ASSERT_EQ(filter.IsEscapeNeeded(text), expectedText != text);
+            Encoded::RawData rawData;
+            ASSERT_TRUE(filter.EscapeToRaw(text, rawData));
+            ASSERT_EQ(std::string(reinterpret_cast<char*>(rawData.GetData()), rawData.GetDataLength()),
+                expectedText);
+        }
+    }
+    std::string text = "frame #00 \"pc\"\t0000000000012345\n/system/lib64/libc.so\x01\x7F\\";
+    ASSERT_EQ(filter.EscapeToRaw(text), "frame #00 \\\"pc\\\"\\t0000000000012345\\n/system/lib64/libc.so\\\\");
+}
+
+/**
+ * @tc.name: TestWriteBatch
+ * @tc.desc: Test writing events in batch, whose results are the same as the ones of writing each event alone
+ * @tc.type: FUNC
+ * @tc.require: user-014
+ */
+HWTEST_F(HiSysEventNativeTest, TestWriteBatch, TestSize.Level1)
+{
+    HiSysEvent::Batch batch;
+    constexpr int addedCnt = HISYSEVENT_THRESHOLD + 2; // 2 events over the threshold
+    for (int i = 0; i < addedCnt; ++i) {
+        int ret = batch.Add(__FUNCTION__, __LINE__, TEST_DOMAIN, "DEMO_EVENTNAME", HiSysEvent::EventType::STATISTIC,
+            "PARAM_INT", i, "PARAM_STR", "param_val");
+        ASSERT_EQ(ret, (i < HISYSEVENT_THRESHOLD) ? SUCCESS : ERR_WRITE_IN_HIGH_FREQ);
+    }
+    ASSERT_EQ(batch.Add(__FUNCTION__, __LINE__, TEST_DOMAIN, "_INVALID_EVENTNAME", HiSysEvent::EventType::FAULT),
+        ERR_EVENT_NAME_INVALID);
+    ASSERT_EQ(batch.Add(__FUNCTION__, __LINE__, TEST_DOMAIN, "DEMO_EVENTNAME", HiSysEvent::EventType::FAULT,
+        "PARAM_INT_ARR", std::vector<int>(MAX_ARRAY_SIZE + 1, 0)), ERR_ARRAY_TOO_MUCH);
+    ASSERT_EQ(batch.GetSize(), addedCnt + 2); // 2 events with invalid name and array
+    auto retCodes = batch.Write();
+    ASSERT_EQ(batch.GetSize(), 0);
+    ASSERT_EQ(retCodes.size(), addedCnt + 2); // 2 events with invalid name and array
+    for (int i = 0; i < addedCnt; ++i) {
+        if (i < HISYSEVENT_THRESHOLD) {
+            ASSERT_TRUE(WrapSysEventWriteAssertion(retCodes[i], retCodes[i] == SUCCESS));
+        } else {
+            ASSERT_EQ(retCodes[i], ERR_WRITE_IN_HIGH_FREQ);
+        }
+    }
+    ASSERT_EQ(retCodes[addedCnt], ERR_EVENT_NAME_INVALID);
+    ASSERT_TRUE(WrapSysEventWriteAssertion(retCodes[addedCnt + 1], retCodes[addedCnt + 1] == ERR_ARRAY_TOO_MUCH));
+
+    // buffers of the batch are reused by the events added after writing
+    ASSERT_EQ(batch.Add(__FUNCTION__, __LINE__, TEST_DOMAIN, "DEMO_EVENTNAME", HiSysEvent::EventType::BEHAVIOR,
+        "PARAM_STR", "param_val"), SUCCESS);
+    retCodes = batch.Write();
+    ASSERT_EQ(retCodes.size(), 1);
+    ASSERT_TRUE(WrapSysEventWriteAssertion(retCodes[0], retCodes[0] == SUCCESS));
+    ASSERT_TRUE(batch.Write().empty());
+}
+
+/**
+ * @tc.name: TestWriteInAsyncMode
+ * @tc.desc: Test writing events in async mode, in which events queued are sent by the background thread
+ * @tc.type: FUNC
+ * @tc.require: user-015
+ */
+HWTEST_F(HiSysEventNativeTest, TestWriteInAsyncMode, TestSize.Level1)
+{
+    HiSysEvent::EnableAsyncMode();
+    auto statsBefore = AsyncWriter::GetInstance().GetStats();
+    int queuedCnt = 0;
+    int ret = HiSysEventWrite(TEST_DOMAIN, "DEMO_EVENTNAME", HiSysEvent::EventType::STATISTIC,
+        "PARAM_STR", "param_val");
+    ASSERT_TRUE(WrapSysEventWriteAssertion(ret, ret == SUCCESS));
+    queuedCnt += (ret == SUCCESS) ? 1 : 0;
+    // fault event and event sent to the server of higher priority are queued in the priority lane
+    ret = HiSysEventWrite(TEST_DOMAIN, "DEMO_EVENTNAME", HiSysEvent::EventType::FAULT, "PARAM_STR", "param_val");
+    ASSERT_TRUE(WrapSysEventWriteAssertion(ret, ret == SUCCESS));
+    queuedCnt += (ret == SUCCESS) ? 1 : 0;
+    ret = HiSysEventWrite(HiSysEvent::Domain::AAFWK, "APP_INPUT_BLOCK", HiSysEvent::EventType::FAULT,
+        "PARAM_STR", "param_val");
+    ASSERT_TRUE(WrapSysEventWriteAssertion(ret, ret == SUCCESS));
+    queuedCnt += (ret == SUCCESS) ? 1 : 0;
+    // invalid event fails before queued
+    std::string invalidEventName = "_INVALID_EVENTNAME";
+    ret = HiSysEventWrite(TEST_DOMAIN, invalidEventName, HiSysEvent::EventType::FAULT);
+    ASSERT_EQ(ret, ERR_EVENT_NAME_INVALID);
+
+    HiSysEvent::FlushAsyncEvents();
+    auto stats = AsyncWriter::GetInstance().GetStats();
+    ASSERT_EQ(stats.queuedCnt - statsBefore.queuedCnt, queuedCnt);
+    ASSERT_EQ((stats.sentCnt - statsBefore.sentCnt) + (stats.failedCnt - statsBefore.failedCnt), queuedCnt);
+
+    // events are sent by the caller after async mode is disabled
+    HiSysEvent::DisableAsyncMode();
+    ret = HiSysEventWrite(TEST_DOMAIN, "DEMO_EVENTNAME", HiSysEvent::EventType::BEHAVIOR, "PARAM_STR", "param_val");
+    ASSERT_TRUE(WrapSysEventWriteAssertion(ret, ret == SUCCESS));
+    ASSERT_EQ(AsyncWriter::GetInstance().GetStats().queuedCnt, stats.queuedCnt);
+}
+
+/**
+ * @tc.name: TestWriteToCaptureBackend
+ * @tc.desc: Test writing events captured in memory by the transport backend, which needs no daemon
+ * @tc.type: FUNC
+ * @tc.require: user-020
+ */
+HWTEST_F(HiSysEventNativeTest, TestWriteToCaptureBackend, TestSize.Level1)
+{
+    constexpr size_t captureCapacity = 4096;
+    CaptureBackend backend(captureCapacity);
+    Transport::GetInstance().SetBackend(&backend);
+    int ret = HiSysEventWrite(TEST_DOMAIN, "DEMO_EVENTNAME", HiSysEvent::EventType::STATISTIC,
+        "PARAM_STR", "param_val");
+    ASSERT_EQ(ret, SUCCESS);
+    ret = HiSysEventWrite(HiSysEvent::Domain::AAFWK, "APP_INPUT_BLOCK", HiSysEvent::EventType::FAULT,
+        "PARAM_INT", 1);
+    ASSERT_EQ(ret, SUCCESS);
+    Transport::GetInstance().SetBackend(nullptr);
+    std::vector<std::string> capturedNames;
+    backend.ForEach([&capturedNames] (const uint8_t* data, size_t len) {
+        ASSERT_GT(len, sizeof(int32_t) + sizeof(Encoded::HiSysEventHeader));
+        auto header = reinterpret_cast<const Encoded::HiSysEventHeader*>(data + sizeof(int32_t));
+        capturedNames.emplace_back(std::string(header->domain) + "." + header->name);
+    });
+    ASSERT_EQ(capturedNames, std::vector<std::string>({ std::string(TEST_DOMAIN) + ".DEMO_EVENTNAME",
+        "AAFWK.APP_INPUT_BLOCK" }));
+    ASSERT_EQ(backend.GetStats().capturedCnt, capturedNames.size());
+}
+
+/**
+ * @tc.name: TestLimitWritingEventOfCallSites
+ * @tc.desc: Test events limited by each call site, no matter how many call sites are wrote alternately
+ * @tc.type: FUNC
+ * @tc.require: user-021
+ */
+HWTEST_F(HiSysEventNativeTest, TestLimitWritingEventOfCallSites, TestSize.Level1)
+{
+    constexpr size_t callSiteCnt = 200; // more than the call sites kept by the write controller before
+    constexpr ControlParam param = { .period = 5, .threshold = 3 };
+    for (size_t round = 0; round <= param.threshold; ++round) {
+        for (size_t line = 0; line < callSiteCnt; ++line) {
+            auto timeStamp = WriteController::CheckLimitWritingEvent(param, TEST_DOMAIN, "DEMO_EVENTNAME",
+                __FUNCTION__, static_cast<int64_t>(line));
+            ASSERT_EQ(timeStamp == INVALID_TIME_STAMP, round == param.threshold);
+        }
+    }
+
+    // call site with constant event name is limited by its own slot
+    WriteControlSlot slot;
+    for (size_t i = 0; i <= param.threshold; ++i) {
+        auto timeStamp = WriteController::CheckLimitWritingEvent(param, slot, TEST_DOMAIN, "DEMO_EVENTNAME",
+            __FUNCTION__);
+        ASSERT_EQ(timeStamp == INVALID_TIME_STAMP, i == param.threshold);
+    }
+    WriteControlSlot otherSlot;
+    ASSERT_NE(WriteController::CheckLimitWritingEvent(param, otherSlot, TEST_DOMAIN, "DEMO_EVENTNAME", __FUNCTION__),
+        INVALID_TIME_STAMP);
+}
+
+/**
+ * @tc.name: TestWriteLazyParams
+ * @tc.desc: Test values given as callables are produced only for events passing the checks
+ * @tc.type: FUNC
+ * @tc.require: user-024
+ */
+HWTEST_F(HiSysEventNativeTest, TestWriteLazyParams, TestSize.Level1)
+{
+    int producedCnt = 0;
+    auto produceStack = [&producedCnt] {
+        ++producedCnt;
+        return std::string("#00 pc 0000000000001234 /system/lib64/libdemo.so");
+    };
+    auto produceCnt = [] { return 3; };
+    int ret = HiSysEventWrite(TEST_DOMAIN, "DEMO_EVENTNAME", HiSysEvent::EventType::FAULT, "STACK", produceStack,
+        "CNT", produceCnt, "KEY_STR", "abc");
+    ASSERT_TRUE(WrapSysEventWriteAssertion(ret, ret == SUCCESS));
+    ASSERT_EQ(producedCnt, 1);
+
+    // values are never produced for the events failed to be checked
+    ret = HiSysEvent::Write(__FUNCTION__, __LINE__, TEST_DOMAIN, "", HiSysEvent::EventType::FAULT, "STACK",
+        produceStack);
+    ASSERT_EQ(ret, ERR_EVENT_NAME_INVALID);
+    ret = HiSysEvent::Write(__FUNCTION__, __LINE__, "", "DEMO_EVENTNAME", HiSysEvent::EventType::FAULT, "STACK",
+        produceStack);
+    ASSERT_EQ(ret, ERR_DOMAIN_NAME_INVALID);
+    ASSERT_EQ(producedCnt, 1);
+
+    // values are never produced for the params of invalid keys, or over the count of params
+    ret = HiSysEventWrite(TEST_DOMAIN, "DEMO_EVENTNAME", HiSysEvent::EventType::FAULT, "_INVALID_KEY", produceStack);
+    ASSERT_TRUE(WrapSysEventWriteAssertion(ret, ret == ERR_KEY_NAME_INVALID));
+    ret = HiSysEventWrite(TEST_DOMAIN, "DEMO_EVENTNAME", HiSysEvent::EventType::FAULT, SYS_EVENT_PARAMS(10),
+        SYS_EVENT_PARAMS(20), SYS_EVENT_PARAMS(30), SYS_EVENT_PARAMS(40), SYS_EVENT_PARAMS(50), SYS_EVENT_PARAMS(60),
+        SYS_EVENT_PARAMS(70), SYS_EVENT_PARAMS(80), SYS_EVENT_PARAMS(90), SYS_EVENT_PARAMS(100),
+        SYS_EVENT_PARAMS(110), SYS_EVENT_PARAMS(120), SYS_EVENT_PARAMS(130), "STACK", produceStack);
+    ASSERT_TRUE(WrapSysEventWriteAssertion(ret, ret == ERR_KEY_NUMBER_TOO_MUCH));
+    ASSERT_EQ(producedCnt, 1);
+
+    // values are never produced for the events over the threshold of the call site
+    for (int i = 0; i <= HISYSEVENT_THRESHOLD; ++i) {
+        ret = HiSysEvent::Write(__FUNCTION__, __LINE__, TEST_DOMAIN, "DEMO_EVENTNAME", HiSysEvent::EventType::FAULT,
+            "STACK", produceStack);
+    }
+    ASSERT_EQ(ret, ERR_WRITE_IN_HIGH_FREQ);
+    ASSERT_EQ(producedCnt, 1 + HISYSEVENT_THRESHOLD);
+
+    // values are never produced for the events disabled by the control block
+    pid_t pid = fork();
+    ASSERT_GE(pid, 0);
+    if (pid == 0) {
+        int disabledProducedCnt = 0;
+        int disabledRet = WriteLazyParamsOfDisabledEvent(disabledProducedCnt);
+        _exit((disabledRet == 0 || (disabledRet == ERR_DOMAIN_MASKED && disabledProducedCnt == 0)) ? 0 : 1);
+    }
+    int status = 0;
+    ASSERT_EQ(waitpid(pid, &status, 0), pid);
+    ASSERT_TRUE(WIFEXITED(status));
+    ASSERT_EQ(WEXITSTATUS(status), 0);
+}
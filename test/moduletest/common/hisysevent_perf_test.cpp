@@ -0,0 +1,1067 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "hisysevent_perf_test.h"
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <new>
+#include <string>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <thread>
+#include <time.h>
+#include <unordered_map>
+#include <unistd.h>
+#include <vector>
+
+#include "gtest/gtest-message.h"
+#include "gtest/gtest-test-part.h"
+#include "gtest/hwext/gtest-ext.h"
+#include "gtest/hwext/gtest-tag.h"
+
+#include "base_info_cache.h"
+#include "event_control.h"
+#include "event_rate_limiter.h"
+#include "event_socket_factory.h"
+#include "hisysevent.h"
+#include "hisysevent_c.h"
+#include "io_uring_sender.h"
+#include "raw_data.h"
+#include "raw_data_base_def.h"
+#include "raw_data_encoder.h"
+#include "securec.h"
+#include "shared_memory_ring.h"
+#include "stringfilter.h"
+#include "transport.h"
+#include "transport_backend.h"
+#include "write_controller.h"
+
+using namespace testing::ext;
+using namespace OHOS::HiviewDFX;
+
+namespace {
+std::atomic<size_t> g_allocCnt { 0 };
+std::atomic<size_t> g_allocBytes { 0 };
+thread_local bool g_isAllocCounted = false;
+
+constexpr int WROTE_TOTAL_CNT = 1000;
+constexpr int BASE_INFO_WROTE_TOTAL_CNT = 100000;
+constexpr int ARRAY_ENCODED_TOTAL_CNT = 10000;
+constexpr size_t INT64_ARRAY_SIZE = 100;
+constexpr int TEXT_ESCAPED_TOTAL_CNT = 100;
+constexpr size_t STACK_TRACE_SIZE = 64 * 1024;
+constexpr int EVENT_SENT_TOTAL_CNT = 10000;
+constexpr int SENDER_THREAD_CNT = 4;
+constexpr int MAX_SENDER_THREAD_CNT = 16;
+constexpr int PARAM_CNT = 20;
+constexpr int LIMIT_CHECKED_TOTAL_CNT = 100000;
+constexpr ControlParam UNLIMITED_PARAM = { HISYSEVENT_DEFAULT_PERIOD, static_cast<size_t>(-1) };
+constexpr int SIZED_WROTE_TOTAL_CNT = 10; // less than the default threshold of c api in total
+constexpr size_t STR_PARAM_CNT = 20;
+constexpr size_t EVENT_SIZE_RESERVED = 512;
+constexpr size_t KB = 1024;
+
+class AllocCounter {
+public:
+    AllocCounter()
+    {
+        g_allocCnt = 0;
+        g_allocBytes = 0;
+        g_isAllocCounted = true;
+    }
+
+    ~AllocCounter()
+    {
+        g_isAllocCounted = false;
+    }
+
+    size_t GetCount() const
+    {
+        return g_allocCnt.load();
+    }
+
+    size_t GetBytes() const
+    {
+        return g_allocBytes.load();
+    }
+};
+
+class CostTimer {
+public:
+    CostTimer(): begin_(std::chrono::steady_clock::now()) {}
+
+    double GetCostInNanoSec(int cnt) const
+    {
+        auto cost = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin_);
+        return static_cast<double>(cost.count()) / cnt;
+    }
+
+private:
+    std::chrono::steady_clock::time_point begin_;
+};
+
+class CpuCostTimer {
+public:
+    CpuCostTimer(): begin_(GetThreadCpuTimeInNanoSec()) {}
+
+    double GetCostInNanoSec(int cnt) const
+    {
+        return static_cast<double>(GetThreadCpuTimeInNanoSec() - begin_) / cnt;
+    }
+
+private:
+    static int64_t GetThreadCpuTimeInNanoSec()
+    {
+        constexpr int64_t nanoSecPerSec = 1000000000;
+        struct timespec ts = { 0, 0 };
+        (void)clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+        return static_cast<int64_t>(ts.tv_sec) * nanoSecPerSec + ts.tv_nsec;
+    }
+
+private:
+    int64_t begin_;
+};
+
+int WriteEventWithTwentyParams(int index)
+{
+    return HiSysEventWrite(HiSysEvent::Domain::AAFWK, "PERF_TEST", HiSysEvent::EventType::BEHAVIOR,
+        "PARAM_INT8", static_cast<char>(index), "PARAM_UINT8", static_cast<unsigned char>(index),
+        "PARAM_INT16", static_cast<short>(index), "PARAM_UINT16", static_cast<unsigned short>(index),
+        "PARAM_INT32", index, "PARAM_UINT32", static_cast<unsigned int>(index),
+        "PARAM_INT64", static_cast<long long>(index), "PARAM_UINT64", static_cast<unsigned long long>(index),
+        "PARAM_FLOAT", 1.5f, "PARAM_DOUBLE", 2.5, "PARAM_BOOL", true,
+        "PARAM_STR", "stack frame #00 pc 0000000000012345 /system/lib64/libc.so",
+        "PARAM_INT_1", index + 1, "PARAM_INT_2", index + 2, "PARAM_INT_3", index + 3,
+        "PARAM_INT_4", index + 4, "PARAM_INT_5", index + 5, "PARAM_INT_6", index + 6,
+        "PARAM_INT_7", index + 7, "PARAM_INT_8", index + 8);
+}
+
+int WritePreparedEventWithTwentyParams(int index)
+{
+    static HiSysEvent::PreparedEvent<char, unsigned char, short, unsigned short, int, unsigned int, long long,
+        unsigned long long, float, double, bool, const char*, int, int, int, int, int, int, int, int> event(
+        HiSysEvent::Domain::AAFWK, "PERF_TEST", HiSysEvent::EventType::BEHAVIOR, {
+        "PARAM_INT8", "PARAM_UINT8", "PARAM_INT16", "PARAM_UINT16", "PARAM_INT32", "PARAM_UINT32", "PARAM_INT64",
+        "PARAM_UINT64", "PARAM_FLOAT", "PARAM_DOUBLE", "PARAM_BOOL", "PARAM_STR", "PARAM_INT_1", "PARAM_INT_2",
+        "PARAM_INT_3", "PARAM_INT_4", "PARAM_INT_5", "PARAM_INT_6", "PARAM_INT_7", "PARAM_INT_8"
+    });
+    return event.Write(__FUNCTION__, __LINE__, static_cast<char>(index), static_cast<unsigned char>(index),
+        static_cast<short>(index), static_cast<unsigned short>(index), index, static_cast<unsigned int>(index),
+        static_cast<long long>(index), static_cast<unsigned long long>(index), 1.5f, 2.5, true,
+        "stack frame #00 pc 0000000000012345 /system/lib64/libc.so", index + 1, index + 2, index + 3, index + 4,
+        index + 5, index + 6, index + 7, index + 8);
+}
+
+double GetCpuCostOfWriting(int (*writeFunc)(int), size_t& allocCnt)
+{
+    (void)writeFunc(0); // warm up
+    CpuCostTimer timer;
+    AllocCounter counter;
+    for (int i = 0; i < WROTE_TOTAL_CNT; ++i) {
+        (void)writeFunc(i);
+    }
+    allocCnt = counter.GetCount();
+    return timer.GetCostInNanoSec(WROTE_TOTAL_CNT);
+}
+
+uint64_t WriteBaseInfoWithoutCache()
+{
+    return static_cast<uint64_t>(Encoded::ParseTimeZone(timezone)) + static_cast<uint64_t>(getprocpid()) +
+        static_cast<uint64_t>(getproctid()) + static_cast<uint64_t>(getuid());
+}
+
+uint64_t WriteBaseInfoWithCache()
+{
+    return static_cast<uint64_t>(BaseInfoCache::GetTimeZone()) + BaseInfoCache::GetPid() +
+        BaseInfoCache::GetTid() + BaseInfoCache::GetUid();
+}
+
+double GetCpuCostOfWritingBaseInfo(uint64_t (*writeFunc)(), uint64_t& baseInfo)
+{
+    baseInfo = writeFunc(); // warm up
+    CpuCostTimer timer;
+    for (int i = 0; i < BASE_INFO_WROTE_TOTAL_CNT; ++i) {
+        baseInfo = writeFunc();
+    }
+    return timer.GetCostInNanoSec(BASE_INFO_WROTE_TOTAL_CNT);
+}
+
+bool EncodeInt64ArrayItemByItem(Encoded::RawData& data, const std::vector<int64_t>& vals)
+{
+    for (auto val : vals) {
+        if (!Encoded::RawDataEncoder::SignedVarintEncoded(data, Encoded::EncodeType::VARINT, val)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool EncodeInt64ArrayInBatch(Encoded::RawData& data, const std::vector<int64_t>& vals)
+{
+    return Encoded::RawDataEncoder::SignedVarintArrayEncoded<int64_t>(data, vals.begin(), vals.size());
+}
+
+double GetCpuCostOfEncodingInt64Array(bool (*encodeFunc)(Encoded::RawData&, const std::vector<int64_t>&),
+    Encoded::RawData& data)
+{
+    std::vector<int64_t> vals(INT64_ARRAY_SIZE);
+    for (size_t i = 0; i < INT64_ARRAY_SIZE; ++i) {
+        vals[i] = (i % 2 == 0) ? static_cast<int64_t>(i * i * i) : -static_cast<int64_t>(i); // values in frame stats
+    }
+    CpuCostTimer timer;
+    for (int i = 0; i < ARRAY_ENCODED_TOTAL_CNT; ++i) {
+        data.Reset();
+        (void)encodeFunc(data, vals);
+    }
+    return timer.GetCostInNanoSec(ARRAY_ENCODED_TOTAL_CNT);
+}
+
+std::string BuildStackTrace(const std::string& frameSeparator)
+{
+    std::string stackTrace;
+    for (int frameIndex = 0; stackTrace.length() < STACK_TRACE_SIZE; ++frameIndex) {
+        stackTrace += "#" + std::to_string(frameIndex) + " pc 000000000001a2b4 /system/lib64/libace.z.so"
+            "(OHOS::Ace::PipelineContext::FlushVsync(unsigned long, unsigned int)+372)" + frameSeparator;
+    }
+    return stackTrace;
+}
+
+// escape the text char by char with a table lookup for each char
+std::string EscapeCharByChar(const std::string& text)
+{
+    std::string rawText;
+    for (auto c : text) {
+        if (c == '\\' || c == '\"') {
+            rawText.push_back('\\');
+            rawText.push_back(c);
+        } else if (c == '\n') {
+            rawText.append("\\n");
+        } else if (static_cast<unsigned char>(c) >= 0x20 && c != 0x7F) { // control chars are ignored
+            rawText.push_back(c);
+        }
+    }
+    return rawText;
+}
+
+// throughput in GB/s of escaping the text
+double GetThroughputOfEscaping(std::string (*escapeFunc)(const std::string&), const std::string& text,
+    std::string& rawText)
+{
+    constexpr double bytesPerGb = 1024.0 * 1024.0 * 1024.0;
+    constexpr double nanoSecPerSec = 1000000000.0;
+    CpuCostTimer timer;
+    for (int i = 0; i < TEXT_ESCAPED_TOTAL_CNT; ++i) {
+        rawText = escapeFunc(text);
+    }
+    return (static_cast<double>(text.length()) / bytesPerGb) /
+        (timer.GetCostInNanoSec(TEXT_ESCAPED_TOTAL_CNT) / nanoSecPerSec);
+}
+
+std::string EscapeByStringFilter(const std::string& text)
+{
+    return StringFilter::GetInstance().EscapeToRaw(text);
+}
+
+// server receives events in place of hiview, it works only if no server has been bound to the address
+class StandInServer {
+public:
+    explicit StandInServer(const EventSocket& serverAddr)
+    {
+        socketId_ = socket(AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+        if (socketId_ < 0) {
+            return;
+        }
+        constexpr suseconds_t recvTimeout = 100000; // 100ms
+        struct timeval timeout = { 0, recvTimeout };
+        (void)setsockopt(socketId_, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+        // the address left by a server stopped is reused
+        if (connect(socketId_, reinterpret_cast<const sockaddr*>(&serverAddr), sizeof(serverAddr)) < 0 &&
+            errno == ECONNREFUSED) {
+            unlink(serverAddr.sun_path);
+        }
+        if (bind(socketId_, reinterpret_cast<const sockaddr*>(&serverAddr), sizeof(serverAddr)) < 0) {
+            close(socketId_);
+            socketId_ = -1;
+            return;
+        }
+        path_ = serverAddr.sun_path;
+        receiver_ = std::thread([this] {
+            std::vector<uint8_t> buf(MAX_DATA_SIZE);
+            while (!isStopped_) {
+                receivedCnt_ += (recv(socketId_, buf.data(), buf.size(), 0) > 0) ? 1 : 0;
+            }
+        });
+    }
+
+    ~StandInServer()
+    {
+        if (socketId_ < 0) {
+            return;
+        }
+        isStopped_ = true;
+        receiver_.join();
+        close(socketId_);
+        unlink(path_.c_str());
+    }
+
+    size_t GetReceivedCnt() const
+    {
+        return receivedCnt_;
+    }
+
+private:
+    int socketId_ = -1;
+    std::string path_;
+    std::atomic<bool> isStopped_ { false };
+    std::atomic<size_t> receivedCnt_ { 0 };
+    std::thread receiver_;
+};
+
+// an event with header only
+// stand-in of the daemon which consumes events from the ring handed over by the transport
+class StandInRingDaemon {
+public:
+    explicit StandInRingDaemon(const EventSocket& daemonAddr)
+    {
+        socketId_ = socket(AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+        if (socketId_ < 0) {
+            return;
+        }
+        constexpr suseconds_t recvTimeout = 100000; // 100ms
+        struct timeval timeout = { 0, recvTimeout };
+        (void)setsockopt(socketId_, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+        unlink(daemonAddr.sun_path);
+        if (bind(socketId_, reinterpret_cast<const sockaddr*>(&daemonAddr), sizeof(daemonAddr)) < 0) {
+            close(socketId_);
+            socketId_ = -1;
+            return;
+        }
+        path_ = daemonAddr.sun_path;
+        consumer_ = std::thread([this] {
+            SharedMemoryRingConsumer ringConsumer;
+            while (!isStopped_ && !ringConsumer.Accept(socketId_)) {}
+            constexpr int waitTimeout = 100; // 100ms
+            while (!isStopped_) {
+                consumedCnt_ += ringConsumer.Consume([](const Encoded::HiSysEventHeader&, const uint8_t*, size_t) {});
+                (void)ringConsumer.Wait(waitTimeout);
+            }
+        });
+    }
+
+    ~StandInRingDaemon()
+    {
+        if (socketId_ < 0) {
+            return;
+        }
+        isStopped_ = true;
+        consumer_.join();
+        close(socketId_);
+        unlink(path_.c_str());
+    }
+
+    size_t GetConsumedCnt() const
+    {
+        return consumedCnt_;
+    }
+
+private:
+    int socketId_ = -1;
+    std::string path_;
+    std::atomic<bool> isStopped_ { false };
+    std::atomic<size_t> consumedCnt_ { 0 };
+    std::thread consumer_;
+};
+
+void BuildRawEvent(Encoded::RawData& rawData)
+{
+    Encoded::HiSysEventHeader header = { "AAFWK", "PERF_TEST", 0, 0, static_cast<uint32_t>(getuid()),
+        static_cast<uint32_t>(getprocpid()), static_cast<uint32_t>(getproctid()), 0,
+        HiSysEvent::EventType::BEHAVIOR - 1, 0 };
+    int32_t paramCnt = 0;
+    int32_t blockSize = static_cast<int32_t>(sizeof(blockSize) + sizeof(header) + sizeof(paramCnt));
+    (void)rawData.Append(reinterpret_cast<uint8_t*>(&blockSize), sizeof(blockSize));
+    (void)rawData.Append(reinterpret_cast<uint8_t*>(&header), sizeof(header));
+    (void)rawData.Append(reinterpret_cast<uint8_t*>(&paramCnt), sizeof(paramCnt));
+}
+
+// send the event by a new socket, which is how the transport worked before sockets are kept by threads
+int SendBySocketOfEachEvent(Encoded::RawData& rawData)
+{
+    int socketId = socket(AF_UNIX, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (socketId < 0) {
+        return ERR_SEND_FAIL;
+    }
+    int sendBuffSize = MAX_DATA_SIZE;
+    socklen_t optSize = static_cast<socklen_t>(sizeof(sendBuffSize));
+    (void)getsockopt(socketId, SOL_SOCKET, SO_SNDBUF, &sendBuffSize, &optSize);
+    sendBuffSize = MAX_DATA_SIZE;
+    (void)setsockopt(socketId, SOL_SOCKET, SO_SNDBUF, &sendBuffSize, sizeof(sendBuffSize));
+    (void)getsockopt(socketId, SOL_SOCKET, SO_SNDBUF, &sendBuffSize, &optSize);
+    const auto& serverAddr = EventSocketFactory::GetEventSocket(rawData);
+    auto ret = sendto(socketId, rawData.GetData(), rawData.GetDataLength(), 0,
+        reinterpret_cast<const sockaddr*>(&serverAddr), sizeof(serverAddr));
+    close(socketId);
+    return (ret < 0) ? ERR_SEND_FAIL : SUCCESS;
+}
+
+int SendByTransport(Encoded::RawData& rawData)
+{
+    return Transport::GetInstance().SendData(rawData);
+}
+
+// send the event by the socket connected to the server and kept by the thread, which is how the transport sends
+int SendByConnectedSocket(Encoded::RawData& rawData)
+{
+    thread_local int socketId = -1;
+    if (socketId < 0) {
+        int newSocketId = socket(AF_UNIX, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (newSocketId < 0) {
+            return ERR_SEND_FAIL;
+        }
+        const auto& serverAddr = EventSocketFactory::GetEventSocket(rawData);
+        if (connect(newSocketId, reinterpret_cast<const sockaddr*>(&serverAddr), sizeof(serverAddr)) < 0) {
+            close(newSocketId);
+            return ERR_SEND_FAIL;
+        }
+        socketId = newSocketId;
+    }
+    return (send(socketId, rawData.GetData(), rawData.GetDataLength(), 0) < 0) ? ERR_SEND_FAIL : SUCCESS;
+}
+
+int SendByIoUring(Encoded::RawData& rawData)
+{
+    static IoUringSender sender;
+    static bool isInited = sender.Init();
+    if (!isInited) {
+        return ERR_DOES_NOT_INIT;
+    }
+    return sender.Send(EventSocketFactory::GetEventSocket(rawData), rawData);
+}
+
+double GetEventsPerSecOfSending(int (*sendFunc)(Encoded::RawData&), int& successCnt)
+{
+    constexpr double nanoSecPerSec = 1000000000.0;
+    Encoded::RawData rawData;
+    BuildRawEvent(rawData);
+    (void)sendFunc(rawData); // warm up
+    successCnt = 0;
+    CostTimer timer;
+    for (int i = 0; i < EVENT_SENT_TOTAL_CNT; ++i) {
+        successCnt += (sendFunc(rawData) == SUCCESS) ? 1 : 0;
+    }
+    return nanoSecPerSec / timer.GetCostInNanoSec(EVENT_SENT_TOTAL_CNT);
+}
+
+double GetEventsPerSecOfSendingInThreads(int (*sendFunc)(Encoded::RawData&), int threadCnt, int& successCnt)
+{
+    std::atomic<int> totalSuccessCnt { 0 };
+    std::vector<std::thread> senders;
+    CostTimer timer;
+    for (int i = 0; i < threadCnt; ++i) {
+        senders.emplace_back([sendFunc, &totalSuccessCnt] {
+            int threadSuccessCnt = 0;
+            (void)GetEventsPerSecOfSending(sendFunc, threadSuccessCnt);
+            totalSuccessCnt += threadSuccessCnt;
+        });
+    }
+    for (auto& sender : senders) {
+        sender.join();
+    }
+    successCnt = totalSuccessCnt;
+    constexpr double nanoSecPerSec = 1000000000.0;
+    return nanoSecPerSec / timer.GetCostInNanoSec(threadCnt * EVENT_SENT_TOTAL_CNT);
+}
+
+double GetEventsPerSecOfWritingInThreads(int (*writeFunc)(int), int threadCnt, int& successCnt)
+{
+    std::atomic<int> totalSuccessCnt { 0 };
+    std::vector<std::thread> writers;
+    CostTimer timer;
+    for (int i = 0; i < threadCnt; ++i) {
+        writers.emplace_back([writeFunc, &totalSuccessCnt] {
+            for (int j = 0; j < WROTE_TOTAL_CNT; ++j) {
+                totalSuccessCnt += (writeFunc(j) == SUCCESS) ? 1 : 0;
+            }
+        });
+    }
+    for (auto& writer : writers) {
+        writer.join();
+    }
+    successCnt = totalSuccessCnt;
+    constexpr double nanoSecPerSec = 1000000000.0;
+    return nanoSecPerSec / timer.GetCostInNanoSec(threadCnt * WROTE_TOTAL_CNT);
+}
+
+// limit the writing by the key of the call site in a map guarded by one lock, which is how the controller worked before
+uint64_t CheckLimitByLockedMap()
+{
+    static std::mutex mutex;
+    static std::unordered_map<uint64_t, size_t> counts;
+    std::string key;
+    key.append("PERF_TEST").append("_").append(__FUNCTION__).append("_").append(std::to_string(__LINE__));
+    uint64_t hash = std::hash<std::string>()(key);
+    uint64_t timeStamp = WriteController::GetCurrentTimeMills();
+    std::lock_guard<std::mutex> lock(mutex);
+    return (++counts[hash] <= UNLIMITED_PARAM.threshold) ? timeStamp : INVALID_TIME_STAMP;
+}
+
+uint64_t CheckLimitByRegistry()
+{
+    return WriteController::CheckLimitWritingEvent(UNLIMITED_PARAM, "AAFWK", "PERF_TEST", __FUNCTION__, __LINE__);
+}
+
+uint64_t CheckLimitBySlot()
+{
+    static WriteControlSlot slot;
+    return WriteController::CheckLimitWritingEvent(UNLIMITED_PARAM, slot, "AAFWK", "PERF_TEST", __FUNCTION__);
+}
+
+double GetCostOfCheckingLimitInThreads(uint64_t (*checkFunc)(), int threadCnt)
+{
+    std::vector<std::thread> checkers;
+    CostTimer timer;
+    for (int i = 0; i < threadCnt; ++i) {
+        checkers.emplace_back([checkFunc] {
+            for (int j = 0; j < LIMIT_CHECKED_TOTAL_CNT; ++j) {
+                (void)checkFunc();
+            }
+        });
+    }
+    for (auto& checker : checkers) {
+        checker.join();
+    }
+    return timer.GetCostInNanoSec(threadCnt * LIMIT_CHECKED_TOTAL_CNT);
+}
+
+double GetCostOfRateLimitingInThreads(EventRateLimiter& limiter, const std::string& domain, int threadCnt)
+{
+    std::vector<std::thread> checkers;
+    CostTimer timer;
+    for (int i = 0; i < threadCnt; ++i) {
+        checkers.emplace_back([&limiter, &domain] {
+            for (int j = 0; j < LIMIT_CHECKED_TOTAL_CNT; ++j) {
+                (void)limiter.IsAllowed(domain, "PERF_TEST", HiSysEvent::EventType::BEHAVIOR);
+            }
+        });
+    }
+    for (auto& checker : checkers) {
+        checker.join();
+    }
+    return timer.GetCostInNanoSec(threadCnt * LIMIT_CHECKED_TOTAL_CNT);
+}
+
+double GetCostOfCheckingControl(EventControl& control, const char* domain)
+{
+    CostTimer timer;
+    for (int i = 0; i < LIMIT_CHECKED_TOTAL_CNT; ++i) {
+        (void)control.IsDropped(domain, "PERF_TEST", HiSysEvent::EventType::FAULT);
+    }
+    return timer.GetCostInNanoSec(LIMIT_CHECKED_TOTAL_CNT);
+}
+
+void BuildParamsOfEventSize(size_t eventSize, std::string& strVal, std::vector<HiSysEventParam>& params)
+{
+    strVal = std::string((eventSize - EVENT_SIZE_RESERVED) / STR_PARAM_CNT, 'a');
+    params.resize(STR_PARAM_CNT);
+    for (size_t i = 0; i < STR_PARAM_CNT; ++i) {
+        std::string name = "PARAM_STR_" + std::to_string(i);
+        (void)strcpy_s(params[i].name, sizeof(params[i].name), name.c_str());
+        params[i].t = HISYSEVENT_STRING;
+        params[i].v.s = const_cast<char*>(strVal.c_str());
+        params[i].arraySize = 0;
+    }
+}
+}
+
+void* operator new(size_t size)
+{
+    if (g_isAllocCounted) {
+        g_allocCnt++;
+        g_allocBytes += size;
+    }
+    void* ptr = malloc(size == 0 ? 1 : size);
+    if (ptr == nullptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void* operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+    if (g_isAllocCounted) {
+        g_allocCnt++;
+        g_allocBytes += size;
+    }
+    return malloc(size == 0 ? 1 : size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t& tag) noexcept
+{
+    return operator new(size, tag);
+}
+
+void operator delete(void* ptr) noexcept
+{
+    free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+    free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+    free(ptr);
+}
+
+void operator delete[](void* ptr, size_t) noexcept
+{
+    free(ptr);
+}
+
+void HiSysEventPerfTest::SetUpTestCase(void)
+{
+}
+
+void HiSysEventPerfTest::TearDownTestCase(void)
+{
+}
+
+void HiSysEventPerfTest::SetUp(void)
+{
+}
+
+void HiSysEventPerfTest::TearDown(void)
+{
+}
+
+/**
+ * @tc.name: HiSysEventPerfTest001
+ * @tc.desc: Heap allocations of writing a sysevent with 20 params
+ * @tc.type: PERF
+ * @tc.require: user-001
+ */
+HWTEST_F(HiSysEventPerfTest, HiSysEventPerfTest001, TestSize.Level1)
+{
+    (void)WriteEventWithTwentyParams(0); // warm up
+    int successCnt = 0;
+    size_t allocCnt = 0;
+    CostTimer timer;
+    {
+        AllocCounter counter;
+        for (int i = 0; i < WROTE_TOTAL_CNT; ++i) {
+            successCnt += (WriteEventWithTwentyParams(i) == SUCCESS) ? 1 : 0;
+        }
+        allocCnt = counter.GetCount();
+    }
+    auto costPerEvent = timer.GetCostInNanoSec(WROTE_TOTAL_CNT);
+    auto allocPerEvent = static_cast<double>(allocCnt) / WROTE_TOTAL_CNT;
+    std::cout << "write event with " << PARAM_CNT << " params: " << allocPerEvent << " allocations/event, " <<
+        costPerEvent << " ns/event, " << successCnt << "/" << WROTE_TOTAL_CNT << " succeed" << std::endl;
+    // params are encoded without any heap allocation, only per-event allocations are left
+    ASSERT_LT(allocPerEvent, static_cast<double>(PARAM_CNT));
+}
+
+/**
+ * @tc.name: HiSysEventPerfTest002
+ * @tc.desc: Heap allocations and bytes of writing sysevents with size from 1KB to MAX_DATA_SIZE
+ * @tc.type: PERF
+ * @tc.require: user-003
+ */
+HWTEST_F(HiSysEventPerfTest, HiSysEventPerfTest002, TestSize.Level1)
+{
+    // events are captured without being copied, so the data failed to be sent to the daemon is never counted in
+    CaptureBackend backend;
+    Transport::GetInstance().SetBackend(&backend);
+    std::vector<size_t> eventSizes = { 1 * KB, 4 * KB, 16 * KB, 64 * KB, 256 * KB, MAX_DATA_SIZE };
+    for (auto eventSize : eventSizes) {
+        std::string strVal;
+        std::vector<HiSysEventParam> params;
+        BuildParamsOfEventSize(eventSize, strVal, params);
+        size_t allocCnt = 0;
+        size_t allocBytes = 0;
+        CostTimer timer;
+        {
+            AllocCounter counter;
+            for (int i = 0; i < SIZED_WROTE_TOTAL_CNT; ++i) {
+                (void)OH_HiSysEvent_Write("AAFWK", "PERF_TEST", HISYSEVENT_BEHAVIOR, params.data(), params.size());
+            }
+            allocCnt = counter.GetCount();
+            allocBytes = counter.GetBytes();
+        }
+        auto costPerEvent = timer.GetCostInNanoSec(SIZED_WROTE_TOTAL_CNT);
+        auto allocPerEvent = static_cast<double>(allocCnt) / SIZED_WROTE_TOTAL_CNT;
+        auto bytesPerEvent = static_cast<double>(allocBytes) / SIZED_WROTE_TOTAL_CNT;
+        std::cout << "write event with size " << (eventSize / KB) << "KB: " << allocPerEvent <<
+            " allocations/event, " << bytesPerEvent << " allocated bytes/event, " << costPerEvent <<
+            " ns/event" << std::endl;
+        // raw data of the event is allocated once with its exact size
+        ASSERT_LT(bytesPerEvent, static_cast<double>(eventSize) * 2); // 2 times of the event size at most
+    }
+    Transport::GetInstance().SetBackend(nullptr);
+}
+
+/**
+ * @tc.name: HiSysEventPerfTest003
+ * @tc.desc: Cpu cost of writing a sysevent with 20 params by prepared event and by macro interface
+ * @tc.type: PERF
+ * @tc.require: user-006
+ */
+HWTEST_F(HiSysEventPerfTest, HiSysEventPerfTest003, TestSize.Level1)
+{
+    CaptureBackend backend;
+    Transport::GetInstance().SetBackend(&backend);
+    size_t allocCnt = 0;
+    auto cost = GetCpuCostOfWriting(WriteEventWithTwentyParams, allocCnt);
+    size_t preparedAllocCnt = 0;
+    auto preparedCost = GetCpuCostOfWriting(WritePreparedEventWithTwentyParams, preparedAllocCnt);
+    Transport::GetInstance().SetBackend(nullptr);
+    std::cout << "write event with " << PARAM_CNT << " params: " << cost << " cpu ns/event, " <<
+        "write prepared event: " << preparedCost << " cpu ns/event" << std::endl;
+    // keys of prepared event are never encoded again, neither are the header fields which never change
+    ASSERT_LE(preparedAllocCnt, allocCnt);
+}
+
+/**
+ * @tc.name: HiSysEventPerfTest004
+ * @tc.desc: Cpu cost of writing base info of event header with cache and without cache
+ * @tc.type: PERF
+ * @tc.require: user-007
+ */
+HWTEST_F(HiSysEventPerfTest, HiSysEventPerfTest004, TestSize.Level1)
+{
+    uint64_t baseInfo = 0;
+    auto cost = GetCpuCostOfWritingBaseInfo(WriteBaseInfoWithoutCache, baseInfo);
+    uint64_t cachedBaseInfo = 0;
+    auto cachedCost = GetCpuCostOfWritingBaseInfo(WriteBaseInfoWithCache, cachedBaseInfo);
+    std::cout << "write base info without cache: " << cost << " cpu ns/event, with cache: " << cachedCost <<
+        " cpu ns/event" << std::endl;
+    ASSERT_EQ(cachedBaseInfo, baseInfo);
+}
+
+/**
+ * @tc.name: HiSysEventPerfTest005
+ * @tc.desc: Cpu cost of encoding an int64 array with 100 items item by item and in batch
+ * @tc.type: PERF
+ * @tc.require: user-009
+ */
+HWTEST_F(HiSysEventPerfTest, HiSysEventPerfTest005, TestSize.Level1)
+{
+    Encoded::RawData data;
+    auto cost = GetCpuCostOfEncodingInt64Array(EncodeInt64ArrayItemByItem, data);
+    Encoded::RawData batchData;
+    auto batchCost = GetCpuCostOfEncodingInt64Array(EncodeInt64ArrayInBatch, batchData);
+    std::cout << "encode int64 array with " << INT64_ARRAY_SIZE << " items one by one: " << cost <<
+        " cpu ns/array, in batch: " << batchCost << " cpu ns/array" << std::endl;
+    ASSERT_EQ(batchData.GetDataLength(), data.GetDataLength());
+    ASSERT_EQ(memcmp(batchData.GetData(), data.GetData(), data.GetDataLength()), 0);
+}
+
+/**
+ * @tc.name: HiSysEventPerfTest006
+ * @tc.desc: Throughput of escaping stack traces with and without chars to be escaped
+ * @tc.type: PERF
+ * @tc.require: user-010
+ */
+HWTEST_F(HiSysEventPerfTest, HiSysEventPerfTest006, TestSize.Level1)
+{
+    for (auto frameSeparator : { " | ", "\n" }) {
+        auto stackTrace = BuildStackTrace(frameSeparator);
+        std::string rawText;
+        auto throughput = GetThroughputOfEscaping(EscapeCharByChar, stackTrace, rawText);
+        std::string filteredRawText;
+        auto filteredThroughput = GetThroughputOfEscaping(EscapeByStringFilter, stackTrace, filteredRawText);
+        std::cout << "escape stack trace of " << (stackTrace.length() / KB) << "KB char by char: " << throughput <<
+            " GB/s, by string filter: " << filteredThroughput << " GB/s" << std::endl;
+        ASSERT_EQ(filteredRawText, rawText);
+    }
+}
+
+/**
+ * @tc.name: HiSysEventPerfTest007
+ * @tc.desc: Events sent per second in one thread by a new socket for each event and by the transport
+ * @tc.type: PERF
+ * @tc.require: user-011
+ */
+HWTEST_F(HiSysEventPerfTest, HiSysEventPerfTest007, TestSize.Level1)
+{
+    Encoded::RawData rawData;
+    BuildRawEvent(rawData);
+    StandInServer server(EventSocketFactory::GetEventSocket(rawData));
+    int successCnt = 0;
+    auto eventsPerSec = GetEventsPerSecOfSending(SendBySocketOfEachEvent, successCnt);
+    int transportSuccessCnt = 0;
+    auto transportEventsPerSec = GetEventsPerSecOfSending(SendByTransport, transportSuccessCnt);
+    std::cout << "send events by a socket for each event: " << eventsPerSec << " events/s, " << successCnt <<
+        "/" << EVENT_SENT_TOTAL_CNT << " succeed; by transport: " << transportEventsPerSec << " events/s, " <<
+        transportSuccessCnt << "/" << EVENT_SENT_TOTAL_CNT << " succeed" << std::endl;
+}
+
+/**
+ * @tc.name: HiSysEventPerfTest008
+ * @tc.desc: Events sent per second by the transport in several threads concurrently
+ * @tc.type: PERF
+ * @tc.require: user-012
+ */
+HWTEST_F(HiSysEventPerfTest, HiSysEventPerfTest008, TestSize.Level1)
+{
+    Encoded::RawData rawData;
+    BuildRawEvent(rawData);
+    StandInServer server(EventSocketFactory::GetEventSocket(rawData));
+    int successCnt = 0;
+    auto eventsPerSec = GetEventsPerSecOfSendingInThreads(SendByTransport, SENDER_THREAD_CNT, successCnt);
+    std::cout << "send events by transport in " << SENDER_THREAD_CNT << " threads: " << eventsPerSec <<
+        " events/s, " << successCnt << "/" << (SENDER_THREAD_CNT * EVENT_SENT_TOTAL_CNT) << " succeed" << std::endl;
+    ASSERT_GT(eventsPerSec, 0);
+}
+
+/**
+ * @tc.name: HiSysEventPerfTest009
+ * @tc.desc: Cpu cost of writing events one by one and in one batch
+ * @tc.type: PERF
+ * @tc.require: user-014
+ */
+HWTEST_F(HiSysEventPerfTest, HiSysEventPerfTest009, TestSize.Level1)
+{
+    Encoded::RawData rawData;
+    BuildRawEvent(rawData);
+    StandInServer server(EventSocketFactory::GetEventSocket(rawData));
+    int successCnt = 0;
+    CpuCostTimer timer;
+    for (int i = 0; i < WROTE_TOTAL_CNT; ++i) {
+        int ret = HiSysEventWrite(HiSysEvent::Domain::AAFWK, "PERF_TEST", HiSysEvent::EventType::STATISTIC,
+            "PARAM_INT", i, "PARAM_STR", "param_val");
+        successCnt += (ret == SUCCESS) ? 1 : 0;
+    }
+    auto costPerEvent = timer.GetCostInNanoSec(WROTE_TOTAL_CNT);
+
+    HiSysEvent::Batch batch;
+    CpuCostTimer batchTimer;
+    for (int i = 0; i < WROTE_TOTAL_CNT; ++i) {
+        (void)batch.Add(__FUNCTION__, __LINE__, HiSysEvent::Domain::AAFWK, "PERF_TEST",
+            HiSysEvent::EventType::STATISTIC, "PARAM_INT", i, "PARAM_STR", "param_val");
+    }
+    auto retCodes = batch.Write();
+    auto batchCostPerEvent = batchTimer.GetCostInNanoSec(WROTE_TOTAL_CNT);
+    int batchSuccessCnt = 0;
+    for (auto retCode : retCodes) {
+        batchSuccessCnt += (retCode == SUCCESS) ? 1 : 0;
+    }
+    std::cout << "write events one by one: " << costPerEvent << " cpu ns/event, " << successCnt << "/" <<
+        WROTE_TOTAL_CNT << " succeed; in one batch: " << batchCostPerEvent << " cpu ns/event, " << batchSuccessCnt <<
+        "/" << WROTE_TOTAL_CNT << " succeed" << std::endl;
+    ASSERT_EQ(retCodes.size(), WROTE_TOTAL_CNT);
+}
+
+/**
+ * @tc.name: HiSysEventPerfTest010
+ * @tc.desc: Cpu cost of the writing thread in sync mode and async mode
+ * @tc.type: PERF
+ * @tc.require: user-015
+ */
+HWTEST_F(HiSysEventPerfTest, HiSysEventPerfTest010, TestSize.Level1)
+{
+    Encoded::RawData rawData;
+    BuildRawEvent(rawData);
+    StandInServer server(EventSocketFactory::GetEventSocket(rawData));
+    int successCnt = 0;
+    CpuCostTimer timer;
+    for (int i = 0; i < WROTE_TOTAL_CNT; ++i) {
+        int ret = HiSysEventWrite(HiSysEvent::Domain::AAFWK, "PERF_TEST", HiSysEvent::EventType::STATISTIC,
+            "PARAM_INT", i, "PARAM_STR", "param_val");
+        successCnt += (ret == SUCCESS) ? 1 : 0;
+    }
+    auto costPerEvent = timer.GetCostInNanoSec(WROTE_TOTAL_CNT);
+
+    HiSysEvent::EnableAsyncMode();
+    constexpr int flushedCnt = 128; // events queued are flushed in time to avoid being dropped
+    int asyncSuccessCnt = 0;
+    CpuCostTimer asyncTimer;
+    for (int i = 0; i < WROTE_TOTAL_CNT; ++i) {
+        int ret = HiSysEventWrite(HiSysEvent::Domain::AAFWK, "PERF_TEST", HiSysEvent::EventType::STATISTIC,
+            "PARAM_INT", i, "PARAM_STR", "param_val");
+        asyncSuccessCnt += (ret == SUCCESS) ? 1 : 0;
+        if ((i + 1) % flushedCnt == 0) {
+            HiSysEvent::FlushAsyncEvents();
+        }
+    }
+    auto asyncCostPerEvent = asyncTimer.GetCostInNanoSec(WROTE_TOTAL_CNT);
+    HiSysEvent::DisableAsyncMode();
+    std::cout << "write events in sync mode: " << costPerEvent << " cpu ns/event, " << successCnt << "/" <<
+        WROTE_TOTAL_CNT << " succeed; in async mode: " << asyncCostPerEvent << " cpu ns/event, " <<
+        asyncSuccessCnt << "/" << WROTE_TOTAL_CNT << " queued" << std::endl;
+    ASSERT_GT(asyncSuccessCnt, 0);
+}
+
+/**
+ * @tc.name: HiSysEventPerfTest011
+ * @tc.desc: Events sent per second in one thread by the transport through sockets and through the shared memory ring
+ * @tc.type: PERF
+ * @tc.require: user-016
+ */
+HWTEST_F(HiSysEventPerfTest, HiSysEventPerfTest011, TestSize.Level1)
+{
+    Encoded::RawData rawData;
+    BuildRawEvent(rawData);
+    StandInServer server(EventSocketFactory::GetEventSocket(rawData));
+    int successCnt = 0;
+    auto eventsPerSec = GetEventsPerSecOfSending(SendByTransport, successCnt);
+
+    // sockets are used again once the ring is full, and the ring is disabled before the stand-in daemon stops
+    StandInRingDaemon daemon(EventSocketFactory::GetSharedMemoryRingSocket());
+    ASSERT_EQ(HiSysEvent::EnableSharedMemoryTransport(), SUCCESS);
+    int ringSuccessCnt = 0;
+    auto ringEventsPerSec = GetEventsPerSecOfSending(SendByTransport, ringSuccessCnt);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100)); // 100ms: wait for events left to be consumed
+    std::cout << "send events by transport through sockets: " << eventsPerSec << " events/s, " << successCnt << "/" <<
+        EVENT_SENT_TOTAL_CNT << " succeed; through shared memory ring: " << ringEventsPerSec << " events/s, " <<
+        ringSuccessCnt << "/" << EVENT_SENT_TOTAL_CNT << " succeed, " << daemon.GetConsumedCnt() <<
+        " consumed from the ring" << std::endl;
+    HiSysEvent::DisableSharedMemoryTransport();
+    ASSERT_GT(ringEventsPerSec, 0);
+}
+
+/**
+ * @tc.name: HiSysEventPerfTest012
+ * @tc.desc: Events sent per second in 1, 4 and 16 threads through sockets and through io_uring
+ * @tc.type: PERF
+ * @tc.require: user-017
+ */
+HWTEST_F(HiSysEventPerfTest, HiSysEventPerfTest012, TestSize.Level1)
+{
+    Encoded::RawData rawData;
+    BuildRawEvent(rawData);
+    StandInServer server(EventSocketFactory::GetEventSocket(rawData));
+    // events are counted as failed rather than waiting for the server while all buffers of io_uring are in flight
+    for (int threadCnt = 1; threadCnt <= MAX_SENDER_THREAD_CNT; threadCnt *= SENDER_THREAD_CNT) {
+        int successCnt = 0;
+        size_t receivedCnt = server.GetReceivedCnt();
+        auto eventsPerSec = GetEventsPerSecOfSendingInThreads(SendByConnectedSocket, threadCnt, successCnt);
+        std::this_thread::sleep_for(std::chrono::milliseconds(100)); // 100ms: wait for events left to be received
+        receivedCnt = server.GetReceivedCnt() - receivedCnt;
+        int ioUringSuccessCnt = 0;
+        size_t ioUringReceivedCnt = server.GetReceivedCnt();
+        auto ioUringEventsPerSec = GetEventsPerSecOfSendingInThreads(SendByIoUring, threadCnt, ioUringSuccessCnt);
+        std::this_thread::sleep_for(std::chrono::milliseconds(100)); // 100ms: wait for events left to be received
+        ioUringReceivedCnt = server.GetReceivedCnt() - ioUringReceivedCnt;
+        std::cout << "send events in " << threadCnt << " threads through sockets: " << eventsPerSec <<
+            " events/s, " << successCnt << " succeed, " << receivedCnt << " received; through io_uring: " <<
+            ioUringEventsPerSec << " events/s, " << ioUringSuccessCnt << " succeed, " << ioUringReceivedCnt <<
+            " received, of " << (threadCnt * EVENT_SENT_TOTAL_CNT) << " events" << std::endl;
+        ASSERT_GT(eventsPerSec, 0);
+        ASSERT_GT(ioUringEventsPerSec, 0);
+    }
+}
+
+/**
+ * @tc.name: HiSysEventPerfTest013
+ * @tc.desc: Events encoded per second in several threads, which are captured in memory without the daemon
+ * @tc.type: PERF
+ * @tc.require: user-020
+ */
+HWTEST_F(HiSysEventPerfTest, HiSysEventPerfTest013, TestSize.Level1)
+{
+    CaptureBackend backend;
+    Transport::GetInstance().SetBackend(&backend);
+    for (int threadCnt = 1; threadCnt <= SENDER_THREAD_CNT; threadCnt *= SENDER_THREAD_CNT) {
+        backend.Reset();
+        int successCnt = 0;
+        auto eventsPerSec = GetEventsPerSecOfWritingInThreads(WriteEventWithTwentyParams, threadCnt, successCnt);
+        auto stats = backend.GetStats();
+        std::cout << "write event with " << PARAM_CNT << " params in " << threadCnt << " threads: " <<
+            eventsPerSec << " events/s, " << (stats.capturedBytes / stats.capturedCnt) << " bytes/event, " <<
+            successCnt << "/" << (threadCnt * WROTE_TOTAL_CNT) << " captured" << std::endl;
+        ASSERT_EQ(stats.capturedCnt, successCnt);
+        ASSERT_GT(eventsPerSec, 0);
+    }
+    Transport::GetInstance().SetBackend(nullptr);
+}
+
+/**
+ * @tc.name: HiSysEventPerfTest014
+ * @tc.desc: Cost of limiting the writing of one call site by a locked map, the registry and the slot in threads
+ * @tc.type: PERF
+ * @tc.require: user-021
+ */
+HWTEST_F(HiSysEventPerfTest, HiSysEventPerfTest014, TestSize.Level1)
+{
+    for (int threadCnt = 1; threadCnt <= MAX_SENDER_THREAD_CNT; threadCnt *= SENDER_THREAD_CNT) {
+        auto lockedCost = GetCostOfCheckingLimitInThreads(CheckLimitByLockedMap, threadCnt);
+        auto registryCost = GetCostOfCheckingLimitInThreads(CheckLimitByRegistry, threadCnt);
+        auto slotCost = GetCostOfCheckingLimitInThreads(CheckLimitBySlot, threadCnt);
+        std::cout << "limit writing in " << threadCnt << " threads by a locked map: " << lockedCost <<
+            " ns/event, by the registry: " << registryCost << " ns/event, by the slot: " << slotCost <<
+            " ns/event" << std::endl;
+    }
+}
+
+/**
+ * @tc.name: HiSysEventPerfTest015
+ * @tc.desc: Cost of checking the rate limit of the events with and without policy in threads
+ * @tc.type: PERF
+ * @tc.require: user-022
+ */
+HWTEST_F(HiSysEventPerfTest, HiSysEventPerfTest015, TestSize.Level1)
+{
+    std::string configPath = "/data/test/hisysevent_rate_limit_perf.conf";
+    std::ofstream(configPath) << "AAFWK * 1 1\n";
+    EventRateLimiter limiter(configPath);
+    ASSERT_TRUE(limiter.Reload());
+    for (int threadCnt = 1; threadCnt <= MAX_SENDER_THREAD_CNT; threadCnt *= SENDER_THREAD_CNT) {
+        auto limitedCost = GetCostOfRateLimitingInThreads(limiter, "AAFWK", threadCnt);
+        auto unlimitedCost = GetCostOfRateLimitingInThreads(limiter, "ACE", threadCnt);
+        std::cout << "check rate limit in " << threadCnt << " threads with policy: " << limitedCost <<
+            " ns/event, without policy: " << unlimitedCost << " ns/event" << std::endl;
+        ASSERT_GT(limitedCost, 0);
+        ASSERT_GT(unlimitedCost, 0);
+    }
+    (void)unlink(configPath.c_str());
+}
+
+/**
+ * @tc.name: HiSysEventPerfTest016
+ * @tc.desc: Cost of checking the control block before and after some domains are disabled
+ * @tc.type: PERF
+ * @tc.require: user-023
+ */
+HWTEST_F(HiSysEventPerfTest, HiSysEventPerfTest016, TestSize.Level1)
+{
+    std::string controlPath = "/data/test/hisysevent_control_perf";
+    (void)unlink(controlPath.c_str());
+    EventControlPublisher publisher;
+    ASSERT_TRUE(publisher.Init(controlPath));
+    EventControl control(controlPath);
+    auto idleCost = GetCostOfCheckingControl(control, "AAFWK");
+    ASSERT_TRUE(publisher.Disable("ACE"));
+    auto enabledCost = GetCostOfCheckingControl(control, "AAFWK");
+    auto disabledCost = GetCostOfCheckingControl(control, "ACE");
+    std::cout << "check control block with nothing disabled: " << idleCost << " ns/event, of the domain enabled: " <<
+        enabledCost << " ns/event, of the domain disabled: " << disabledCost << " ns/event" << std::endl;
+    ASSERT_GT(idleCost, 0);
+    (void)unlink(controlPath.c_str());
+}